@@ -0,0 +1,40 @@
+/* contrib/adb_global_views/adb_global_views--1.0--1.1.sql */
+
+-- complain if script is sourced in psql, rather than via ALTER EXTENSION
+\echo Use "ALTER EXTENSION adb_global_views UPDATE TO '1.1'" to load this file. \quit
+
+-- adb_stat_statements 1.1 appends remote_wait_time, reduce_wait_time and
+-- gtm_wait_time to its views.  Drop the foreign tables imported with the
+-- old layout, query_gv_views_on_cn() imports them again on first use.
+do
+$$
+declare
+  l_node_record record;
+begin
+  for l_node_record in select node_name from pgxc_node where node_type in ('C')
+  loop
+    execute 'drop foreign table if exists gvfdw_'||l_node_record.node_name||'.adb_stat_statements';
+    execute 'drop foreign table if exists gvfdw_'||l_node_record.node_name||'.adb_stat_statements_notext';
+  end loop;
+end;
+$$;
+
+drop view if exists gv_adb_stat_statements;
+create or replace view gv_adb_stat_statements
+as
+select * from query_gv_views_on_cn('adb_stat_statements','antdb')
+as
+t(node_oid oid,node_name name,node_type "char"
+	,userid oid, usename name, dbid oid, dbname name, queryid bigint, planid bigint, calls bigint, rows bigint, total_time double precision, min_time double precision, max_time double precision, mean_time double precision, last_execution timestamp with time zone, query text, plan text, explain_format int, explain_plan text, bound_params text[]
+	,remote_wait_time double precision, reduce_wait_time double precision, gtm_wait_time double precision
+);
+
+drop view if exists gv_adb_stat_statements_notext;
+create or replace view gv_adb_stat_statements_notext
+as
+select * from query_gv_views_on_cn('adb_stat_statements_notext','antdb')
+as
+t(node_oid oid,node_name name,node_type "char"
+	,userid oid, usename name, dbid oid, dbname name, queryid bigint, planid bigint, calls bigint, rows bigint, total_time double precision, min_time double precision, max_time double precision, mean_time double precision, last_execution timestamp with time zone, query text, plan text, explain_format int, explain_plan text, bound_params text[]
+	,remote_wait_time double precision, reduce_wait_time double precision, gtm_wait_time double precision
+);
@@ -26,11 +26,16 @@
 #include "parser/scanner.h"
 #include "parser/scansup.h"
 #include "pgstat.h"
+#include "port/atomics.h"
 #include "postmaster/autovacuum.h"
+#include "postmaster/bgworker.h"
+#include "postmaster/interrupt.h"
 #include "replication/walsender.h"
 #include "storage/fd.h"
 #include "storage/ipc.h"
-#include "storage/spin.h"
+#include "storage/latch.h"
+#include "storage/lwlock.h"
+#include "storage/proc.h"
 #include "tcop/utility.h"
 #include "utils/acl.h"
 #include "utils/builtins.h"
@@ -58,6 +63,8 @@ PG_MODULE_MAGIC;
 #endif
 
 #define ADBSH_DEFAULT_MAX_RECORD (5)
+#define ADBSH_DEFAULT_RING_SIZE (16)
+#define ADBSH_DEFAULT_FLUSH_INTERVAL (1000)
 
 PG_FUNCTION_INFO_V1(adb_sql_history);
 
@@ -93,6 +100,39 @@ static bool adbSHLoadlibrary = false;
 
 static int adbssTrackLevel = ADBSS_TRACK_NONE;
 static int adbSHSqlNum = ADBSH_DEFAULT_MAX_RECORD;
+static int adbSHRingSize = ADBSH_DEFAULT_RING_SIZE;
+static int adbSHSampleRate = 1;
+static int adbSHMinDuration = -1;
+static int adbSHFlushInterval = ADBSH_DEFAULT_FLUSH_INTERVAL;
+
+/*
+ * Each backend owns one slot in shared memory, made of a ring of recently
+ * executed statements followed by its aggregated history.
+ *
+ * Only the owning backend writes the ring, so the query path takes no lock:
+ * an item is published with the same changecount protocol PgBackendStatus
+ * uses, and write_pos is advanced afterwards.  The flusher (background
+ * worker, or a caller of adb_sql_history()) copies the items between
+ * read_pos and write_pos and merges them into the history, holding
+ * adbshState->lock.  When the flusher falls behind by more than
+ * adb_sql_history.ring_size statements, the oldest ones are lost.
+ */
+typedef struct SQLHistoryRing
+{
+    pg_atomic_uint64 write_pos; /* next sequence to write, owner only */
+    uint64 read_pos;            /* next sequence to merge, flusher only */
+    pid_t history_pid;          /* backend the history belongs to */
+} SQLHistoryRing;
+
+typedef struct SQLRingItem
+{
+    uint32 changecount; /* odd while the owner is writing */
+    uint64 seq;
+    pid_t pid;
+    Oid dbid;
+    TimestampTz time;
+    char sql[FLEXIBLE_ARRAY_MEMBER];
+} SQLRingItem;
 
 typedef struct SQLHistoryItem
 {
@@ -100,36 +140,58 @@ typedef struct SQLHistoryItem
     Oid dbid;
     TimestampTz lasttime;
     int64 ecount;
-    slock_t mutex;
     char sql[FLEXIBLE_ARRAY_MEMBER];
 } SQLHistoryItem;
 
+typedef struct SQLHistoryShared
+{
+    LWLock lock; /* protects read_pos and all histories */
+} SQLHistoryShared;
+
 #define SQL_HISTORY_ITEM_SIZE() MAXALIGN(offsetof(SQLHistoryItem, sql) + pgstat_track_activity_query_size)
+#define SQL_RING_ITEM_SIZE() MAXALIGN(offsetof(SQLRingItem, sql) + pgstat_track_activity_query_size)
+#define SQL_HISTORY_SLOT_SIZE()                                                                                        \
+    (MAXALIGN(sizeof(SQLHistoryRing)) + SQL_RING_ITEM_SIZE() * adbSHRingSize + SQL_HISTORY_ITEM_SIZE() * adbSHSqlNum)
+
+#define SQL_HISTORY_SLOT(n) ((SQLHistoryRing *)(shmem + SQL_HISTORY_SLOT_SIZE() * (n)))
+#define SQL_RING_ITEM(ring, n)                                                                                         \
+    ((SQLRingItem *)((char *)(ring) + MAXALIGN(sizeof(SQLHistoryRing)) + SQL_RING_ITEM_SIZE() * (n)))
+#define SQL_HISTORY_ITEM(ring, n)                                                                                      \
+    ((SQLHistoryItem *)((char *)SQL_RING_ITEM(ring, adbSHRingSize) + SQL_HISTORY_ITEM_SIZE() * (n)))
 
 #define NATTS_NUM Anum_adbss_calls
 
-SQLHistoryItem **my_sql_history = NULL;
+SQLHistoryRing *my_sql_ring = NULL;
 bool sql_history_set = false;
 char *shmem = NULL;
+static SQLHistoryShared *adbshState = NULL;
 
 /*---- Function declarations ----*/
 void _PG_init(void);
 void _PG_fini(void);
+PGDLLEXPORT void adb_sql_history_flusher_main(Datum main_arg);
 
 static void shmem_startup(void);
 static void adbsh_ExecutorRun(QueryDesc *queryDesc, ScanDirection direction, uint64 count, bool execute_once);
 static Size sql_history_shm_size(void);
+static int sql_history_max_backends(void);
 static void bind_my_sql_history(void);
 static void define_custom_param(void);
+static void register_flusher(void);
+static bool sample_sql(void);
+static bool slow_sql(instr_time *start);
 static void save_sql(QueryDesc *queryDesc);
-static bool find_sql_pos(char *sql, int *idx);
-static void insert_sql(int sql_idx, char *sql);
-static void update_sql(int sql_idx);
+static void flush_sql_history(void);
+static void merge_sql(SQLHistoryRing *ring, SQLRingItem *item);
+static bool find_sql_pos(SQLHistoryRing *ring, char *sql, int *idx);
 static char *get_querytext(QueryDesc *queryDesc);
 
 /* Current nesting depth of ExecutorRun ecount */
 static int nested_level = 0;
 
+/* Statements seen by this backend, for adb_sql_history.sample_rate */
+static uint64 statement_count = 0;
+
 /* Saved hook values in case of unload */
 static shmem_startup_hook_type prev_shmem_startup_hook = NULL;
 static ExecutorRun_hook_type prev_ExecutorRun = NULL;
@@ -161,6 +223,8 @@ void _PG_init(void)
      */
     RequestAddinShmemSpace(sql_history_shm_size());
 
+    register_flusher();
+
     /*
      * Install hooks.
      */
@@ -189,7 +253,7 @@ Datum adb_sql_history(PG_FUNCTION_ARGS)
     MemoryContext oldcontext;
     int i = 0;
     int j = 0;
-    char *ptr;
+    SQLHistoryRing *ring;
     SQLHistoryItem *sql_item = NULL;
     Datum values[NATTS_NUM] = {0};
     bool nulls[NATTS_NUM] = {0};
@@ -231,23 +295,20 @@ Datum adb_sql_history(PG_FUNCTION_ARGS)
 
     MemoryContextSwitchTo(oldcontext);
 
-    for (i = 1; i <= MaxBackends; i++)
+    /* don't wait for the flusher, show what is in the rings right now */
+    LWLockAcquire(&adbshState->lock, LW_EXCLUSIVE);
+    flush_sql_history();
+
+    for (i = 0; i < MaxBackends; i++)
     {
-        ptr = shmem + (SQL_HISTORY_ITEM_SIZE() * adbSHSqlNum) * (i - 1);
+        ring = SQL_HISTORY_SLOT(i);
         for (j = 0; j < adbSHSqlNum; j++)
         {
             MemSet(values, 0, sizeof(values));
             MemSet(nulls, 0, sizeof(nulls));
 
-            sql_item = (SQLHistoryItem *)ptr;
-
-            if (!sql_item)
-            {
-                PG_RETURN_NULL();
-            }
-
-            SpinLockAcquire(&sql_item->mutex);
-            if (strlen(sql_item->sql) > 0)
+            sql_item = SQL_HISTORY_ITEM(ring, j);
+            if (sql_item->sql[0] != '\0')
             {
                 values[Anum_adbss_pid - 1] = Int64GetDatumFast(sql_item->pid);
                 values[Anum_adbss_dbid - 1] = ObjectIdGetDatum(sql_item->dbid);
@@ -264,116 +325,135 @@ Datum adb_sql_history(PG_FUNCTION_ARGS)
 
                 tuplestore_putvalues(tupstore, tupdesc, values, nulls);
             }
-            SpinLockRelease(&sql_item->mutex);
-
-            ptr += SQL_HISTORY_ITEM_SIZE();
         }
     }
+    LWLockRelease(&adbshState->lock);
 
     tuplestore_donestoring(tupstore);
 
     PG_RETURN_NULL();
 }
 
-static Size sql_history_shm_size(void)
+static int sql_history_max_backends(void)
 {
-    Size size = mul_size(SQL_HISTORY_ITEM_SIZE(), adbSHSqlNum);
     if (MaxBackends == 0)
     {
         /* not call InitializeMaxBackends() */
-        Size max_backends = MaxConnections + autovacuum_max_workers + 1 +
+        return MaxConnections + autovacuum_max_workers + 1 +
 #if defined(ADBMGRD)
-                            /* and adb monitor launcher */
-                            adbmonitor_max_workers + 1 +
+               /* and adb monitor launcher */
+               adbmonitor_max_workers + 1 +
 #endif
-                            max_worker_processes + max_wal_senders;
-        size = mul_size(size, max_backends);
+               max_worker_processes + max_wal_senders;
     }
-    else
-    {
-        size = mul_size(size, MaxBackends);
-    }
-    return size;
+    return MaxBackends;
+}
+
+static Size sql_history_shm_size(void)
+{
+    Size size = mul_size(SQL_HISTORY_SLOT_SIZE(), sql_history_max_backends());
+
+    return add_size(size, MAXALIGN(sizeof(SQLHistoryShared)));
 }
 
 static void shmem_startup(void)
 {
-    SQLHistoryItem *item;
-    char *ptr;
+    SQLHistoryRing *ring;
     int i;
+    int j;
     bool found;
 
     if (prev_shmem_startup_hook)
         (*prev_shmem_startup_hook)();
 
-    shmem = ShmemInitStruct(ADBSH_NAME, sql_history_shm_size(), &found);
+    LWLockAcquire(AddinShmemInitLock, LW_EXCLUSIVE);
+    adbshState = ShmemInitStruct(ADBSH_NAME, sql_history_shm_size(), &found);
+    shmem = (char *)adbshState + MAXALIGN(sizeof(SQLHistoryShared));
     if (unlikely(found == false))
     {
-        ptr = shmem;
-        i = MaxBackends * adbSHSqlNum;
-        while (i > 0)
+        LWLockInitialize(&adbshState->lock, LWLockNewTrancheId());
+        for (i = 0; i < MaxBackends; i++)
         {
-            item = (SQLHistoryItem *)ptr;
-            ptr += SQL_HISTORY_ITEM_SIZE();
-            item->sql[0] = '\0';
-            item->lasttime = 0;
-            SpinLockInit(&item->mutex);
-            --i;
+            ring = SQL_HISTORY_SLOT(i);
+            pg_atomic_init_u64(&ring->write_pos, 0);
+            ring->read_pos = 0;
+            ring->history_pid = 0;
+            for (j = 0; j < adbSHRingSize; j++)
+            {
+                SQL_RING_ITEM(ring, j)->changecount = 0;
+                SQL_RING_ITEM(ring, j)->sql[0] = '\0';
+            }
+            for (j = 0; j < adbSHSqlNum; j++)
+            {
+                SQL_HISTORY_ITEM(ring, j)->sql[0] = '\0';
+                SQL_HISTORY_ITEM(ring, j)->lasttime = 0;
+            }
         }
     }
+    LWLockRelease(AddinShmemInitLock);
+    LWLockRegisterTranche(adbshState->lock.tranche, ADBSH_NAME);
 }
 /*
- * ExecutorRun hook: all we need do is track nesting depth
+ * ExecutorRun hook: track nesting depth and sample the statement
  */
 static void adbsh_ExecutorRun(QueryDesc *queryDesc, ScanDirection direction, uint64 count, bool execute_once)
 {
-    PG_TRY();
-    {
-        bind_my_sql_history();
+    bool available;
+    bool saved = false;
+    instr_time start;
 
-        if (my_sql_history && adbssAvailable())
-            save_sql(queryDesc);
+    bind_my_sql_history();
 
-        nested_level++;
+    available = my_sql_ring && adbssAvailable();
+    INSTR_TIME_SET_ZERO(start);
+    if (available)
+    {
+        /*
+         * Record sampled statements before running them, so the ones that
+         * fail or are still running show up as well.
+         */
+        if (sample_sql())
+        {
+            save_sql(queryDesc);
+            saved = true;
+        }
+        else if (adbSHMinDuration >= 0)
+        {
+            INSTR_TIME_SET_CURRENT(start);
+        }
+    }
 
+    nested_level++;
+    PG_TRY();
+    {
         if (prev_ExecutorRun)
             prev_ExecutorRun(queryDesc, direction, count, execute_once);
         else
             standard_ExecutorRun(queryDesc, direction, count, execute_once);
-
-        nested_level--;
     }
     PG_CATCH();
     {
-        if (nested_level > 0)
-            nested_level--;
+        nested_level--;
+        /* a slow statement is worth recording even when it failed */
+        if (available && !saved && slow_sql(&start))
+            save_sql(queryDesc);
         PG_RE_THROW();
     }
     PG_END_TRY();
+    nested_level--;
+
+    if (available && !saved && slow_sql(&start))
+        save_sql(queryDesc);
 }
 static void bind_my_sql_history(void)
 {
-    char *ptr;
-    int i;
-
+    /*
+     * The ring keeps counting from where the previous owner of this slot
+     * stopped, the flusher resets the history when it sees a new pid.
+     */
     if (MyBackendId != InvalidBackendId && !sql_history_set)
     {
-        my_sql_history = MemoryContextAlloc(TopMemoryContext, sizeof(my_sql_history[0]) * adbSHSqlNum);
-        ptr = shmem + (SQL_HISTORY_ITEM_SIZE() * adbSHSqlNum) * (MyBackendId - 1);
-
-        for (i = 0; i < adbSHSqlNum; ++i)
-        {
-            my_sql_history[i] = (SQLHistoryItem *)ptr;
-            SpinLockAcquire(&my_sql_history[i]->mutex);
-            MemSet(my_sql_history[i]->sql, 0, pgstat_track_activity_query_size);
-            my_sql_history[i]->lasttime = 0;
-            my_sql_history[i]->pid = 0;
-            my_sql_history[i]->dbid = 0;
-            my_sql_history[i]->ecount = 0;
-            SpinLockRelease(&my_sql_history[i]->mutex);
-            ptr += SQL_HISTORY_ITEM_SIZE();
-        }
-
+        my_sql_ring = SQL_HISTORY_SLOT(MyBackendId - 1);
         sql_history_set = true;
     }
 }
@@ -387,12 +467,98 @@ static void define_custom_param(void)
     DefineCustomIntVariable("adb_sql_history.sql_num", "Sets the sql number of one process tracked by adb_sql_history.",
                             NULL, &adbSHSqlNum, ADBSH_DEFAULT_MAX_RECORD, 1, INT_MAX, PGC_POSTMASTER, 0, NULL, NULL,
                             NULL);
+    DefineCustomIntVariable("adb_sql_history.ring_size",
+                            "Sets the number of statements one process can buffer before they are flushed.", NULL,
+                            &adbSHRingSize, ADBSH_DEFAULT_RING_SIZE, 1, INT_MAX, PGC_POSTMASTER, 0, NULL, NULL, NULL);
+    DefineCustomIntVariable("adb_sql_history.sample_rate", "Records every Nth statement of one process.",
+                            "Zero records only the statements reaching adb_sql_history.min_duration.",
+                            &adbSHSampleRate, 1, 0, INT_MAX, PGC_SUSET, 0, NULL, NULL, NULL);
+    DefineCustomIntVariable("adb_sql_history.min_duration",
+                            "Records statements running at least this long, regardless of sample_rate.",
+                            "-1 turns this feature off.", &adbSHMinDuration, -1, -1, INT_MAX, PGC_SUSET, GUC_UNIT_MS,
+                            NULL, NULL, NULL);
+    DefineCustomIntVariable("adb_sql_history.flush_interval",
+                            "Sets the interval between flushes of the statement buffers.", NULL, &adbSHFlushInterval,
+                            ADBSH_DEFAULT_FLUSH_INTERVAL, 1, INT_MAX, PGC_SIGHUP, GUC_UNIT_MS, NULL, NULL, NULL);
 }
+
+static void register_flusher(void)
+{
+    BackgroundWorker worker;
+
+    MemSet(&worker, 0, sizeof(BackgroundWorker));
+    worker.bgw_flags = BGWORKER_SHMEM_ACCESS;
+    worker.bgw_start_time = BgWorkerStart_PostmasterStart;
+    worker.bgw_restart_time = 10;
+    strcpy(worker.bgw_library_name, ADBSH_NAME);
+    strcpy(worker.bgw_function_name, "adb_sql_history_flusher_main");
+    strcpy(worker.bgw_name, "adb_sql_history flusher");
+    strcpy(worker.bgw_type, "adb_sql_history flusher");
+
+    RegisterBackgroundWorker(&worker);
+}
+
+/*
+ * Main entry point of the flusher, merge the rings of all backends
+ * every adb_sql_history.flush_interval.
+ */
+void adb_sql_history_flusher_main(Datum main_arg)
+{
+    pqsignal(SIGHUP, SignalHandlerForConfigReload);
+    pqsignal(SIGTERM, SignalHandlerForShutdownRequest);
+    BackgroundWorkerUnblockSignals();
+
+    while (!ShutdownRequestPending)
+    {
+        if (ConfigReloadPending)
+        {
+            ConfigReloadPending = false;
+            ProcessConfigFile(PGC_SIGHUP);
+        }
+
+        LWLockAcquire(&adbshState->lock, LW_EXCLUSIVE);
+        flush_sql_history();
+        LWLockRelease(&adbshState->lock);
+
+        (void)WaitLatch(MyLatch, WL_LATCH_SET | WL_TIMEOUT | WL_EXIT_ON_PM_DEATH, adbSHFlushInterval,
+                        PG_WAIT_EXTENSION);
+        ResetLatch(MyLatch);
+    }
+}
+
+/*
+ * Whether the statement about to run is the Nth one to record
+ */
+static bool sample_sql(void)
+{
+    return adbSHSampleRate > 0 && ++statement_count % adbSHSampleRate == 0;
+}
+
+/*
+ * Whether the statement started at start has run for at least
+ * adb_sql_history.min_duration
+ */
+static bool slow_sql(instr_time *start)
+{
+    instr_time duration;
+
+    if (adbSHMinDuration < 0)
+        return false;
+
+    INSTR_TIME_SET_CURRENT(duration);
+    INSTR_TIME_SUBTRACT(duration, *start);
+    return INSTR_TIME_GET_MILLISEC(duration) >= adbSHMinDuration;
+}
+
+/*
+ * Append the statement to our own ring, never waits for other processes
+ */
 static void save_sql(QueryDesc *queryDesc)
 {
-    bool found = false;
+    volatile SQLRingItem *item;
     char *sql = NULL;
-    int sql_idx = 0;
+    int len;
+    uint64 seq;
 
     sql = get_querytext(queryDesc);
 
@@ -402,14 +568,114 @@ static void save_sql(QueryDesc *queryDesc)
     if (strncmp(sql, "<cluster query>", strlen(sql)) == 0)
         return;
 
-    found = find_sql_pos(sql, &sql_idx);
-    if (!found)
-        insert_sql(sql_idx, sql);
+    len = strlen(sql);
+    if (len >= pgstat_track_activity_query_size)
+        len = pg_mbcliplen(sql, len, pgstat_track_activity_query_size - 1);
+
+    seq = pg_atomic_read_u64(&my_sql_ring->write_pos);
+    item = SQL_RING_ITEM(my_sql_ring, seq % adbSHRingSize);
+
+    item->changecount++;
+    pg_write_barrier();
+    item->seq = seq;
+    item->pid = MyProcPid;
+    item->dbid = MyDatabaseId;
+    item->time = GetCurrentTimestamp();
+    memcpy((char *)item->sql, sql, len);
+    item->sql[len] = '\0';
+    pg_write_barrier();
+    item->changecount++;
+    pg_write_barrier();
+    pg_atomic_write_u64(&my_sql_ring->write_pos, seq + 1);
+
+    pfree(sql);
+}
+
+/*
+ * Merge statements of all rings into histories, caller must hold
+ * adbshState->lock exclusively
+ */
+static void flush_sql_history(void)
+{
+    SQLHistoryRing *ring;
+    volatile SQLRingItem *item;
+    SQLRingItem *copy;
+    uint64 write_pos;
+    uint64 seq;
+    uint32 before;
+    int i;
+
+    copy = palloc(SQL_RING_ITEM_SIZE());
+    for (i = 0; i < MaxBackends; i++)
+    {
+        ring = SQL_HISTORY_SLOT(i);
+        write_pos = pg_atomic_read_u64(&ring->write_pos);
+        pg_read_barrier();
+
+        /* items older than one lap have been overwritten */
+        if (write_pos - ring->read_pos > adbSHRingSize)
+            ring->read_pos = write_pos - adbSHRingSize;
+
+        for (seq = ring->read_pos; seq < write_pos; seq++)
+        {
+            item = SQL_RING_ITEM(ring, seq % adbSHRingSize);
+            for (;;)
+            {
+                before = item->changecount;
+                pg_read_barrier();
+                memcpy(copy, (char *)item, SQL_RING_ITEM_SIZE());
+                pg_read_barrier();
+                if (before == item->changecount && (before & 1) == 0)
+                    break;
+                pg_spin_delay();
+            }
+
+            /* the owner has already reused this item for a newer statement */
+            if (copy->seq != seq)
+                continue;
+
+            merge_sql(ring, copy);
+        }
+        ring->read_pos = write_pos;
+    }
+    pfree(copy);
+}
+
+static void merge_sql(SQLHistoryRing *ring, SQLRingItem *item)
+{
+    SQLHistoryItem *sql_item;
+    int sql_idx = 0;
+    int i;
+
+    /* slot has been taken by a new backend, forget the old history */
+    if (ring->history_pid != item->pid)
+    {
+        for (i = 0; i < adbSHSqlNum; i++)
+        {
+            sql_item = SQL_HISTORY_ITEM(ring, i);
+            sql_item->sql[0] = '\0';
+            sql_item->lasttime = 0;
+        }
+        ring->history_pid = item->pid;
+    }
+
+    if (find_sql_pos(ring, item->sql, &sql_idx))
+    {
+        sql_item = SQL_HISTORY_ITEM(ring, sql_idx);
+        sql_item->lasttime = item->time;
+        sql_item->ecount++;
+    }
     else
-        update_sql(sql_idx);
-    return;
+    {
+        sql_item = SQL_HISTORY_ITEM(ring, sql_idx);
+        sql_item->pid = item->pid;
+        sql_item->dbid = item->dbid;
+        strcpy(sql_item->sql, item->sql);
+        sql_item->lasttime = item->time;
+        sql_item->ecount = 1;
+    }
 }
-static bool find_sql_pos(char *sql, int *idx)
+static bool find_sql_pos(SQLHistoryRing *ring, char *sql, int *idx)
 {
     int i = 0;
     bool sql_found = false;
@@ -417,16 +683,10 @@ static bool find_sql_pos(char *sql, int *idx)
     TimestampTz min_time = 0;
     bool empty_found = false;
 
-    if (strlen(sql) == 0)
-    {
-        ereport(COMMERROR, errmsg("find_sql, sql is null"));
-        return false;
-    }
-
     for (i = 0; i < adbSHSqlNum; i++)
     {
-        sql_item = (SQLHistoryItem *)my_sql_history[i];
-        if (strlen(sql_item->sql) > 0)
+        sql_item = SQL_HISTORY_ITEM(ring, i);
+        if (sql_item->sql[0] != '\0')
         {
             if (0 == pg_strcasecmp(sql_item->sql, sql))
             {
@@ -451,9 +711,7 @@ static bool find_sql_pos(char *sql, int *idx)
         /* list is full, find the youngest time */
         for (i = 0; i < adbSHSqlNum; i++)
         {
-            /*do not need add slock_t of SQLHistoryItem here, because only do read here, and no other place will call
-             * this function*/
-            sql_item = (SQLHistoryItem *)my_sql_history[i];
+            sql_item = SQL_HISTORY_ITEM(ring, i);
 
             if (i == 0)
             {
@@ -473,39 +731,6 @@ static bool find_sql_pos(char *sql, int *idx)
 
     return sql_found;
 }
-static void insert_sql(int sql_idx, char *sql)
-{
-    SQLHistoryItem *sql_item = NULL;
-
-    if (sql_idx >= adbSHSqlNum)
-    {
-        ereport(COMMERROR, errmsg("sql_idx is not smaller than adbSHSqlNum, this should not happen"));
-        return;
-    }
-    sql_item = (SQLHistoryItem *)my_sql_history[sql_idx];
-    SpinLockAcquire(&sql_item->mutex);
-    sql_item->pid = MyProcPid;
-    sql_item->dbid = MyDatabaseId;
-    StrNCpy(sql_item->sql, sql, pgstat_track_activity_query_size);
-    sql_item->lasttime = GetCurrentTimestamp();
-    sql_item->ecount = 1;
-    SpinLockRelease(&sql_item->mutex);
-}
-
-static void update_sql(int sql_idx)
-{
-    SQLHistoryItem *sql_item = NULL;
-    if (sql_idx >= adbSHSqlNum)
-    {
-        ereport(COMMERROR, errmsg("sql_idx is not smaller than adbSHSqlNum, this should not happen"));
-        return;
-    }
-    sql_item = (SQLHistoryItem *)my_sql_history[sql_idx];
-    SpinLockAcquire(&sql_item->mutex);
-    sql_item->lasttime = GetCurrentTimestamp();
-    sql_item->ecount++;
-    SpinLockRelease(&sql_item->mutex);
-}
 static char *get_querytext(QueryDesc *queryDesc)
 {
     const char *query;
@@ -0,0 +1,154 @@
+/* contrib/adb_stat_statements/adb_stat_statements--1.0--1.1.sql */
+
+-- complain if script is sourced in psql, rather than via ALTER EXTENSION
+\echo Use "ALTER EXTENSION adb_stat_statements UPDATE TO '1.1'" to load this file. \quit
+
+/* First we have to remove them from the extension */
+ALTER EXTENSION adb_stat_statements DROP VIEW adb_stat_statements;
+ALTER EXTENSION adb_stat_statements DROP VIEW adb_stat_statements_notext;
+ALTER EXTENSION adb_stat_statements DROP FUNCTION adb_stat_statements(boolean);
+
+/* Then we can drop them */
+DROP VIEW adb_stat_statements;
+DROP VIEW adb_stat_statements_notext;
+DROP FUNCTION adb_stat_statements(boolean);
+
+/* Now redefine */
+-- The order, type, etc. of the fields correspond to those defined in the code. 
+-- If you change the structure of this field, the code should also be changed, 
+-- such as AdbssAttributes, checkAdbssAttrs, etc. 
+-- Note that these fields should be identical with TABLE adb_stat_statements_internal
+CREATE FUNCTION adb_stat_statements(IN showtext boolean,
+    OUT userid oid,
+    OUT dbid oid,
+    OUT queryid bigint,
+    OUT planid bigint,
+    OUT calls bigint,
+    OUT rows bigint,
+    OUT total_time double precision,
+    OUT min_time double precision,
+    OUT max_time double precision,
+    OUT mean_time double precision,
+    OUT remote_wait_time double precision,
+    OUT reduce_wait_time double precision,
+    OUT gtm_wait_time double precision,
+    OUT last_execution timestamp with time zone,
+    OUT query text,
+    OUT plan text,
+    OUT explain_format int,
+    OUT explain_plan text,
+    OUT bound_params text[]
+)
+RETURNS SETOF record
+AS 'MODULE_PATHNAME', 'adb_stat_statements'
+LANGUAGE C STRICT VOLATILE PARALLEL SAFE;
+
+/* New columns are in the middle, rebuild the table and keep the saved plans */
+ALTER TABLE adb_stat_statements_internal RENAME TO adb_stat_statements_internal_old;
+DROP INDEX adb_stat_statements_internal_queryid;
+
+CREATE TABLE adb_stat_statements_internal (
+    userid oid,
+    dbid oid,
+    queryid bigint,
+    planid bigint,
+    calls bigint,
+    rows bigint,
+    total_time double precision,
+    min_time double precision,
+    max_time double precision,
+    mean_time double precision,
+    remote_wait_time double precision,
+    reduce_wait_time double precision,
+    gtm_wait_time double precision,
+    last_execution timestamp with time zone,
+    query text,
+    plan text,
+    explain_format int,
+    explain_plan text,
+    bound_params text[]
+);
+CREATE INDEX adb_stat_statements_internal_queryid ON adb_stat_statements_internal (queryid);
+
+INSERT INTO adb_stat_statements_internal
+SELECT userid, dbid, queryid, planid, calls, rows,
+       total_time, min_time, max_time, mean_time,
+       0, 0, 0,
+       last_execution, query, plan, explain_format, explain_plan, bound_params
+FROM adb_stat_statements_internal_old;
+
+DROP TABLE adb_stat_statements_internal_old;
+
+-- The views keep the 1.0 columns in place and append the new ones at the
+-- end, adb_global_views 1.1 reads them in this order.
+CREATE OR REPLACE
+VIEW adb_stat_statements AS
+SELECT
+	t1.userid,
+	t3.usename,
+	t1.dbid,
+	t4.datname as dbname,
+	t1.queryid,
+	t1.planid,
+	t1.calls,
+	t1.rows,
+	t1.total_time,
+	t1.min_time,
+	t1.max_time,
+	t1.mean_time,
+	t1.last_execution,
+	t2.query,
+	t1.plan,
+	t1.explain_format,
+	t1.explain_plan,
+	t1.bound_params,
+	t1.remote_wait_time,
+	t1.reduce_wait_time,
+	t1.gtm_wait_time
+FROM
+	adb_stat_statements(true) t1,
+	pg_stat_statements t2,
+	pg_user t3,
+	pg_database t4
+where
+	t1.userid = t2.userid
+	and t1.dbid = t2.dbid
+	and t1.queryid = t2.queryid
+	and t1.userid = t3.usesysid
+	and t1.dbid = t4.oid;
+
+CREATE OR REPLACE
+VIEW adb_stat_statements_notext AS
+SELECT
+	t1.userid,
+	t3.usename,
+	t1.dbid,
+	t4.datname as dbname,
+	t1.queryid,
+	t1.planid,
+	t1.calls,
+	t1.rows,
+	t1.total_time,
+	t1.min_time,
+	t1.max_time,
+	t1.mean_time,
+	t1.last_execution,
+	t2.query,
+	t1.plan,
+	t1.explain_format,
+	t1.explain_plan,
+	t1.bound_params,
+	t1.remote_wait_time,
+	t1.reduce_wait_time,
+	t1.gtm_wait_time
+FROM
+	adb_stat_statements(false) t1,
+	pg_stat_statements t2,
+	pg_user t3,
+	pg_database t4
+where
+	t1.userid = t2.userid
+	and t1.dbid = t2.dbid
+	and t1.queryid = t2.queryid
+	and t1.userid = t3.usesysid
+	and t1.dbid = t4.oid;
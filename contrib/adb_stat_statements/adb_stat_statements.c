@@ -105,6 +105,9 @@ typedef struct AdbssCounters
 	double min_time;
 	double max_time;
 	double mean_time;
+	double remote_wait_time;	/* total time waiting for remote nodes */
+	double reduce_wait_time;	/* total time waiting for dynamic reduce */
+	double gtm_wait_time;		/* total time waiting for GTM */
 	TimestampTz last_execution;
 } AdbssCounters;
 
@@ -172,6 +175,10 @@ static void saveTupleToDsa(AdbssEntry *entry,
 						   MinimalTuple textTuple, dsa_pointer dp);
 static int adbss_entry_cmp(const void *lhs, const void *rhs);
 static bool isPlanTooLarge(uint64 queryId, size_t planLength);
+static void getClusterWaitTime(QueryDesc *queryDesc,
+							   double *remoteWaitTime,
+							   double *reduceWaitTime,
+							   double *gtmWaitTime);
 static Datum ParamList2TextArr(const ParamListInfo from);
 static bool is_alter_extension_cmd(Node *stmt);
 static bool is_drop_extension_stmt(Node *stmt);
@@ -573,9 +580,12 @@ static PlannedStmt *adbss_planner_hook(Query *parse,
 
 static void adbss_ExecutorStart(QueryDesc *queryDesc, int eflags)
 {
+	bool		track = false;
+
 	if (queryDesc->plannedstmt->queryId != UINT64CONST(0) &&
 		adbssAvailable())
 	{
+		track = true;
 		/* Enable per-node instrumentation iff analyze is required. */
 		if (adbssExplainAnalyze && (eflags & EXEC_FLAG_EXPLAIN_ONLY) == 0)
 		{
@@ -585,12 +595,29 @@ static void adbss_ExecutorStart(QueryDesc *queryDesc, int eflags)
 				queryDesc->instrument_options |= INSTRUMENT_ROWS;
 			if (adbssExplainBuffers)
 				queryDesc->instrument_options |= INSTRUMENT_BUFFERS;
+#ifdef ADB
+			queryDesc->instrument_options |= INSTRUMENT_CLUSTER;
+#endif /* ADB */
 		}
 	}
 	if (prev_ExecutorStart)
 		prev_ExecutorStart(queryDesc, eflags);
 	else
 		standard_ExecutorStart(queryDesc, eflags);
+
+	/*
+	 * The wait times come from queryDesc->totaltime, normally set up by
+	 * pg_stat_statements.  Don't depend on the hook order, allocate it
+	 * ourselves when nobody did.
+	 */
+	if (track && queryDesc->totaltime == NULL)
+	{
+		MemoryContext oldcxt;
+
+		oldcxt = MemoryContextSwitchTo(queryDesc->estate->es_query_cxt);
+		queryDesc->totaltime = InstrAlloc(1, INSTRUMENT_ALL);
+		MemoryContextSwitchTo(oldcxt);
+	}
 }
 
 /*
@@ -801,6 +828,9 @@ static bool checkAdbssAttrs(TupleDesc adbssRelDesc)
 	checkAdbssRelDescAttr(Anum_adbss_min_time, FLOAT8OID);
 	checkAdbssRelDescAttr(Anum_adbss_max_time, FLOAT8OID);
 	checkAdbssRelDescAttr(Anum_adbss_mean_time, FLOAT8OID);
+	checkAdbssRelDescAttr(Anum_adbss_remote_wait_time, FLOAT8OID);
+	checkAdbssRelDescAttr(Anum_adbss_reduce_wait_time, FLOAT8OID);
+	checkAdbssRelDescAttr(Anum_adbss_gtm_wait_time, FLOAT8OID);
 	checkAdbssRelDescAttr(Anum_adbss_last_execution, TIMESTAMPTZOID);
 	checkAdbssRelDescAttr(Anum_adbss_query, TEXTOID);
 	checkAdbssRelDescAttr(Anum_adbss_plan, TEXTOID);
@@ -826,6 +856,9 @@ static void insertAdbssPlan(Relation adbssRel,
 	bool nulls[Natts_adbss] = {0};
 	char *queryText;
 	double totalTime;
+	double remoteWaitTime;
+	double reduceWaitTime;
+	double gtmWaitTime;
 	char *explainPlanString;
 
 	values[Anum_adbss_userid - 1] = ObjectIdGetDatum(GetUserId());
@@ -843,6 +876,11 @@ static void insertAdbssPlan(Relation adbssRel,
 	values[Anum_adbss_min_time - 1] = Float8GetDatum(totalTime);
 	values[Anum_adbss_max_time - 1] = Float8GetDatum(totalTime);
 	values[Anum_adbss_mean_time - 1] = Float8GetDatum(totalTime);
+
+	getClusterWaitTime(queryDesc, &remoteWaitTime, &reduceWaitTime, &gtmWaitTime);
+	values[Anum_adbss_remote_wait_time - 1] = Float8GetDatum(remoteWaitTime);
+	values[Anum_adbss_reduce_wait_time - 1] = Float8GetDatum(reduceWaitTime);
+	values[Anum_adbss_gtm_wait_time - 1] = Float8GetDatum(gtmWaitTime);
 	values[Anum_adbss_last_execution - 1] = TimestampTzGetDatum(GetCurrentTimestamp());
 
 	queryText = getQueryText(queryDesc);
@@ -893,6 +931,11 @@ static void updateAdbssPlan(Relation adbssRel,
 	HeapTuple newTuple;
 	double totalTime;
 	double tempTime;
+	double waitTime[3];
+	AttrNumber waitAttnum[3] = {Anum_adbss_remote_wait_time,
+								Anum_adbss_reduce_wait_time,
+								Anum_adbss_gtm_wait_time};
+	int i;
 	uint64 calls;
 	uint64 rows;
 	char *explainPlanString;
@@ -968,6 +1011,18 @@ static void updateAdbssPlan(Relation adbssRel,
 		repls[Anum_adbss_mean_time - 1] = true;
 	}
 
+	getClusterWaitTime(queryDesc, &waitTime[0], &waitTime[1], &waitTime[2]);
+	for (i = 0; i < lengthof(waitAttnum); i++)
+	{
+		value = heap_getattr(oldTuple, waitAttnum[i], RelationGetDescr(adbssRel), &isnull);
+		if (isnull)
+			tempTime = 0;
+		else
+			tempTime = DatumGetFloat8(value);
+		values[waitAttnum[i] - 1] = Float8GetDatum(tempTime + waitTime[i]);
+		repls[waitAttnum[i] - 1] = true;
+	}
+
 	values[Anum_adbss_last_execution - 1] = TimestampTzGetDatum(GetCurrentTimestamp());
 	repls[Anum_adbss_last_execution - 1] = true;
 
@@ -1070,6 +1125,9 @@ static void adbssStoreToDsa(QueryDesc *queryDesc)
 	uint64 planid;
 	double totalTime;
 	double tempTime;
+	double remoteWaitTime;
+	double reduceWaitTime;
+	double gtmWaitTime;
 
 	/* Safety check... */
 	if (!adbssState || !adbssHtab)
@@ -1189,6 +1247,11 @@ static void adbssStoreToDsa(QueryDesc *queryDesc)
 			}
 		}
 
+		getClusterWaitTime(queryDesc, &remoteWaitTime, &reduceWaitTime, &gtmWaitTime);
+		e->counters.remote_wait_time += remoteWaitTime;
+		e->counters.reduce_wait_time += reduceWaitTime;
+		e->counters.gtm_wait_time += gtmWaitTime;
+
 		e->counters.last_execution = GetCurrentTimestamp();
 
 		if (updateSavedPlan && !omitSavePlan)
@@ -1419,6 +1482,32 @@ static bool isPlanTooLarge(uint64 queryId, size_t planLength)
 	return large;
 }
 
+/*
+ * Time spent by this query waiting for the cluster, in msec.
+ * All zero when not running in a cluster.
+ */
+static void getClusterWaitTime(QueryDesc *queryDesc,
+							   double *remoteWaitTime,
+							   double *reduceWaitTime,
+							   double *gtmWaitTime)
+{
+#ifdef ADB
+	if (queryDesc->totaltime && queryDesc->totaltime->need_clusterusage)
+	{
+		ClusterUsage *usage = &queryDesc->totaltime->clusterusage;
+
+		*remoteWaitTime = INSTR_TIME_GET_MILLISEC(usage->remote_wait_time);
+		*reduceWaitTime = INSTR_TIME_GET_MILLISEC(usage->reduce_wait_time);
+		*gtmWaitTime = INSTR_TIME_GET_MILLISEC(usage->gtm_wait_time);
+		return;
+	}
+#endif /* ADB */
+
+	*remoteWaitTime = 0;
+	*reduceWaitTime = 0;
+	*gtmWaitTime = 0;
+}
+
 static Datum ParamList2TextArr(const ParamListInfo from)
 {
 	char *str;
@@ -1776,6 +1865,13 @@ Datum
 
 	MemoryContextSwitchTo(oldcontext);
 
+	/* the result columns changed in 1.1 */
+	if (tupdesc->natts != Natts_adbss)
+		ereport(ERROR,
+				(errcode(ERRCODE_OBJECT_NOT_IN_PREREQUISITE_STATE),
+				 errmsg(ADBSS_NAME " extension needs to be updated"),
+				 errhint("Run ALTER EXTENSION " ADBSS_NAME " UPDATE.")));
+
 	LWLockAcquire(&adbssState->lock, LW_SHARED);
 
 	hash_seq_init(&hash_seq, adbssHtab);
@@ -1809,6 +1905,9 @@ Datum
 		values[Anum_adbss_min_time - 1] = Float8GetDatumFast(tmp.min_time);
 		values[Anum_adbss_max_time - 1] = Float8GetDatumFast(tmp.max_time);
 		values[Anum_adbss_mean_time - 1] = Float8GetDatumFast(tmp.mean_time);
+		values[Anum_adbss_remote_wait_time - 1] = Float8GetDatumFast(tmp.remote_wait_time);
+		values[Anum_adbss_reduce_wait_time - 1] = Float8GetDatumFast(tmp.reduce_wait_time);
+		values[Anum_adbss_gtm_wait_time - 1] = Float8GetDatumFast(tmp.gtm_wait_time);
 		values[Anum_adbss_last_execution - 1] = TimestampTzGetDatum(tmp.last_execution);
 
 		if (is_allowed_role || entry->key.userid == userid)
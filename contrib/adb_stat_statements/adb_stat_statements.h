@@ -24,6 +24,9 @@ typedef enum AdbssAttributes
 	Anum_adbss_min_time,
 	Anum_adbss_max_time,
 	Anum_adbss_mean_time,
+	Anum_adbss_remote_wait_time,
+	Anum_adbss_reduce_wait_time,
+	Anum_adbss_gtm_wait_time,
 	Anum_adbss_last_execution,
 #define Anum_adbss_offset (Anum_adbss_last_execution) /* the above value */
 #define Anum_adbss_minimal(anum) (anum - Anum_adbss_offset)
@@ -0,0 +1,25 @@
+CREATE EXTENSION pg_stat_statements;
+CREATE EXTENSION adb_stat_statements VERSION '1.0';
+ALTER EXTENSION adb_stat_statements UPDATE TO '1.1';
+
+-- the 1.0 columns keep their positions, the wait times are appended
+SELECT attnum, attname FROM pg_attribute
+  WHERE attrelid = 'antdb.adb_stat_statements'::regclass AND attnum > 0
+  ORDER BY attnum;
+SELECT attnum, attname FROM pg_attribute
+  WHERE attrelid = 'antdb.adb_stat_statements_notext'::regclass AND attnum > 18
+  ORDER BY attnum;
+
+SELECT antdb.adb_stat_statements_reset();
+CREATE TABLE adbss_t(id int);
+SELECT count(*) FROM adbss_t;
+SELECT count(*) FROM adbss_t;
+
+SELECT calls, remote_wait_time >= 0 AS remote, reduce_wait_time >= 0 AS reduce,
+       gtm_wait_time >= 0 AS gtm
+  FROM antdb.adb_stat_statements
+  WHERE query = 'SELECT count(*) FROM adbss_t';
+
+DROP TABLE adbss_t;
+DROP EXTENSION adb_stat_statements;
+DROP EXTENSION pg_stat_statements;
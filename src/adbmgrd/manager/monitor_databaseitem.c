@@ -37,15 +37,18 @@
 #include "access/xact.h"
 #include "utils/date.h"
 
-static void monitor_get_sum_all_onetypenode_onedb(Relation rel_node, char *sqlstr, char *dbname
-								, char nodetype, int64 iarray[], int len);
 static int64 monitor_standbydelay(char nodetype);
-static int64 monitor_all_typenode_usedbname_locksnum(Relation rel_node, char *sqlstr, char *dbname
-		, char nodetype, int gettype);
+static void monitor_send_stringvalues(char cmdtype, MonitorNodeRequest *req);
 
 #define SQLSTRSTANDBYDELAY  "select CASE WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0 ELSE  " \
 	"round(EXTRACT (EPOCH FROM now() - pg_last_xact_replay_timestamp())) end;"
 
+/*the numbers of values got from one datanode master and one coordinator for a database,
+* not include the node time at the end, see monitor_databaseitem_insert_data
+*/
+#define MONITOR_DN_VALUES_NUM		4
+#define MONITOR_COORD_VALUES_NUM	9
+
 char *mgr_zone;
 
 typedef enum ResultChoice
@@ -107,64 +110,30 @@ int64 monitor_get_result_one_node(Relation rel_node, char *sqlstr, char *dbname,
 	return ret;
 }
 
+/*
+* get sql'result on all the given type nodes, the sql runs on the nodes at the same time,
+* then get min, max or sum of them as gettype
+*/
 int64 monitor_get_sqlres_all_typenode_usedbname(Relation rel_node, char *sqlstr, char *dbname, char nodetype, int gettype)
 {
-	/*get datanode master user, port*/
-	TableScanDesc rel_scan;
-	ScanKeyData key[4];
-	HeapTuple tuple;
-	HeapTuple tup;
-	Form_mgr_node mgr_node;
-	Form_mgr_host mgr_host;
-	char *user;
-	char *address;
-	int port;
+	MonitorNodeRequest *req;
+	List *reqlist;
+	ListCell *lc;
+	char *value;
 	int64 result = 0;
 	int64 resulttmp = 0;
-	int agentport;
 	bool bfirst = true;
 
-	ScanKeyInit(&key[0],
-		Anum_mgr_node_nodetype
-		,BTEqualStrategyNumber
-		,F_CHAREQ
-		,CharGetDatum(nodetype));
-	ScanKeyInit(&key[1]
-		,Anum_mgr_node_nodeinited
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-	ScanKeyInit(&key[2]
-		,Anum_mgr_node_nodeincluster
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-	ScanKeyInit(&key[3]
-		,Anum_mgr_node_nodezone
-		,BTEqualStrategyNumber
-		,F_NAMEEQ
-		,CStringGetDatum(mgr_zone));
-	rel_scan = table_beginscan_catalog(rel_node, 4, key);
-	while((tuple = heap_getnext(rel_scan, ForwardScanDirection)) != NULL)
+	reqlist = monitor_get_node_requests(rel_node, nodetype, sqlstr, dbname, NIL);
+	monitor_get_stringvalues_nodes(AGT_CMD_GET_SQL_STRINGVALUES, reqlist);
+	foreach(lc, reqlist)
 	{
-		mgr_node = (Form_mgr_node)GETSTRUCT(tuple);
-		Assert(mgr_node);
-		port = mgr_node->nodeport;
-		address = get_hostaddress_from_hostoid(mgr_node->nodehost);
-		user = get_hostuser_from_hostoid(mgr_node->nodehost);
-		/*get agent port*/
-		tup = SearchSysCache1(HOSTHOSTOID, ObjectIdGetDatum(mgr_node->nodehost));
-		if(!(HeapTupleIsValid(tup)))
-		{
-			ereport(ERROR, (errmsg("host oid \"%u\" not exist", mgr_node->nodehost)
-				, err_generic_string(PG_DIAG_TABLE_NAME, "mgr_host")
-				, errcode(ERRCODE_INTERNAL_ERROR)));
-		}
-		mgr_host = (Form_mgr_host)GETSTRUCT(tup);
-		Assert(mgr_host);
-		agentport = mgr_host->hostagentport;
-		ReleaseSysCache(tup);
-		resulttmp = monitor_get_onesqlvalue_one_node(agentport, sqlstr, user, address, port, dbname);
+		req = (MonitorNodeRequest *)lfirst(lc);
+		/*the same as monitor_get_onesqlvalue_one_node, -1 for the node without result*/
+		if (monitor_get_request_values(req, &value, 1) == 1)
+			resulttmp = atoi(value);
+		else
+			resulttmp = -1;
 		if(bfirst && gettype==GET_MIN) result = resulttmp;
 		bfirst = false;
 		switch(gettype)
@@ -182,10 +151,8 @@ int64 monitor_get_sqlres_all_typenode_usedbname(Relation rel_node, char *sqlstr,
 				result = 0;
 				break;
 		};
-		pfree(user);
-		pfree(address);
 	}
-	heap_endscan(rel_scan);
+	monitor_free_node_requests(reqlist);
 
 	return result;
 }
@@ -209,29 +176,32 @@ Datum monitor_databaseitem_insert_data(PG_FUNCTION_ARGS)
 	int64 connectnum = 0;
 	bool bautovacuum = false;
 	bool barchive = false;
-	bool bfrist = true;
+	bool bfirstdn;
+	bool bfirstcoord;
 	int64 dbage = 0;
 	int64 standbydelay = 0;
 	int64 indexsize = 0;
 	int longtransmintime = 100;
 	int iloop = 0;
-	int64 iarray_heaphit_read_indexsize[3] = {0,0,0};
-	int64 iarray_commit_connect_longidle_prepare[6] = {0, 0, 0, 0, 0, 0};
+	int64 iarray[MONITOR_COORD_VALUES_NUM];
 	int agentport;
 	float heaphitrate = 0;
 	float commitrate = 0;
 	List *dbnamelist = NIL;
+	List *reqlist;
+	List *tuplelist = NIL;
 	ListCell *cell;
+	ListCell *lc;
 	HeapTuple tuple;
 	TimestampTz time;
 	Relation rel;
 	Relation rel_node;
-	StringInfoData sqldbsizeStrData;
-	StringInfoData sqldbageStrData;
-	StringInfoData sqllocksStrData;
-	StringInfoData sqlstr_heaphit_read_indexsize;
-	StringInfoData sqlstr_commit_connect_longidle_prepare;
-	char *sqlunusedindex = "select count(*) from  pg_stat_user_indexes where idx_scan = 0";
+	CatalogIndexState indstate;
+	MonitorNodeRequest *req;
+	StringInfoData sqldnStrData;
+	StringInfoData sqlcoordStrData;
+	char *values[MONITOR_COORD_VALUES_NUM + 1];
+	char *nodetime;
 	const char *clustertime = NULL;
 	Monitor_Threshold monitor_threshold;
 
@@ -262,85 +232,149 @@ Datum monitor_databaseitem_insert_data(PG_FUNCTION_ARGS)
 	{
 		longtransmintime = monitor_threshold.threshold_warning;
 	}
-	initStringInfo(&sqldbsizeStrData);
-	initStringInfo(&sqldbageStrData);
-	initStringInfo(&sqllocksStrData);
-	initStringInfo(&sqlstr_heaphit_read_indexsize);
-	initStringInfo(&sqlstr_commit_connect_longidle_prepare);
+
+	/*these vars just need get one time, from coordinator*/
+	{
+		char *sqlstr_vacuum_archive_dbage = "select case when setting = \'on\' then 1 else 0 end from pg_settings where name=\'autovacuum\' union all select case when setting = \'on\' then 1 else 0 end from pg_settings where name=\'archive_mode\'";
+		int64 iarray_vacuum_archive_dbage[2] = {0,0};
+		monitor_get_sqlvalues_one_node(agentport, sqlstr_vacuum_archive_dbage, user, hostaddress, coordport,DEFAULT_DB, iarray_vacuum_archive_dbage, 2);
+
+		bautovacuum = (iarray_vacuum_archive_dbage[0] == 0 ? false:true);
+		barchive = (iarray_vacuum_archive_dbage[1] == 0 ? false:true);
+
+		/*standby delay*/
+		standbydelay = monitor_standbydelay(CNDN_TYPE_DATANODE_SLAVE);
+	}
+
+	initStringInfo(&sqldnStrData);
+	initStringInfo(&sqlcoordStrData);
 	foreach(cell, dbnamelist)
 	{
 		dbname = (char *)(lfirst(cell));
-		/* get database size on coordinator*/
-		appendStringInfo(&sqldbsizeStrData, "select round(pg_database_size(datname)::numeric(18,4)/1024/1024) from pg_database where datname=\'%s\';", dbname);
-		/*dbsize, unit MB*/
-		dbsize = monitor_get_result_one_node(rel_node, sqldbsizeStrData.data, DEFAULT_DB, CNDN_TYPE_GTM_COOR_MASTER);
-		for (iloop=0; iloop<3; iloop++)
-		{
-			iarray_heaphit_read_indexsize[iloop] = 0;
-		}
-		/*heaphit, heapread, indexsize*/
-		/*indexsize: now user "select 1.0" instead of right sql as below because the index
+		/*
+		* every node gets all its values of the database in one sql, and the sqls are sent to
+		* all datanode masters and coordinators before reading any result, so one database
+		* costs one round trip of the slowest node
+		*
+		* on datanode master: heaphit, heapread, indexsize, unused index, node time
+		*
+		*indexsize: now user "select 1" instead of right sql as below because the index
 		*size is too large and used too much time more then ten minutes.
 		*
 		* select round(sum(pg_catalog.pg_indexes_size(c.oid))::numeric(18,4)/1024/1024) from
 		*pg_catalog.pg_class c  WHERE c.relkind = 'r' or c.relkind = 't';
 		*/
-		appendStringInfoString(&sqlstr_heaphit_read_indexsize, "select sum(heap_blks_hit/100.0)::bigint from pg_statio_user_tables union all select sum(heap_blks_read/100.0)::bigint from pg_statio_user_tables union all select 1.0");
-		monitor_get_sum_all_onetypenode_onedb(rel_node, sqlstr_heaphit_read_indexsize.data, dbname, CNDN_TYPE_DATANODE_MASTER, iarray_heaphit_read_indexsize, 3);
+		appendStringInfoString(&sqldnStrData, "select (select sum(heap_blks_hit/100.0)::bigint from pg_statio_user_tables)"
+			", (select sum(heap_blks_read/100.0)::bigint from pg_statio_user_tables)"
+			", 1"
+			", (select count(*) from pg_stat_user_indexes where idx_scan = 0)"
+			", now();");
+		/*
+		* on coordinator: xact_commit, xact_rollback, numbackends, longquerynum, idlequerynum, preparednum,
+		* locks, database size(unit MB), database transaction age, node time
+		*/
+		appendStringInfo(&sqlcoordStrData, "select (select (xact_commit/100.0)::bigint from pg_stat_database where datname = \'%1$s\')"
+			", (select (xact_rollback/100.0)::bigint from pg_stat_database where datname = \'%1$s\')"
+			", (select numbackends from pg_stat_database where datname = \'%1$s\')"
+			", (select count(*) from pg_stat_activity where extract(epoch from (query_start-now())) > %2$d and datname=\'%1$s\')"
+			", (select count(*) from pg_stat_activity where state='idle' and datname = \'%1$s\')"
+			", (select count(*) from pg_prepared_xacts where database= \'%1$s\')"
+			", (select count(*) from pg_locks ,pg_database where pg_database.Oid = pg_locks.database and pg_database.datname=\'%1$s\')"
+			", (select round(pg_database_size(datname)::numeric(18,4)/1024/1024) from pg_database where datname=\'%1$s\')"
+			", (select age(datfrozenxid) from pg_database where datname=\'%1$s\')"
+			", now();", dbname, longtransmintime);
+
+		reqlist = monitor_get_node_requests(rel_node, CNDN_TYPE_DATANODE_MASTER, sqldnStrData.data, dbname, NIL);
+		reqlist = monitor_get_node_requests(rel_node, CNDN_TYPE_GTM_COOR_MASTER, sqlcoordStrData.data, dbname, reqlist);
+		monitor_get_stringvalues_nodes(AGT_CMD_GET_SQL_STRINGVALUES, reqlist);
+
+		heaphit = heapread = indexsize = unusedindexnum = 0;
+		commit = rollback = connectnum = longquerynum = idlequerynum = preparenum = 0;
+		locksnum = dbsize = dbage = 0;
+		bfirstdn = bfirstcoord = true;
+		foreach(lc, reqlist)
+		{
+			req = (MonitorNodeRequest *)lfirst(lc);
+			if (req->nodetype == CNDN_TYPE_DATANODE_MASTER)
+			{
+				if (monitor_get_request_values(req, values, MONITOR_DN_VALUES_NUM + 1) != MONITOR_DN_VALUES_NUM + 1)
+					ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
+						,errmsg("get time from node error,")));
+				for (iloop=0; iloop<MONITOR_DN_VALUES_NUM; iloop++)
+					iarray[iloop] = atoll(values[iloop]);
+				nodetime = values[MONITOR_DN_VALUES_NUM];
+
+				heaphit += iarray[0];
+				heapread += iarray[1];
+				indexsize += iarray[2];
+				/*unused index on datanode master, get min*/
+				if (bfirstdn || iarray[3] < unusedindexnum)
+					unusedindexnum = iarray[3];
+				bfirstdn = false;
+
+				/* check warn threshold */
+				mthreshold_levelvalue_impositiveseq(OBJECT_NODE_HEAPHIT, req->address, nodetime
+					, iarray[0]+iarray[1] == 0 ? 100 : (iarray[0]*1.0/(iarray[0]+iarray[1])*100.0)
+					,  "heaphit rate");
+			}
+			else
+			{
+				if (monitor_get_request_values(req, values, MONITOR_COORD_VALUES_NUM + 1) != MONITOR_COORD_VALUES_NUM + 1)
+					ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
+						,errmsg("get time from node error,")));
+				for (iloop=0; iloop<MONITOR_COORD_VALUES_NUM; iloop++)
+					iarray[iloop] = atoll(values[iloop]);
+				nodetime = values[MONITOR_COORD_VALUES_NUM];
+
+				/*get all coordinators' result then sum them*/
+				commit += iarray[0];
+				rollback += iarray[1];
+				connectnum += iarray[2];
+				longquerynum += iarray[3];
+				idlequerynum += iarray[4];
+				preparenum += iarray[5];
+				/*get locks on coordinator, get max*/
+				if (iarray[6] > locksnum)
+					locksnum = iarray[6];
+				/*database size and age are the same on every coordinator*/
+				if (bfirstcoord)
+				{
+					dbsize = iarray[7];
+					dbage = iarray[8];
+				}
+				bfirstcoord = false;
+
+				/* check warn threshold */
+				mthreshold_levelvalue_impositiveseq(OBJECT_NODE_COMMITRATE, req->address, nodetime
+					, iarray[0]+iarray[1] == 0 ? 100 : (iarray[0]*1.0/(iarray[0]+iarray[1])*100.0)
+					,  "commit rate");
+				mthreshold_levelvalue_positiveseq(OBJECT_NODE_CONNECT, req->address, nodetime
+					, iarray[2], "connect");
+				mthreshold_levelvalue_positiveseq(OBJECT_NODE_LONGTRANS, req->address, nodetime
+					, iarray[3], "long transactions");
+				mthreshold_levelvalue_positiveseq(OBJECT_NODE_LONGTRANS, req->address, nodetime
+					, iarray[4], "idle transactions");
+				mthreshold_levelvalue_positiveseq(OBJECT_NODE_LOCKS, req->address, nodetime
+					, iarray[6], "locks");
+			}
+		}
+		monitor_free_node_requests(reqlist);
 
-		heaphit = iarray_heaphit_read_indexsize[0];
-		heapread = iarray_heaphit_read_indexsize[1];
 		if((heaphit + heapread) == 0)
 			heaphitrate = 100;
 		else
 			heaphitrate = (heaphit*1.0/(heaphit + heapread))*100.0;
-		/*the database index size, unit: MB */
-		indexsize = iarray_heaphit_read_indexsize[2];
-
-		clustertime = timestamptz_to_str(GetCurrentTimestamp());
-		mthreshold_levelvalue_impositiveseq(OBJECT_CLUSTER_HEAPHIT, MONITOR_CLUSTERSTR, clustertime
-				, heaphitrate, "heaphit rate");
-
-		/*get all coordinators' result then sum them*/
-		/*
-		* xact_commit, xact_rollback, numbackends, longquerynum, idlequerynum, preparednum
-		*/
-		for (iloop=0; iloop<6; iloop++)
-		{
-			iarray_commit_connect_longidle_prepare[iloop] = 0;
-		}
-		appendStringInfo(&sqlstr_commit_connect_longidle_prepare,"select (xact_commit/100.0)::bigint from pg_stat_database where datname = \'%s\' union all select (xact_rollback/100.0)::bigint from pg_stat_database where datname = \'%s\' union all select numbackends from pg_stat_database where datname = \'%s\' union all select count(*) from  pg_stat_activity where extract(epoch from (query_start-now())) > %d and datname=\'%s\' union all select count(*) from pg_stat_activity where state='idle' and datname = \'%s\' union all select count(*) from pg_prepared_xacts where database= \'%s\';", dbname, dbname, dbname, longtransmintime, dbname, dbname, dbname);
-		monitor_get_sum_all_onetypenode_onedb(rel_node, sqlstr_commit_connect_longidle_prepare.data, dbname, CNDN_TYPE_GTM_COOR_MASTER, iarray_commit_connect_longidle_prepare, 6);
 
 		/*xact_commit_rate on coordinator*/
-		commit = iarray_commit_connect_longidle_prepare[0];
-		rollback = iarray_commit_connect_longidle_prepare[1];
 		if((commit + rollback) == 0)
 			commitrate = 100;
 		else
 			commitrate = (commit*1.0/(commit + rollback))*100.0;
-		/*connect num*/
-		connectnum = iarray_commit_connect_longidle_prepare[2];
-		/*get long query num on coordinator*/
-		longquerynum = iarray_commit_connect_longidle_prepare[3];
-		idlequerynum = iarray_commit_connect_longidle_prepare[4];
-		/*prepare query num on coordinator*/
-		preparenum = iarray_commit_connect_longidle_prepare[5];
-
-
-		/*unused index on datanode master, get min
-		* " select count(*) from  pg_stat_user_indexes where idx_scan = 0"  on one database, get min on every dn master
-		*/
-		unusedindexnum = monitor_get_sqlres_all_typenode_usedbname(rel_node, sqlunusedindex
-				, dbname, CNDN_TYPE_DATANODE_MASTER, GET_MIN);
-
-		/*get locks on coordinator, get max*/
-		appendStringInfo(&sqllocksStrData, "select count(*) from pg_locks ,pg_database where pg_database.Oid = pg_locks.database and pg_database.datname=\'%s\';", dbname);
-		locksnum = monitor_all_typenode_usedbname_locksnum(rel_node, sqllocksStrData.data
-				, dbname, CNDN_TYPE_GTM_COOR_MASTER, GET_MAX);
 
 		/* check warning threshold */
 		clustertime = timestamptz_to_str(GetCurrentTimestamp());
+		mthreshold_levelvalue_impositiveseq(OBJECT_CLUSTER_HEAPHIT, MONITOR_CLUSTERSTR, clustertime
+				, heaphitrate, "heaphit rate");
 		mthreshold_levelvalue_impositiveseq(OBJECT_CLUSTER_COMMITRATE, MONITOR_CLUSTERSTR
 				, clustertime, commitrate, "commit rate");
 		mthreshold_levelvalue_positiveseq(OBJECT_CLUSTER_LONGTRANS, MONITOR_CLUSTERSTR, clustertime
@@ -353,46 +387,29 @@ Datum monitor_databaseitem_insert_data(PG_FUNCTION_ARGS)
 				, locksnum, "locks");
 		mthreshold_levelvalue_positiveseq(OBJECT_CLUSTER_UNUSEDINDEX, MONITOR_CLUSTERSTR, clustertime
 				, unusedindexnum, "unused index");
-		mthreshold_levelvalue_positiveseq(OBJECT_CLUSTER_LOCKS, MONITOR_CLUSTERSTR, clustertime
-				, locksnum, "locks");
-
-		/*autovacuum*/
-		if(bfrist)
-		{
-			/*these vars just need get one time, from coordinator*/
-			char *sqlstr_vacuum_archive_dbage = "select case when setting = \'on\' then 1 else 0 end from pg_settings where name=\'autovacuum\' union all select case when setting = \'on\' then 1 else 0 end from pg_settings where name=\'archive_mode\'";
-			int64 iarray_vacuum_archive_dbage[2] = {0,0};
-			monitor_get_sqlvalues_one_node(agentport, sqlstr_vacuum_archive_dbage, user, hostaddress, coordport,DEFAULT_DB, iarray_vacuum_archive_dbage, 2);
-
-			bautovacuum = (iarray_vacuum_archive_dbage[0] == 0 ? false:true);
-			barchive = (iarray_vacuum_archive_dbage[1] == 0 ? false:true);
-
-			/*standby delay*/
-			standbydelay = monitor_standbydelay(CNDN_TYPE_DATANODE_SLAVE);
-		}
-
-		/* get database transaction age on coordinator*/
-		appendStringInfo(&sqldbageStrData, "select age(datfrozenxid) from pg_database where datname=\'%s\';", dbname);
-		/*dbsize, unit MB*/
-		dbage = monitor_get_result_one_node(rel_node, sqldbageStrData.data, DEFAULT_DB, CNDN_TYPE_GTM_COOR_MASTER);
 
 		/*build tuple*/
 		tuple = monitor_build_database_item_tuple(rel, time, dbname, dbsize, barchive, bautovacuum, heaphitrate, commitrate, dbage, connectnum, standbydelay, locksnum, longquerynum, idlequerynum, preparenum, unusedindexnum, indexsize);
-		CatalogTupleInsert(rel, tuple);
+		tuplelist = lappend(tuplelist, tuple);
+		resetStringInfo(&sqldnStrData);
+		resetStringInfo(&sqlcoordStrData);
+	}
+
+	/*insert the tuples of all databases, open the indexes only once*/
+	indstate = CatalogOpenIndexes(rel);
+	foreach(cell, tuplelist)
+	{
+		tuple = (HeapTuple)lfirst(cell);
+		CatalogTupleInsertWithInfo(rel, tuple, indstate);
 		heap_freetuple(tuple);
-		resetStringInfo(&sqldbsizeStrData);
-		resetStringInfo(&sqldbageStrData);
-		resetStringInfo(&sqllocksStrData);
-		resetStringInfo(&sqlstr_heaphit_read_indexsize);
-		resetStringInfo(&sqlstr_commit_connect_longidle_prepare);
-		bfrist = false;
 	}
+	CatalogCloseIndexes(indstate);
+
 	pfree(user);
 	pfree(hostaddress);
-	pfree(sqldbsizeStrData.data);
-	pfree(sqllocksStrData.data);
-	pfree(sqlstr_heaphit_read_indexsize.data);
-	pfree(sqlstr_commit_connect_longidle_prepare.data);
+	pfree(sqldnStrData.data);
+	pfree(sqlcoordStrData.data);
+	list_free(tuplelist);
 	list_free(dbnamelist);
 	table_close(rel, RowExclusiveLock);
 	table_close(rel_node, RowExclusiveLock);
@@ -619,190 +636,199 @@ HeapTuple monitor_build_databasetps_qps_tuple(Relation rel, const TimestampTz ti
 
 	return heap_form_tuple(desc, datums, nulls);
 }
-/*get the sqlstr values from given sql on given typenode, then sum them
-* for example: we want to get caculate cmmitrate, which on coordinators, we need get sum
-* commit on all coordinators and sum rollback on all coordinators. the input parameters: len
-* is the num we want, iarray is the values restore.
-*/
-static void monitor_get_sum_all_onetypenode_onedb(Relation rel_node, char *sqlstr, char *dbname, char nodetype, int64 iarray[], int len)
+void monitor_get_stringvalues(char cmdtype, int agentport, char *sqlstr, char *user, char *address, int nodeport, char * dbname, StringInfo resultstrdata)
 {
-	/*get node user, port*/
-	TableScanDesc rel_scan = NULL;
-	ScanKeyData key[4];
-	HeapTuple tuple;
-	HeapTuple tup;
-	Form_mgr_node mgr_node;
-	Form_mgr_host mgr_host;
-	char *user = NULL;
-	char *address = NULL;
-	char *nodetime = NULL;
-	int port;
-	int agentport = 0;
-	int64 *iarraytmp;
-	int iloop = 0;
-	bool bfirst = true;
-
-	iarraytmp = (int64 *)palloc(sizeof(int64)*len);
-
-	PG_TRY();
-	{
-		ScanKeyInit(&key[0],
-			Anum_mgr_node_nodetype
-			,BTEqualStrategyNumber
-			,F_CHAREQ
-			,CharGetDatum(nodetype));
-		ScanKeyInit(&key[1]
-			,Anum_mgr_node_nodeinited
-			,BTEqualStrategyNumber
-			,F_BOOLEQ
-			,BoolGetDatum(true));
-		ScanKeyInit(&key[2]
-			,Anum_mgr_node_nodeincluster
-			,BTEqualStrategyNumber
-			,F_BOOLEQ
-			,BoolGetDatum(true));
-		ScanKeyInit(&key[3]
-			,Anum_mgr_node_nodezone
-			,BTEqualStrategyNumber
-			,F_NAMEEQ
-			,CStringGetDatum(mgr_zone));
-		rel_scan = table_beginscan_catalog(rel_node, 4, key);
-		while((tuple = heap_getnext(rel_scan, ForwardScanDirection)) != NULL)
-		{
-			mgr_node = (Form_mgr_node)GETSTRUCT(tuple);
-			Assert(mgr_node);
-			port = mgr_node->nodeport;
-			address = get_hostaddress_from_hostoid(mgr_node->nodehost);
-			if(bfirst)
-			{
-				user = get_hostuser_from_hostoid(mgr_node->nodehost);
-			}
-			bfirst = false;
-			memset(iarraytmp, 0, len*sizeof(int64));
-			/*get agent port*/
-			tup = SearchSysCache1(HOSTHOSTOID, ObjectIdGetDatum(mgr_node->nodehost));
-			if(!(HeapTupleIsValid(tup)))
-			{
-				ereport(ERROR, (errmsg("host oid \"%u\" not exist", mgr_node->nodehost)
-					, err_generic_string(PG_DIAG_TABLE_NAME, "mgr_host")
-					, errcode(ERRCODE_INTERNAL_ERROR)));
-			}
-			mgr_host = (Form_mgr_host)GETSTRUCT(tup);
-			Assert(mgr_host);
-			agentport = mgr_host->hostagentport;
-			ReleaseSysCache(tup);
-			monitor_get_sqlvalues_one_node(agentport, sqlstr, user, address, port,dbname, iarraytmp, len);
-			for(iloop=0; iloop<len; iloop++)
-			{
-				iarray[iloop] += iarraytmp[iloop];
-			}
+	MonitorNodeRequest req;
+	List *reqlist;
+
+	memset(&req, 0, sizeof(req));
+	req.user = user;
+	req.address = address;
+	req.agentport = agentport;
+	req.nodeport = nodeport;
+	req.dbname = dbname;
+	req.sqlstr = sqlstr;
+	req.result = resultstrdata;
+	reqlist = list_make1(&req);
+	monitor_get_stringvalues_nodes(cmdtype, reqlist);
+	list_free(reqlist);
+}
 
-			/* check warn threshold */
-			if ((nodetype == CNDN_TYPE_COORDINATOR_MASTER || nodetype == CNDN_TYPE_GTM_COOR_MASTER) && len == 6)
-			{
-				nodetime = monitor_get_timestamptz_onenode(agentport, user, address, port);
-				if(nodetime == NULL)
-				{
-					ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
-						,errmsg("get time from node error,")));
-				}
-				mthreshold_levelvalue_impositiveseq(OBJECT_NODE_COMMITRATE, address, nodetime
-					, iarraytmp[0]+iarraytmp[1] == 0 ? 100 : (iarraytmp[0]*1.0/(iarraytmp[0]+iarraytmp[1])*100.0)
-					,  "commit rate");
-				mthreshold_levelvalue_positiveseq(OBJECT_NODE_CONNECT, address, nodetime
-					, iarraytmp[2], "connect");
-				mthreshold_levelvalue_positiveseq(OBJECT_NODE_LONGTRANS, address, nodetime
-					, iarraytmp[3], "long transactions");
-				mthreshold_levelvalue_positiveseq(OBJECT_NODE_LONGTRANS, address, nodetime
-					, iarraytmp[4], "idle transactions");
-				pfree(nodetime);
-			}
-			else if (nodetype == CNDN_TYPE_DATANODE_MASTER && len == 3)
-			{
-				nodetime = monitor_get_timestamptz_onenode(agentport, user, address, port);
-				if(nodetime == NULL)
-				{
-					ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
-						,errmsg("get time from node error,")));
-				}
-				mthreshold_levelvalue_impositiveseq(OBJECT_NODE_HEAPHIT, address, nodetime
-					, iarraytmp[0]+iarraytmp[1] == 0 ? 100 : (iarraytmp[0]*1.0/(iarraytmp[0]+iarraytmp[1])*100.0)
-					,  "heaphit rate");
-				pfree(nodetime);
-			}
+/*
+* send the sql of every request to its agent first, then read the results, so the
+* agents run the sqls at the same time and the cost is the slowest node, not the sum
+* of all nodes. the request which cannot connect to its agent gets an empty result.
+*/
+void monitor_get_stringvalues_nodes(char cmdtype, List *reqlist)
+{
+	MonitorNodeRequest *req;
+	ListCell *lc;
 
-			pfree(address);
-		}
-	}PG_CATCH();
+	foreach(lc, reqlist)
 	{
-		if(user)
-			pfree(user);
-		if (rel_scan)
-			heap_endscan(rel_scan);
-		pfree(iarraytmp);
-
-		PG_RE_THROW();
-	}PG_END_TRY();
+		req = (MonitorNodeRequest *)lfirst(lc);
+		resetStringInfo(req->result);
+		monitor_send_stringvalues(cmdtype, req);
+	}
 
-	if(user)
+	foreach(lc, reqlist)
 	{
-		pfree(user);
+		req = (MonitorNodeRequest *)lfirst(lc);
+		if (req->ma == NULL)
+			continue;
+		/*check the receive msg*/
+		mgr_recv_sql_stringvalues_msg(req->ma, req->result);
+		ma_close(req->ma);
+		req->ma = NULL;
 	}
-	heap_endscan(rel_scan);
-	pfree(iarraytmp);
 }
 
-void monitor_get_stringvalues(char cmdtype, int agentport, char *sqlstr, char *user, char *address, int nodeport, char * dbname, StringInfo resultstrdata)
+static void monitor_send_stringvalues(char cmdtype, MonitorNodeRequest *req)
 {
-	ManagerAgent *ma;
 	StringInfoData sendstrmsg;
 	StringInfoData buf;
 
-	resetStringInfo(resultstrdata);
 	initStringInfo(&sendstrmsg);
 	/*sequence:user port dbname sqlstr, delimiter by '\0'*/
 	/*user*/
-	appendStringInfoString(&sendstrmsg, user);
+	appendStringInfoString(&sendstrmsg, req->user);
 	appendStringInfoCharMacro(&sendstrmsg, '\0');
 	/*port*/
-	appendStringInfo(&sendstrmsg, "%d", nodeport);
+	appendStringInfo(&sendstrmsg, "%d", req->nodeport);
 	appendStringInfoCharMacro(&sendstrmsg, '\0');
 	/*dbname*/
-	appendStringInfoString(&sendstrmsg, dbname);
+	appendStringInfoString(&sendstrmsg, req->dbname);
 	appendStringInfoCharMacro(&sendstrmsg, '\0');
 	/*sqlstring*/
-	appendStringInfoString(&sendstrmsg, sqlstr);
+	appendStringInfoString(&sendstrmsg, req->sqlstr);
 	appendStringInfoCharMacro(&sendstrmsg, '\0');
-	ma = ma_connect(address, (unsigned short)agentport);
-	if(!ma_isconnected(ma))
+	req->ma = ma_connect(req->address, (unsigned short)req->agentport);
+	if(!ma_isconnected(req->ma))
 	{
 		/*report error message */
 		ereport(WARNING, (errcode(ERRCODE_CONNECTION_EXCEPTION)
-			,errmsg("%s", ma_last_error_msg(ma))));
-		ma_close(ma);
+			,errmsg("%s", ma_last_error_msg(req->ma))));
+		ma_close(req->ma);
+		req->ma = NULL;
+		pfree(sendstrmsg.data);
 		return;
 	}
 	ma_beginmessage(&buf, AGT_MSG_COMMAND);
 	ma_sendbyte(&buf, cmdtype);
 	mgr_append_infostr_infostr(&buf, &sendstrmsg);
 	pfree(sendstrmsg.data);
-	ma_endmessage(&buf, ma);
-	if (! ma_flush(ma, true))
+	ma_endmessage(&buf, req->ma);
+	if (! ma_flush(req->ma, true))
 	{
 		ereport(WARNING, (errcode(ERRCODE_CONNECTION_EXCEPTION)
-			,errmsg("%s", ma_last_error_msg(ma))));
-		ma_close(ma);
-		return;
+			,errmsg("%s", ma_last_error_msg(req->ma))));
+		ma_close(req->ma);
+		req->ma = NULL;
+	}
+}
+
+/*
+* make one request for every given type node which is inited and in cluster, append them
+* to reqlist. sqlstr and dbname are not copied, keep them until the requests are freed.
+*/
+List *monitor_get_node_requests(Relation rel_node, char nodetype, char *sqlstr, char *dbname, List *reqlist)
+{
+	TableScanDesc rel_scan;
+	ScanKeyData key[4];
+	HeapTuple tuple;
+	HeapTuple tup;
+	Form_mgr_node mgr_node;
+	Form_mgr_host mgr_host;
+	MonitorNodeRequest *req;
+
+	ScanKeyInit(&key[0],
+		Anum_mgr_node_nodetype
+		,BTEqualStrategyNumber
+		,F_CHAREQ
+		,CharGetDatum(nodetype));
+	ScanKeyInit(&key[1]
+		,Anum_mgr_node_nodeinited
+		,BTEqualStrategyNumber
+		,F_BOOLEQ
+		,BoolGetDatum(true));
+	ScanKeyInit(&key[2]
+		,Anum_mgr_node_nodeincluster
+		,BTEqualStrategyNumber
+		,F_BOOLEQ
+		,BoolGetDatum(true));
+	ScanKeyInit(&key[3]
+		,Anum_mgr_node_nodezone
+		,BTEqualStrategyNumber
+		,F_NAMEEQ
+		,CStringGetDatum(mgr_zone));
+	rel_scan = table_beginscan_catalog(rel_node, 4, key);
+	while((tuple = heap_getnext(rel_scan, ForwardScanDirection)) != NULL)
+	{
+		mgr_node = (Form_mgr_node)GETSTRUCT(tuple);
+		Assert(mgr_node);
+		/*get agent port*/
+		tup = SearchSysCache1(HOSTHOSTOID, ObjectIdGetDatum(mgr_node->nodehost));
+		if(!(HeapTupleIsValid(tup)))
+		{
+			heap_endscan(rel_scan);
+			ereport(ERROR, (errmsg("host oid \"%u\" not exist", mgr_node->nodehost)
+				, err_generic_string(PG_DIAG_TABLE_NAME, "mgr_host")
+				, errcode(ERRCODE_INTERNAL_ERROR)));
+		}
+		mgr_host = (Form_mgr_host)GETSTRUCT(tup);
+		Assert(mgr_host);
+		req = (MonitorNodeRequest *)palloc0(sizeof(MonitorNodeRequest));
+		req->nodetype = nodetype;
+		req->agentport = mgr_host->hostagentport;
+		ReleaseSysCache(tup);
+		req->user = get_hostuser_from_hostoid(mgr_node->nodehost);
+		req->address = get_hostaddress_from_hostoid(mgr_node->nodehost);
+		req->nodeport = mgr_node->nodeport;
+		req->dbname = dbname;
+		req->sqlstr = sqlstr;
+		req->result = makeStringInfo();
+		reqlist = lappend(reqlist, req);
 	}
-	/*check the receive msg*/
-	mgr_recv_sql_stringvalues_msg(ma, resultstrdata);
-	ma_close(ma);
-	if (resultstrdata->data == NULL)
+	heap_endscan(rel_scan);
+
+	return reqlist;
+}
+
+void monitor_free_node_requests(List *reqlist)
+{
+	MonitorNodeRequest *req;
+	ListCell *lc;
+
+	foreach(lc, reqlist)
 	{
-		ereport(WARNING, (errcode(ERRCODE_DATA_EXCEPTION)
-			,errmsg("get sqlstr:%s \n\tresult fail", sqlstr)));
-		return;
+		req = (MonitorNodeRequest *)lfirst(lc);
+		Assert(req->ma == NULL);
+		pfree(req->user);
+		pfree(req->address);
+		pfree(req->result->data);
+		pfree(req->result);
+		pfree(req);
 	}
+	list_free(reqlist);
+}
+
+/*
+* split the result of the request which delimiter by '\0' to values, at most len values,
+* return the number of values got
+*/
+int monitor_get_request_values(MonitorNodeRequest *req, char *values[], int len)
+{
+	char *pstr = req->result->data;
+	char *pend = req->result->data + req->result->len;
+	int num = 0;
+
+	while(pstr < pend && num < len)
+	{
+		values[num++] = pstr;
+		pstr = pstr + strlen(pstr) + 1;
+	}
+
+	return num;
 }
 
 /*
@@ -924,100 +950,3 @@ static int64 monitor_standbydelay(char nodetype)
 
 	return maxdelay;
 }
-
-static int64 monitor_all_typenode_usedbname_locksnum(Relation rel_node, char *sqlstr, char *dbname, char nodetype, int gettype)
-{
-	/*get datanode master user, port*/
-	TableScanDesc rel_scan;
-	ScanKeyData key[4];
-	HeapTuple tuple;
-	HeapTuple tup;
-	Form_mgr_node mgr_node;
-	Form_mgr_host mgr_host;
-	char *user;
-	char *address;
-	char *nodetime;
-	int port;
-	int64 result = 0;
-	int64 resulttmp = 0;
-	int agentport;
-	bool bfirst = true;
-
-	ScanKeyInit(&key[0],
-		Anum_mgr_node_nodetype
-		,BTEqualStrategyNumber
-		,F_CHAREQ
-		,CharGetDatum(nodetype));
-	ScanKeyInit(&key[1]
-		,Anum_mgr_node_nodeinited
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-	ScanKeyInit(&key[2]
-		,Anum_mgr_node_nodeincluster
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-	ScanKeyInit(&key[3]
-		,Anum_mgr_node_nodezone
-		,BTEqualStrategyNumber
-		,F_NAMEEQ
-		,CStringGetDatum(mgr_zone));
-	rel_scan = table_beginscan_catalog(rel_node, 4, key);
-	while((tuple = heap_getnext(rel_scan, ForwardScanDirection)) != NULL)
-	{
-		mgr_node = (Form_mgr_node)GETSTRUCT(tuple);
-		Assert(mgr_node);
-		port = mgr_node->nodeport;
-		address = get_hostaddress_from_hostoid(mgr_node->nodehost);
-		user = get_hostuser_from_hostoid(mgr_node->nodehost);
-		/*get agent port*/
-		tup = SearchSysCache1(HOSTHOSTOID, ObjectIdGetDatum(mgr_node->nodehost));
-		if(!(HeapTupleIsValid(tup)))
-		{
-			heap_endscan(rel_scan);
-			ereport(ERROR, (errmsg("host oid \"%u\" not exist", mgr_node->nodehost)
-				, err_generic_string(PG_DIAG_TABLE_NAME, "mgr_host")
-				, errcode(ERRCODE_INTERNAL_ERROR)));
-		}
-		mgr_host = (Form_mgr_host)GETSTRUCT(tup);
-		Assert(mgr_host);
-		agentport = mgr_host->hostagentport;
-		ReleaseSysCache(tup);
-		resulttmp = monitor_get_onesqlvalue_one_node(agentport, sqlstr, user, address, port, dbname);
-
-		/* check warning threshold */
-		nodetime = monitor_get_timestamptz_onenode(agentport, user, address, port);
-		if(nodetime == NULL)
-		{
-			heap_endscan(rel_scan);
-			ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
-				,errmsg("get time from node error,")));
-		}
-		mthreshold_levelvalue_positiveseq(OBJECT_NODE_LOCKS, address, nodetime, resulttmp, "locks");
-		pfree(nodetime);
-
-		if(bfirst && gettype==GET_MIN) result = resulttmp;
-		bfirst = false;
-		switch(gettype)
-		{
-			case GET_MIN:
-				if(resulttmp < result) result = resulttmp;
-				break;
-			case GET_MAX:
-				if(resulttmp>result) result = resulttmp;
-				break;
-			case GET_SUM:
-				result = result + resulttmp;
-				break;
-			default:
-				result = 0;
-				break;
-		};
-		pfree(user);
-		pfree(address);
-	}
-	heap_endscan(rel_scan);
-
-	return result;
-}
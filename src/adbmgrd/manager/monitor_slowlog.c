@@ -62,7 +62,8 @@ char *monitor_get_onestrvalue_one_node(int agentport, char *sqlstr, char *user,
 
 
 /*
-* get GETMAXROWNUM rows from pg_stat_statements on everyone coordinator using given sql. using follow method to judge which need
+* the rows get from pg_stat_statements on one coordinator for all databases by the sql which
+* monitor_slowlog_insert_data makes, using follow method to judge which need
 * insert into monitor_slowlog table: 1. judge the query exist in yesterday records or not. if not in yesterday records
 *	or the calls does not equal yesterday's calls on same query, just insert into monitor_slowlog table; if the calls
 *	equals yesterday's calls on same query, ignore the query.
@@ -72,95 +73,60 @@ char *monitor_get_onestrvalue_one_node(int agentport, char *sqlstr, char *user,
 *
 */
 
-void monitor_get_onedb_slowdata_insert(Relation rel, int agentport, char *user, char *address, int port, char *dbname)
+void monitor_get_node_slowdata_insert(Relation rel, MonitorNodeRequest *req, TimestampTz time)
 {
-	StringInfoData sqlslowlogStrData;
-	StringInfoData resultstrdata;
-	StringInfoData querystr;
-	char strtmp[64];
-	char *connectdbname = "postgres";
-	char dbuser[64];
+	char *values[5];
+	char *dbname;
+	char *dbuser;
+	char *querystr;
 	char *pstr = NULL;
+	char *pend = NULL;
 	int calls = 0;
-	TimestampTz time;
+	int num = 0;
 	float totaltime = 0;
 	float singletime = 0;
 	HeapTuple tupleret = NULL;
 	int callstoday = 0;
 	int callsyestd = 0;
 	int callstmp = 0;
-	int slowlogmintime = 2;
-	int slowlognumoncetime = 5;
-	int iloop = 0;
 	bool gettoday = false;
 	bool getyesdt = false;
 
 	Form_monitor_slowlog monitor_slowlog;
 	pg_time_t ptimenow;
-	Monitor_Threshold monitor_threshold;
 
-	initStringInfo(&sqlslowlogStrData);
-	/*get slowlog min time threshold in MonitorHostThresholdRelationId*/
-	get_threshold(SLOWQUERY_MINTIME, &monitor_threshold);
-	if (monitor_threshold.threshold_warning != 0)
-		slowlogmintime = monitor_threshold.threshold_warning;
-	get_threshold(SLOWLOG_GETNUMONCE, &monitor_threshold);
-	if (monitor_threshold.threshold_warning != 0)
-		slowlognumoncetime = monitor_threshold.threshold_warning;
-	appendStringInfo(&sqlslowlogStrData, "select usename, calls, total_time/1000 as totaltime, query  from pg_stat_statements, pg_user, pg_database where ( total_time/calls/1000) > %d and userid=usesysid and pg_database.oid = dbid and datname=\'%s\' limit %d;", slowlogmintime, dbname, slowlognumoncetime);
-	time = GetCurrentTimestamp();
 	ptimenow = timestamptz_to_time_t(time);
-
-	initStringInfo(&resultstrdata);
-	monitor_get_stringvalues(AGT_CMD_GET_SQL_STRINGVALUES, agentport, sqlslowlogStrData.data, user, address, port, connectdbname, &resultstrdata);
-	if (resultstrdata.len == 0)
-	{
-		pfree(resultstrdata.data);
-		return;
-	}
-	initStringInfo(&querystr);
-	pstr = resultstrdata.data;
-	strtmp[63] = '\0';
-	while(*pstr != '\0' && iloop < slowlognumoncetime)
+	pstr = req->result->data;
+	pend = req->result->data + req->result->len;
+	while(pstr < pend && *pstr != '\0')
 	{
 		callstoday = 0;
 		callsyestd = 0;
 		gettoday = false;
 		getyesdt = false;
-		iloop++;
-		/*get username*/
-		strncpy(dbuser, pstr, 63);
-		dbuser[strlen(dbuser)] = 0;
-		pstr = pstr + strlen(dbuser) + 1;
-		/*get run time*/
-		if (!pstr)
-			ereport(ERROR, (errmsg("get calls from slow log fail")));
-		strncpy(strtmp, pstr, 63);
-		calls = atoi(strtmp);
-		pstr = pstr + strlen(strtmp) + 1;
-		/*get total used time*/
-		if (!pstr)
-			ereport(ERROR, (errmsg("get totaltime from slow log fail")));
-		strncpy(strtmp, pstr, 63);
-		totaltime = atof(strtmp);
-		singletime = totaltime/calls;
-		pstr = pstr + strlen(strtmp) + 1;
-		/*get query string*/
-		if (!pstr)
+		/*datname, usename, calls, totaltime, query*/
+		for (num=0; num<5 && pstr<pend; num++)
+		{
+			values[num] = pstr;
+			pstr = pstr + strlen(pstr) + 1;
+		}
+		if (num < 5)
 			ereport(ERROR, (errmsg("get querystr from slow log fail")));
-		resetStringInfo(&querystr);
-		appendStringInfo(&querystr, "%s", pstr);
-		querystr.data[querystr.len] = 0;
-		pstr = pstr + querystr.len + 1;
+		dbname = values[0];
+		dbuser = values[1];
+		calls = atoi(values[2]);
+		totaltime = atof(values[3]);
+		singletime = totaltime/calls;
+		querystr = values[4];
 		/*
 		* just make all reoords which get from coordinato pg_stat_statements as today's data
 		*/
-		tupleret = check_record_yestoday_today(rel, &callstoday, &callsyestd, &gettoday, &getyesdt, querystr.data, dbuser, dbname, ptimenow);
+		tupleret = check_record_yestoday_today(rel, &callstoday, &callsyestd, &gettoday, &getyesdt, querystr, dbuser, dbname, ptimenow);
 
 		if (false  == gettoday && false == getyesdt)
 		{
 			/*insert record*/
-			monitor_insert_record(rel, agentport, time, dbname, dbuser, singletime, calls, querystr.data, user, address, port);
+			monitor_insert_record(rel, req->agentport, time, dbname, dbuser, singletime, calls, querystr, req->user, req->address, req->nodeport);
 		}
 		else if (true  == gettoday && false == getyesdt)
 		{
@@ -195,7 +161,7 @@ void monitor_get_onedb_slowdata_insert(Relation rel, int agentport, char *user,
 			if (calls != callsyestd)
 			{
 				/*insert the record*/
-				monitor_insert_record(rel, agentport, time, dbname, dbuser, singletime, callstmp, querystr.data, user, address, port);
+				monitor_insert_record(rel, req->agentport, time, dbname, dbuser, singletime, callstmp, querystr, req->user, req->address, req->nodeport);
 			}
 		}
 		else /*true  == gettoday && true == getyesdt*/
@@ -232,104 +198,80 @@ void monitor_get_onedb_slowdata_insert(Relation rel, int agentport, char *user,
 		}
 
 	}
-
-	pfree(resultstrdata.data);
-	pfree(querystr.data);
 }
 
 /*
-* get all database slowlog,then insert them to MslowlogRelationId
+* get all database slowlog,then insert them to MslowlogRelationId. every coordinator gets the
+* slowlog of all databases in one sql, and the sqls run on all coordinators at the same time.
 */
 Datum monitor_slowlog_insert_data(PG_FUNCTION_ARGS)
 {
-	int coordport;
-	int agentport = 0;
-	char *address = NULL;
-	char *user = NULL;
-	char *dbname = NULL;
+	char *connectdbname = "postgres";
 	Relation rel_node;
 	Relation rel_slowlog;
 	List *dbnamelist = NIL;
+	List *reqlist = NIL;
 	ListCell *cell;
-	bool haveget = false;
-	TableScanDesc rel_scan;
-	ScanKeyData key[4];
-	Form_mgr_node mgr_node;
-	Form_mgr_host mgr_host;
-	HeapTuple tuple;
-	HeapTuple tup;
+	ListCell *lc;
+	MonitorNodeRequest *req;
+	StringInfoData sqlslowlogStrData;
+	TimestampTz time;
+	int slowlogmintime = 2;
+	int slowlognumoncetime = 5;
+	Monitor_Threshold monitor_threshold;
 
 	rel_slowlog = table_open(MslowlogRelationId, RowExclusiveLock);
 	rel_node = table_open(NodeRelationId, RowExclusiveLock);
-	ScanKeyInit(&key[0],
-		Anum_mgr_node_nodetype
-		,BTEqualStrategyNumber
-		,F_CHAREQ
-		,CharGetDatum(CNDN_TYPE_COORDINATOR_MASTER));
-	ScanKeyInit(&key[1]
-		,Anum_mgr_node_nodeinited
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-	ScanKeyInit(&key[2]
-		,Anum_mgr_node_nodezone
-		,BTEqualStrategyNumber
-		,F_NAMEEQ
-		,CStringGetDatum(mgr_zone));
-	ScanKeyInit(&key[3]
-		,Anum_mgr_node_nodeincluster
-		,BTEqualStrategyNumber
-		,F_BOOLEQ
-		,BoolGetDatum(true));
-
-	rel_scan = table_beginscan_catalog(rel_node, 4, key);
-	while((tuple = heap_getnext(rel_scan, ForwardScanDirection)) != NULL)
+	reqlist = monitor_get_node_requests(rel_node, CNDN_TYPE_COORDINATOR_MASTER, NULL, connectdbname, NIL);
+	if (reqlist == NIL)
 	{
-		mgr_node = (Form_mgr_node)GETSTRUCT(tuple);
-		Assert(mgr_node);
-		if (! mgr_node->nodeincluster)
-			continue;
-		/*get user, address, coordport*/
-		coordport = mgr_node->nodeport;
-		address = get_hostaddress_from_hostoid(mgr_node->nodehost);
-		/*get agent port*/
-		tup = SearchSysCache1(HOSTHOSTOID, ObjectIdGetDatum(mgr_node->nodehost));
-		if(!(HeapTupleIsValid(tup)))
-		{
-			ereport(ERROR, (errmsg("host oid \"%u\" not exist", mgr_node->nodehost)
-				, err_generic_string(PG_DIAG_TABLE_NAME, "mgr_host")
-				, errcode(ERRCODE_INTERNAL_ERROR)));
-		}
-		mgr_host = (Form_mgr_host)GETSTRUCT(tup);
-		Assert(mgr_host);
-		agentport = mgr_host->hostagentport;
-		ReleaseSysCache(tup);
-		if(!haveget)
-		{
-			user = get_hostuser_from_hostoid(mgr_node->nodehost);
-			/*get database name list*/
-			dbnamelist = monitor_get_dbname_list(user, address, coordport);
-			if(dbnamelist == NULL)
-			{
-				ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
-					,errmsg("get database namelist error")));
-			}
-		}
-		Assert(address != NULL);
-		Assert(user != NULL);
-		haveget = true;
-		foreach(cell, dbnamelist)
-		{
-			dbname = (char *)(lfirst(cell));
-			monitor_get_onedb_slowdata_insert(rel_slowlog, agentport, user, address, coordport, dbname);
-		}
-		pfree(address);
+		table_close(rel_slowlog, RowExclusiveLock);
+		table_close(rel_node, RowExclusiveLock);
+		PG_RETURN_TEXT_P(cstring_to_text("insert_data"));
 	}
-	heap_endscan(rel_scan);
-	if (dbnamelist)
-		list_free(dbnamelist);
-	if(user)
-		pfree(user);
+
+	/*get database name list*/
+	req = (MonitorNodeRequest *)linitial(reqlist);
+	dbnamelist = monitor_get_dbname_list(req->user, req->address, req->nodeport);
+	if(dbnamelist == NULL)
+	{
+		ereport(ERROR, (errcode(ERRCODE_DATA_EXCEPTION)
+			,errmsg("get database namelist error")));
+	}
+
+	/*get slowlog min time threshold in MonitorHostThresholdRelationId*/
+	get_threshold(SLOWQUERY_MINTIME, &monitor_threshold);
+	if (monitor_threshold.threshold_warning != 0)
+		slowlogmintime = monitor_threshold.threshold_warning;
+	get_threshold(SLOWLOG_GETNUMONCE, &monitor_threshold);
+	if (monitor_threshold.threshold_warning != 0)
+		slowlognumoncetime = monitor_threshold.threshold_warning;
+
+	/*at most slowlognumoncetime rows for every database*/
+	initStringInfo(&sqlslowlogStrData);
+	appendStringInfo(&sqlslowlogStrData, "select datname, usename, calls, totaltime, query from (select datname, usename, calls, total_time/1000 as totaltime, query, row_number() over (partition by datname) as rownum from pg_stat_statements, pg_user, pg_database where ( total_time/calls/1000) > %d and userid=usesysid and pg_database.oid = dbid and datname in (", slowlogmintime);
+	foreach(cell, dbnamelist)
+	{
+		appendStringInfo(&sqlslowlogStrData, "%s\'%s\'", cell == list_head(dbnamelist) ? "" : ",", (char *)(lfirst(cell)));
+	}
+	appendStringInfo(&sqlslowlogStrData, ")) as slowlog where rownum <= %d;", slowlognumoncetime);
+	foreach(lc, reqlist)
+	{
+		req = (MonitorNodeRequest *)lfirst(lc);
+		req->sqlstr = sqlslowlogStrData.data;
+	}
+
+	time = GetCurrentTimestamp();
+	monitor_get_stringvalues_nodes(AGT_CMD_GET_SQL_STRINGVALUES, reqlist);
+	foreach(lc, reqlist)
+	{
+		req = (MonitorNodeRequest *)lfirst(lc);
+		monitor_get_node_slowdata_insert(rel_slowlog, req, time);
+	}
+
+	monitor_free_node_requests(reqlist);
+	pfree(sqlslowlogStrData.data);
+	list_free(dbnamelist);
 	table_close(rel_slowlog, RowExclusiveLock);
 	table_close(rel_node, RowExclusiveLock);
 	PG_RETURN_TEXT_P(cstring_to_text("insert_data"));
@@ -364,6 +364,10 @@ heapgetpage(TableScanDesc sscan, BlockNumber page)
 	OffsetNumber lineoff;
 	ItemId		lpp;
 	bool		all_visible;
+#ifdef ADB
+	struct ExpansionClean *clean;
+	bool		page_clean;
+#endif
 
 	Assert(page < scan->rs_nblocks);
 
@@ -430,6 +434,14 @@ heapgetpage(TableScanDesc sscan, BlockNumber page)
 	 * tuple for visibility the hard way.
 	 */
 	all_visible = PageIsAllVisible(dp) && !snapshot->takenDuringRecovery;
+#ifdef ADB
+	clean = scan->rs_base.rs_rd->rd_clean;
+	if (unlikely(clean) &&
+		NeedTestExpansionCleanBlock(clean, page) == false)
+		clean = NULL;
+	/* all tuples must be tested before marking page clean */
+	page_clean = all_visible;
+#endif
 
 	for (lineoff = FirstOffsetNumber, lpp = PageGetItemId(dp, lineoff);
 		 lineoff <= lines;
@@ -450,8 +462,11 @@ heapgetpage(TableScanDesc sscan, BlockNumber page)
 			else
 				valid = HeapTupleSatisfiesVisibility(&loctup, snapshot, buffer);
 #ifdef ADB
-			if (valid && unlikely(scan->rs_base.rs_rd->rd_clean))
-				valid = ExecTestExpansionClean(scan->rs_base.rs_rd->rd_clean, &loctup);
+			if (valid && unlikely(clean))
+			{
+				valid = ExecTestExpansionClean(clean, &loctup);
+				page_clean = page_clean && valid;
+			}
 #endif
 
 			HeapCheckForSerializableConflictOut(valid, scan->rs_base.rs_rd,
@@ -464,6 +479,11 @@ heapgetpage(TableScanDesc sscan, BlockNumber page)
 
 	LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
 
+#ifdef ADB
+	if (unlikely(clean) && page_clean)
+		MarkExpansionCleanBlock(clean, page);
+#endif
+
 	Assert(ntup <= MaxHeapTuplesPerPage);
 	scan->rs_ntuples = ntup;
 }
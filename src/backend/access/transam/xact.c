@@ -71,6 +71,7 @@
 #ifdef ADB
 #include "agtm/agtm.h"
 #include "executor/clusterReceiver.h"
+#include "executor/execProfile.h"
 #include "libpq/libpq.h"
 #include "libpq/pqformat.h"
 #include "lib/stringinfo.h"
@@ -237,6 +238,7 @@ typedef struct TransactionStateData
 	XactPhase			xact_phase;					/* mark which phase the current xact in */
 	InterXactState		interXactState;				/* inter transaction state if TopTransaction */
 	TransactionId		cva_xid;					/* cluster vacuum analyze xid*/
+	int					prevExecProfileDepth;		/* entry-time ExecProfileDepth */
 #endif
 } TransactionStateData;
 
@@ -2568,7 +2570,8 @@ CommitTransaction(void)
 	bool		is_parallel_worker;
 #ifdef ADB
 	bool		use_2pc_commit = true;
-	Oid			generated_tx_node = InvalidOid;
+	Oid		   *one_phase_nodes = NULL;
+	int			one_phase_count = 0;
 	isNeedAbortAnyTrans = true;
 #endif /* ADB */
 
@@ -2620,33 +2623,31 @@ CommitTransaction(void)
 		int other_node_trans_count;
 		oids = InterXactBeginNodes(s->interXactState, false, &other_node_trans_count);
 		if (other_node_trans_count == 0 || /* no other node generated transaction */
-			(coordCommandIdUsed == false && /* or only one node generated transaction */
-			 other_node_trans_count == 1))  /*    and this coordinator not generated transaction */
+			(coordCommandIdUsed == false && /* or this coordinator not generated transaction */
+			 InterXactWriteNodeCount(s->interXactState) <= 1))  /* and at most one node modified */
 		{
+			/*
+			 * Nodes only read by the transaction have nothing to keep
+			 * atomic with the single writer, so all of them can commit
+			 * in one phase, without prepare and remote xact log.
+			 */
 			use_2pc_commit = false;
-			if (other_node_trans_count == 0)
-			{
-				generated_tx_node = InvalidOid;
-			}else
-			{
-				Assert(other_node_trans_count == 1);
-				generated_tx_node = oids[0];
-				Assert(OidIsValid(generated_tx_node));
-			}
+			one_phase_nodes = oids;
+			one_phase_count = other_node_trans_count;
 		}
 	}
 
 	if (use_2pc_commit)
 	{
 		StartCommitRemoteXact(s);
-	}else if(OidIsValid(generated_tx_node))
+	}else if(one_phase_count > 0)
 	{
-		InterXactSendCommit(NULL, &generated_tx_node, 1, false, false);
+		InterXactSendCommit(NULL, one_phase_nodes, one_phase_count, false, false);
 		/*
 		 * remote node maybe report relation's stat
 		 * so we must recv message before local commit
 		 */
-		InterXactRecvCommit(NULL, &generated_tx_node, 1, false, false);
+		InterXactRecvCommit(NULL, one_phase_nodes, one_phase_count, false, false);
 	}
 #endif
 
@@ -3446,6 +3447,9 @@ AbortTransaction(void)
 	AtAbort_Notify();
 	AtEOXact_RelationMap(false, is_parallel_worker);
 	AtAbort_Twophase();
+#ifdef ADB
+	AtAbort_ExecProfile();
+#endif /* ADB */
 
 	/*
 	 * Advertise the fact that we aborted in pg_xact (assuming that we got as
@@ -5789,6 +5793,10 @@ AbortSubTransaction(void)
 	 * AbortTransaction.)
 	 */
 	SetUserIdAndSecContext(s->prevUser, s->prevSecContext);
+#ifdef ADB
+	/* forget the plan nodes we longjmp'd out of */
+	ExecProfileDepth = s->prevExecProfileDepth;
+#endif /* ADB */
 
 	/* Forget about any active REINDEX. */
 	ResetReindexState(s->nestingLevel);
@@ -5946,6 +5954,9 @@ PushTransaction(void)
 	GetUserIdAndSecContext(&s->prevUser, &s->prevSecContext);
 	s->prevXactReadOnly = XactReadOnly;
 	s->parallelModeLevel = 0;
+#ifdef ADB
+	s->prevExecProfileDepth = ExecProfileDepth;
+#endif /* ADB */
 
 	CurrentTransactionState = s;
 
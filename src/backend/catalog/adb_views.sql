@@ -55,3 +55,148 @@ CREATE VIEW pg_catalog.pg_aux_tables AS
          LEFT JOIN pg_namespace N ON (N.oid = C.relnamespace)
          LEFT JOIN pg_tablespace T ON (T.oid = C.reltablespace)
     WHERE C.relkind = 'r';
+
+CREATE VIEW pg_catalog.adb_cluster_stat_activity AS
+    SELECT
+            S.node_oid,
+            S.node_name,
+            S.datid AS datid,
+            D.datname AS datname,
+            S.pid,
+            S.leader_pid,
+            S.usesysid,
+            U.rolname AS usename,
+            S.application_name,
+            S.client_addr,
+            S.client_hostname,
+            S.client_port,
+            S.backend_start,
+            S.xact_start,
+            S.query_start,
+            S.state_change,
+            S.wait_event_type,
+            S.wait_event,
+            S.state,
+            S.backend_xid,
+            S.backend_xmin,
+            S.query,
+            S.backend_type
+    FROM pg_catalog.adb_cluster_function('pg_catalog.pg_stat_get_activity(integer)', '{NULL}')
+        AS S(node_oid oid, node_name name, datid oid, pid int4, usesysid oid,
+             application_name text, state text, query text, wait_event_type text,
+             wait_event text, xact_start timestamptz, query_start timestamptz,
+             backend_start timestamptz, state_change timestamptz, client_addr inet,
+             client_hostname text, client_port int4, backend_xid xid, backend_xmin xid,
+             backend_type text, ssl bool, sslversion text, sslcipher text, sslbits int4,
+             sslcompression bool, ssl_client_dn text, ssl_client_serial numeric,
+             ssl_issuer_dn text, gss_auth bool, gss_princ text, gss_enc bool,
+             leader_pid int4)
+        LEFT JOIN pg_database AS D ON (S.datid = D.oid)
+        LEFT JOIN pg_authid AS U ON (S.usesysid = U.oid);
+
+CREATE VIEW pg_catalog.adb_cluster_locks AS
+    SELECT * FROM pg_catalog.adb_cluster_function('pg_catalog.pg_lock_status()', NULL)
+        AS L(node_oid oid, node_name name, locktype text, database oid, relation oid,
+             page int4, tuple int2, virtualxid text, transactionid xid, classid oid,
+             objid oid, objsubid int2, virtualtransaction text, pid int4, mode text,
+             granted bool, fastpath bool);
+
+CREATE VIEW pg_catalog.adb_stat_database_wait AS
+    SELECT
+            D.oid AS datid,
+            D.datname AS datname,
+            pg_stat_get_db_remote_wait_time(D.oid) AS remote_wait_time,
+            pg_stat_get_db_reduce_wait_time(D.oid) AS reduce_wait_time,
+            pg_stat_get_db_gtm_wait_time(D.oid) AS gtm_wait_time
+    FROM pg_database D;
+
+CREATE VIEW pg_catalog.adb_stat_activity_wait AS
+    SELECT
+            pg_stat_get_backend_pid(S.backendid) AS pid,
+            pg_stat_get_backend_dbid(S.backendid) AS datid,
+            pg_stat_get_backend_wait_event_type(S.backendid) AS wait_event_type,
+            pg_stat_get_backend_wait_event(S.backendid) AS wait_event,
+            pg_stat_get_backend_remote_wait_time(S.backendid) AS remote_wait_time,
+            pg_stat_get_backend_reduce_wait_time(S.backendid) AS reduce_wait_time,
+            pg_stat_get_backend_gtm_wait_time(S.backendid) AS gtm_wait_time
+    FROM (SELECT pg_stat_get_backend_idset() AS backendid) AS S;
+
+CREATE OR REPLACE FUNCTION pg_catalog.pg_query_profile(
+        pid int4, samples int4 DEFAULT 100, interval_ms int4 DEFAULT 10,
+        OUT pid int4, OUT kind text, OUT plan_node_id int4, OUT name text,
+        OUT self_samples int8, OUT total_samples int8, OUT self_time_ms float8)
+  RETURNS SETOF record STRICT VOLATILE LANGUAGE internal AS 'pg_query_profile'
+  PARALLEL RESTRICTED CLUSTER RESTRICTED;
+
+/*
+ * Sample a coordinator backend and every backend running its cluster plans,
+ * on all nodes at once.
+ */
+CREATE OR REPLACE FUNCTION pg_catalog.pg_cluster_query_profile(
+        pid int4, samples int4 DEFAULT 100, interval_ms int4 DEFAULT 10,
+        OUT node_oid oid, OUT node_name name, OUT pid int4, OUT kind text,
+        OUT plan_node_id int4, OUT name text, OUT self_samples int8,
+        OUT total_samples int8, OUT self_time_ms float8)
+  RETURNS SETOF record STRICT VOLATILE LANGUAGE sql
+  AS $$
+    SELECT * FROM pg_catalog.adb_cluster_function(
+            'pg_catalog.pg_query_profile_coord(oid,int4,int4,int4)',
+            ARRAY[pg_catalog.adb_node_oid()::text, $1::text, $2::text, $3::text])
+        AS P(node_oid oid, node_name name, pid int4, kind text, plan_node_id int4,
+             name text, self_samples int8, total_samples int8, self_time_ms float8)
+  $$
+  PARALLEL RESTRICTED CLUSTER RESTRICTED;
+
+CREATE VIEW pg_catalog.adb_stat_pool AS
+    SELECT
+            P.database,
+            P.usename,
+            N.node_name,
+            P.node_host,
+            P.node_port,
+            P.idle,
+            P.busy,
+            P.released,
+            P.uninit,
+            P.in_use,
+            P.acquires,
+            P.acquire_wait_time,
+            P.acquire_wait_lt_1ms,
+            P.acquire_wait_lt_10ms,
+            P.acquire_wait_lt_100ms,
+            P.acquire_wait_lt_1s,
+            P.acquire_wait_ge_1s,
+            P.connects,
+            P.connect_failures,
+            P.retries,
+            P.last_retry_time,
+            P.resets
+    FROM pg_catalog.pool_get_node_stats() AS P
+        LEFT JOIN pg_catalog.pgxc_node AS N
+            ON (N.node_host = P.node_host AND N.node_port = P.node_port);
+
+REVOKE ALL ON pg_catalog.adb_stat_pool FROM PUBLIC;
+REVOKE EXECUTE ON FUNCTION pg_catalog.pool_get_node_stats() FROM PUBLIC;
+GRANT SELECT ON pg_catalog.adb_stat_pool TO pg_monitor;
+GRANT EXECUTE ON FUNCTION pg_catalog.pool_get_node_stats() TO pg_monitor;
+
+CREATE VIEW pg_catalog.adb_stat_reduce_network AS
+    SELECT * FROM pg_catalog.adb_cluster_function('pg_catalog.adb_reduce_network_stats()', NULL)
+        AS S(node_oid oid, node_name name, peer_oid oid, bandwidth float8,
+             latency float8, bandwidth_samples int8, latency_samples int8,
+             last_update timestamptz);
+
+/*
+ * Load what dynamic reduce measured on every node into this node, so its
+ * planner sees the links between datanodes too when reduce_cost_calibration
+ * is on.
+ */
+CREATE OR REPLACE FUNCTION pg_catalog.adb_reduce_calibrate()
+  RETURNS int8 VOLATILE LANGUAGE sql
+  AS $$
+    SELECT count(*) FILTER (WHERE pg_catalog.adb_reduce_network_stats_set(peer_oid, bandwidth, latency))
+    FROM (SELECT peer_oid, avg(bandwidth) AS bandwidth, avg(latency) AS latency
+            FROM pg_catalog.adb_stat_reduce_network
+           GROUP BY peer_oid) AS S
+  $$
+  PARALLEL UNSAFE CLUSTER RESTRICTED;
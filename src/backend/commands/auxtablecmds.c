@@ -34,9 +34,11 @@ extern bool enable_aux_dml;
 
 static char *ChooseAuxTableName(const char *name1, const char *name2,
 								const char *label, Oid namespaceid);
-static List *MakeAuxTableColumns(Form_pg_attribute auxcolumn, Relation rel);
+static List *MakeAuxTableColumns(Form_pg_attribute auxcolumn, List *include, Relation rel);
 static PaddingAuxDataStmt *AnalyzeRewriteCreateAuxStmt(CreateAuxStmt *auxstmt);
 static void TruncateAuxRelation(Relation rel);
+static void RecordAuxIncludeDependency(Oid auxrelid, Oid relid);
+static Bitmapset *GetAuxIncludeAttnos(Relation rel, Oid auxrelid, Bitmapset *attnos);
 
 /*
  * InsertAuxClassTuple
@@ -81,6 +83,51 @@ InsertAuxClassTuple(Oid auxrelid, Oid relid, AttrNumber attnum)
 	/* Make pg_class object depend entry */
 	ObjectAddressSet(myself, RelationRelationId, auxrelid);
 	recordDependencyOn(&myself, &referenced, DEPENDENCY_NORMAL);
+
+	/* INCLUDE columns, so DROP COLUMN of them needs CASCADE like the key */
+	RecordAuxIncludeDependency(auxrelid, relid);
+}
+
+/*
+ * Make the auxiliary table depend on the master columns it includes, they
+ * are matched by name, see MakeAuxTableColumns.
+ */
+static void
+RecordAuxIncludeDependency(Oid auxrelid, Oid relid)
+{
+	HeapTuple			tuple;
+	Form_pg_attribute	aux_attr;
+	ObjectAddress		myself,
+						referenced;
+	AttrNumber			attno;
+	int					natts;
+	int					x;
+
+	tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(auxrelid));
+	if (!HeapTupleIsValid(tuple))
+		elog(ERROR, "cache lookup failed for relation %u", auxrelid);
+	natts = ((Form_pg_class) GETSTRUCT(tuple))->relnatts;
+	ReleaseSysCache(tuple);
+
+	ObjectAddressSet(myself, RelationRelationId, auxrelid);
+	for (x = Anum_aux_table_key + 1; x <= natts; ++x)
+	{
+		tuple = SearchSysCache2(ATTNUM,
+								ObjectIdGetDatum(auxrelid),
+								Int16GetDatum(x));
+		if (!HeapTupleIsValid(tuple))
+			elog(ERROR, "cache lookup failed for attribute %d of relation %u",
+				 x, auxrelid);
+		aux_attr = (Form_pg_attribute) GETSTRUCT(tuple);
+		attno = aux_attr->attisdropped ? InvalidAttrNumber :
+					get_attnum(relid, NameStr(aux_attr->attname));
+		ReleaseSysCache(tuple);
+
+		if (!AttrNumberIsForUserDefinedAttr(attno))
+			continue;
+		ObjectAddressSubSet(referenced, RelationRelationId, relid, attno);
+		recordDependencyOn(&myself, &referenced, DEPENDENCY_NORMAL);
+	}
 }
 
 /*
@@ -276,12 +323,13 @@ bool HasAuxRelation(Oid relid)
 }
 
 static List *
-MakeAuxTableColumns(Form_pg_attribute auxcolumn, Relation rel)
+MakeAuxTableColumns(Form_pg_attribute auxcolumn, List *include, Relation rel)
 {
 	ColumnDef		   *coldef;
 	List			   *tableElts = NIL;
 	List			   *arrayBounds = NIL;
 	Constraint		   *n;
+	ListCell		   *lc;
 	int					i;
 
 	Assert(auxcolumn && rel);
@@ -332,6 +380,22 @@ MakeAuxTableColumns(Form_pg_attribute auxcolumn, Relation rel)
 #error need change var list order
 #endif
 
+	/* 4. INCLUDE columns, copied from master relation */
+	foreach (lc, include)
+	{
+		Form_pg_attribute attr = lfirst(lc);
+
+		coldef = makeColumnDef(NameStr(attr->attname),
+							   attr->atttypid,
+							   attr->atttypmod,
+							   attr->attcollation);
+		arrayBounds = NIL;
+		for (i = 0; i < attr->attndims; i++)
+			arrayBounds = lappend(arrayBounds, makeInteger(-1));
+		coldef->typeName->arrayBounds = arrayBounds;
+		tableElts = lappend(tableElts, coldef);
+	}
+
 	return tableElts;
 }
 
@@ -348,6 +412,8 @@ AnalyzeRewriteCreateAuxStmt(CreateAuxStmt *auxstmt)
 	IndexStmt		   *index_stmt;
 	HeapTuple			atttuple;
 	Form_pg_attribute	auxattform;
+	List			   *include_attrs;
+	ListCell		   *lc;
 	Relation			master_relation;
 	Oid 				master_nspid;
 	Oid 				master_relid;
@@ -437,6 +503,38 @@ AnalyzeRewriteCreateAuxStmt(CreateAuxStmt *auxstmt)
 				 errmsg("no need to build auxiliary table for distribute column \"%s\"",
 				 auxstmt->aux_column)));
 
+	/* INCLUDE columns check */
+	include_attrs = NIL;
+	foreach (lc, auxstmt->aux_include)
+	{
+		IndexElem		   *ie = lfirst_node(IndexElem, lc);
+		HeapTuple			inctuple;
+		Form_pg_attribute	incattform;
+
+		if (ie->name == NULL)
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("expressions are not supported in included columns of auxiliary table")));
+		inctuple = SearchSysCacheCopyAttName(master_relid, ie->name);
+		if (!HeapTupleIsValid(inctuple))
+			ereport(ERROR,
+					(errcode(ERRCODE_UNDEFINED_COLUMN),
+					 errmsg("column \"%s\" does not exist",
+							ie->name)));
+		incattform = (Form_pg_attribute) GETSTRUCT(inctuple);
+		if (!AttrNumberIsForUserDefinedAttr(incattform->attnum))
+			ereport(ERROR,
+					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+					 errmsg("auxiliary table including system column \"%s\" is not supported",
+							ie->name)));
+		if (incattform->attnum == auxattform->attnum)
+			ereport(ERROR,
+					(errcode(ERRCODE_INVALID_COLUMN_REFERENCE),
+					 errmsg("column \"%s\" is already the auxiliary column",
+							ie->name)));
+		include_attrs = lappend(include_attrs, incattform);
+	}
+
 	/* choose auxiliary table name */
 	if (create_stmt->relation == NULL)
 	{
@@ -457,7 +555,7 @@ AnalyzeRewriteCreateAuxStmt(CreateAuxStmt *auxstmt)
 	padding_stmt->auxrvlist = list_make1(create_stmt->relation);
 
 	/* makeup table elements */
-	create_stmt->tableElts = MakeAuxTableColumns(auxattform, master_relation);
+	create_stmt->tableElts = MakeAuxTableColumns(auxattform, include_attrs, master_relation);
 	create_stmt->aux_attnum = auxattform->attnum;
 	if (create_stmt->distributeby == NULL)
 	{
@@ -473,7 +571,11 @@ AnalyzeRewriteCreateAuxStmt(CreateAuxStmt *auxstmt)
 		create_stmt->distributeby = spec;
 	}
 
+	/* covering index, lookups on auxiliary column can use index only scan */
+	index_stmt->indexIncludingParams = auxstmt->aux_include;
+
 	ReleaseSysCache(atttuple);
+	list_free_deep(include_attrs);
 	relation_close(master_relation, NoLock);
 
 	return padding_stmt;
@@ -768,6 +870,7 @@ void RelationBuildAuxiliary(Relation rel)
 	SysScanDesc				auxscan;
 	List				   *auxlist;
 	Bitmapset			   *auxatt;
+	ListCell			   *lc;
 	MemoryContext			old_context;
 	AssertArg(rel);
 
@@ -775,6 +878,7 @@ void RelationBuildAuxiliary(Relation rel)
 	{
 		rel->rd_auxlist = NIL;
 		rel->rd_auxatt = NULL;
+		rel->rd_auxinclude = NULL;
 		return;
 	}
 
@@ -807,6 +911,55 @@ void RelationBuildAuxiliary(Relation rel)
 
 	systable_endscan(auxscan);
 	table_close(auxrel, AccessShareLock);
+
+	/* INCLUDE columns, DML on the master need fetch them for each auxiliary */
+	auxatt = NULL;
+	foreach (lc, auxlist)
+		auxatt = GetAuxIncludeAttnos(rel, lfirst_oid(lc), auxatt);
+	old_context = MemoryContextSwitchTo(CacheMemoryContext);
+	rel->rd_auxinclude = bms_copy(auxatt);
+	MemoryContextSwitchTo(old_context);
+	bms_free(auxatt);
+}
+
+/*
+ * Get the master attribute numbers of INCLUDE columns of auxiliary table,
+ * they are the columns after Anum_aux_table_key.  Use syscache only and
+ * never raise an error, it is called by relcache build of the master.  A
+ * column we can not match is skipped, DML on the master reports it, see
+ * MakeMainRelTargetForAux.
+ */
+static Bitmapset *GetAuxIncludeAttnos(Relation rel, Oid auxrelid, Bitmapset *attnos)
+{
+	HeapTuple			tuple;
+	Form_pg_attribute	aux_attr;
+	AttrNumber			attno;
+	int					natts;
+	int					x;
+
+	tuple = SearchSysCache1(RELOID, ObjectIdGetDatum(auxrelid));
+	if (!HeapTupleIsValid(tuple))
+		return attnos;
+	natts = ((Form_pg_class) GETSTRUCT(tuple))->relnatts;
+	ReleaseSysCache(tuple);
+
+	for (x = Anum_aux_table_key + 1; x <= natts; ++x)
+	{
+		tuple = SearchSysCache2(ATTNUM,
+								ObjectIdGetDatum(auxrelid),
+								Int16GetDatum(x));
+		if (!HeapTupleIsValid(tuple))
+			continue;
+		aux_attr = (Form_pg_attribute) GETSTRUCT(tuple);
+		attno = aux_attr->attisdropped ? InvalidAttrNumber :
+					get_attnum(RelationGetRelid(rel), NameStr(aux_attr->attname));
+		ReleaseSysCache(tuple);
+
+		if (AttrNumberIsForUserDefinedAttr(attno))
+			attnos = bms_add_member(attnos, attno);
+	}
+
+	return attnos;
 }
 
 Bitmapset *MakeAuxMainRelResultAttnos(Relation rel)
@@ -824,6 +977,11 @@ Bitmapset *MakeAuxMainRelResultAttnos(Relation rel)
 	while ((x=bms_next_member(rel->rd_auxatt, x)) >= 0)
 		attr = bms_add_member(attr, x - FirstLowInvalidHeapAttributeNumber);
 
+	/* INCLUDE columns of auxiliary tables, cached by RelationBuildAuxiliary() */
+	x = -1;
+	while ((x=bms_next_member(rel->rd_auxinclude, x)) >= 0)
+		attr = bms_add_member(attr, x - FirstLowInvalidHeapAttributeNumber);
+
 	return attr;
 }
 
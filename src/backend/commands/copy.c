@@ -106,6 +106,25 @@ typedef enum EolType
 
 #ifdef ADB
 
+/* max bytes of rows pending in libpq output buffers before flush them */
+#define COPY_FROM_FLUSH_SIZE	(256 * 1024)
+
+/* GUC */
+bool copy_from_shared_file = false;
+
+typedef struct SharedFileCopyState
+{
+	CopyState		cstate;		/* parse state of our range in the file */
+	TupleTableSlot *slot;
+	uint64			processed;	/* count of lines we parsed */
+} SharedFileCopyState;
+
+typedef struct SharedFileCopyHook
+{
+	PQNHookFunctions	pub;
+	uint64				processed;	/* sum of datanodes processed */
+} SharedFileCopyHook;
+
 typedef struct CopyFromReduceState
 {
 	DynamicReduceIOBuffer	drio;
@@ -123,6 +142,7 @@ typedef struct TidBufFileScanState
 	TupleTableSlot *base_slot;
 	TupleTableSlot *out_slot;
 	Relation		rel;
+	IndexFetchTableData *fetch;	/* keeps current block pinned */
 }TidBufFileScanState;
 
 #endif /* ADB */
@@ -281,6 +301,9 @@ typedef struct CopyStateData
 	List			   *list_connect;	/* list of pg_conn */
 	uint64				count_tuple;	/* count tuple(s) read */
 	int					exec_cluster_flag;
+	bool				copy_file_limited;	/* only read a range of copy_file? */
+	bool				copy_file_range_last;	/* range reaches end of file? */
+	off_t				copy_file_remain;	/* bytes left in the range */
 #endif
 } CopyStateData;
 
@@ -466,6 +489,9 @@ static List* LoadAuxRelCopyInfo(StringInfo mem_toc);
 static void ApplyCopyToAuxiliary(CopyState parent, List *rnodes);
 static TupleTableSlot* NextRowFromReduce(CopyState cstate, ExprContext *context, void *data);
 static TupleTableSlot* NextRowFromTidBufFile(CopyState cstate, ExprContext *context, void *data);
+static bool CanCopyFromSharedFile(ParseState *pstate, Relation rel, const CopyStmt *stmt);
+static uint64 CoordinatorCopyFromSharedFile(Relation rel, const CopyStmt *stmt);
+static void ClusterCopyFromSharedFile(CopyStmt *stmt, Relation rel, StringInfo info);
 #endif
 
 /*
@@ -689,6 +715,11 @@ CopyGetData(CopyState cstate, void *databuf, int minread, int maxread)
 	switch (cstate->copy_dest)
 	{
 		case COPY_FILE:
+#ifdef ADB
+			if (cstate->copy_file_limited &&
+				maxread > cstate->copy_file_remain)
+				maxread = (int) cstate->copy_file_remain;
+#endif /* ADB */
 			bytesread = fread(databuf, 1, maxread, cstate->copy_file);
 			if (ferror(cstate->copy_file))
 				ereport(ERROR,
@@ -696,6 +727,10 @@ CopyGetData(CopyState cstate, void *databuf, int minread, int maxread)
 						 errmsg("could not read from COPY file: %m")));
 			if (bytesread == 0)
 				cstate->reached_eof = true;
+#ifdef ADB
+			if (cstate->copy_file_limited)
+				cstate->copy_file_remain -= bytesread;
+#endif /* ADB */
 			break;
 		case COPY_OLD_FE:
 
@@ -1294,6 +1329,15 @@ DoCopy(ParseState *pstate, const CopyStmt *stmt,
 		if (XactReadOnly && !rel->rd_islocaltemp)
 			PreventCommandIfReadOnly("COPY FROM");
 
+#ifdef ADB
+		if (CanCopyFromSharedFile(pstate, rel, stmt))
+		{
+			*processed = CoordinatorCopyFromSharedFile(rel, stmt);
+			pstate->p_target_relation = NULL;
+			table_close(rel, NoLock);
+			return;
+		}
+#endif /* ADB */
 		cstate = BeginCopyFrom(pstate, rel, stmt->filename, stmt->is_program,
 							   NULL, stmt->attlist, stmt->options);
 		cstate->whereClause = whereClause;
@@ -4711,6 +4755,22 @@ CopyReadLineText(CopyState cstate)
 							 errmsg("end-of-copy marker does not match previous newline style")));
 				}
 
+#ifdef ADB
+				/*
+				 * Datanodes reading ranges of a shared file can not tell the
+				 * following ranges to stop, so only accept the marker at the
+				 * end of the file, other ranges would load rows after it.
+				 */
+				if (cstate->copy_file_limited &&
+					(raw_buf_ptr < cstate->raw_buf_len ||
+					 cstate->copy_file_remain > 0 ||
+					 cstate->copy_file_range_last == false))
+					ereport(ERROR,
+							(errcode(ERRCODE_BAD_COPY_FILE_FORMAT),
+							 errmsg("end-of-copy marker found before end of shared COPY file"),
+							 errhint("Set copy_from_shared_file to off to load this file.")));
+#endif /* ADB */
+
 				/*
 				 * Transfer only the data before the \. into line_buf, then
 				 * discard the data and the \. sequence.
@@ -5670,6 +5730,7 @@ void DoClusterCopy(CopyStmt *stmt, StringInfo mem_toc)
 				   *nsitem;
 	RangeTblEntry  *rte;
 	List		   *rnodes = NIL;
+	StringInfoData	buf;
 
 	if (stmt->is_from == false)
 	{
@@ -5690,6 +5751,16 @@ void DoClusterCopy(CopyStmt *stmt, StringInfo mem_toc)
 		PreventCommandIfReadOnly("COPY FROM");
 	PreventCommandIfParallelMode("COPY FROM");
 
+	buf.data = mem_toc_lookup(mem_toc, SHARED_FILE_COPY_INFO, &buf.len);
+	if (buf.data != NULL)
+	{
+		buf.maxlen = buf.len;
+		buf.cursor = 0;
+		ClusterCopyFromSharedFile(stmt, rel, &buf);
+		table_close(rel, RowExclusiveLock);
+		return;
+	}
+
 	pstate = make_parsestate(NULL);
 
 	nsitem = addRangeTableEntryForRelation(pstate, rel, RowExclusiveLock, NULL, false, false);
@@ -5727,7 +5798,6 @@ void DoClusterCopy(CopyStmt *stmt, StringInfo mem_toc)
 	cstate->aux_info = LoadAuxRelCopyInfo(mem_toc);
 	if (cstate->aux_info)
 	{
-		StringInfoData buf;
 		buf.data = mem_toc_lookup(mem_toc, AUX_REL_MAIN_NODES, &buf.len);
 		if (buf.data == NULL)
 			ereport(ERROR,
@@ -5769,6 +5839,7 @@ static uint64 CoordinatorCopyFrom(CopyState cstate)
 	StringInfoData	buf;
 	ExprDoneCond done;
 	bool isnull;
+	Size unflushed = 0;
 
 	Assert(cstate->rel);
 	/* force refresh currentCommandId */
@@ -5859,6 +5930,17 @@ static uint64 CoordinatorCopyFrom(CopyState cstate)
 							  false);
 			last_time = cur_time;
 		}
+
+		/*
+		 * Don't flush each row, libpq send full blocks by itself,
+		 * we only limit the data pending in output buffers, so datanodes
+		 * insert rows while we read and parse next lines.
+		 */
+		if (unflushed >= COPY_FROM_FLUSH_SIZE)
+		{
+			PQNFlush(cstate->list_connect, true);
+			unflushed = 0;
+		}
 		ExecClearTuple(cstate->cs_tupleslot);
 		if (cstate->cs_tsConvert != NULL)
 			ExecClearTuple(cstate->cs_tsConvert);
@@ -5892,8 +5974,7 @@ static uint64 CoordinatorCopyFrom(CopyState cstate)
 					serialize_slot_message(&buf,
 										   slot,
 										   type_convert ? CLUSTER_MSG_CONVERT_TUPLE:CLUSTER_MSG_TUPLE_DATA);
-				if (PQputCopyData(conn, buf.data, buf.len) != 1 ||
-					PQflush(conn) < 0)
+				if (PQputCopyData(conn, buf.data, buf.len) != 1)
 				{
 					char *err = PQerrorMessage(conn);
 					int len = strlen(err);
@@ -5903,6 +5984,7 @@ static uint64 CoordinatorCopyFrom(CopyState cstate)
 							(errmsg("%s", err),
 							 errnode(PQNConnectName(conn))));
 				}
+				unflushed += buf.len;
 			}
 			if (done != ExprMultipleResult)
 				break;
@@ -6413,6 +6495,11 @@ static void ApplyCopyToAuxiliary(CopyState parent, List *rnodes)
 	state.rel = parent->rel;
 	state.base_slot = table_slot_create(parent->rel, NULL);
 	state.out_slot = MakeTupleTableSlot(NULL, &TTSOpsVirtual);
+	/*
+	 * copied ctids are in insert order, fetching them like an index scan
+	 * does not read and lock the same buffer again for each tuple
+	 */
+	state.fetch = table_index_fetch_begin(parent->rel);
 
 	econtext = CreateStandaloneExprContext();
 
@@ -6450,6 +6537,7 @@ static void ApplyCopyToAuxiliary(CopyState parent, List *rnodes)
 	}
 
 	FreeExprContext(econtext, true);
+	table_index_fetch_end(state.fetch);
 	ExecDropSingleTupleTableSlot(state.out_slot);
 	ExecDropSingleTupleTableSlot(state.base_slot);
 
@@ -6619,6 +6707,7 @@ static TupleTableSlot* NextRowFromTidBufFile(CopyState cstate, ExprContext *cont
 	size_t					nread;
 	ExprContext			   *econtext;
 	ItemPointerData			tid;
+	bool					call_again = false;
 
 	nread = BufFileRead(state->file, &tid, sizeof(ItemPointerData));
 	if (nread == 0)
@@ -6630,10 +6719,12 @@ static TupleTableSlot* NextRowFromTidBufFile(CopyState cstate, ExprContext *cont
 				(errcode_for_file_access(),
 				 errmsg("could not read from copied-ctid temporary file: %m")));
 	}
-	if (table_tuple_fetch_row_version(state->rel,
-									  &tid,
-									  SnapshotAny,
-									  state->base_slot) == false)
+	if (table_index_fetch_tuple(state->fetch,
+								&tid,
+								SnapshotAny,
+								state->base_slot,
+								&call_again,
+								NULL) == false)
 	{
 		ereport(ERROR,
 				(errmsg("failed to fetch tuple for NextRowFromTidBufFile")));
@@ -6776,4 +6867,301 @@ DoPaddingDataForAuxRel(Relation master,
 	PopActiveSnapshot();
 }
 
+/*
+ * Can datanodes read the COPY FROM file by themselves?
+ *
+ * Each datanode reads a byte range of the file and splits it at line
+ * boundaries, this only works for text format, rows of csv format can
+ * contain newline in quoted value. In text format a newline escaped by
+ * backslash is data, we can only count the backslashes before it when
+ * the file encoding never uses ASCII bytes inside multibyte characters.
+ * Rows are parsed on datanodes, so triggers, WHERE clause and volatile
+ * default values are not allowed.
+ */
+static bool CanCopyFromSharedFile(ParseState *pstate, Relation rel, const CopyStmt *stmt)
+{
+	CopyState	cstate;
+	TupleDesc	desc;
+	Node	   *defexpr;
+	int			i;
+
+	if (copy_from_shared_file == false ||
+		stmt->filename == NULL ||
+		stmt->is_program ||
+		stmt->whereClause != NULL ||
+		!is_absolute_path(stmt->filename) ||
+		RelationGetLocInfoForRemote(rel) == NULL)
+		return false;
+
+	if (rel->rd_rel->relkind != RELKIND_RELATION ||
+		rel->trigdesc != NULL ||
+		rel->rd_auxlist != NIL)
+		return false;
+
+	cstate = palloc0(sizeof(CopyStateData));
+	ProcessCopyOptions(pstate, cstate, true, stmt->options);
+	if (cstate->binary || cstate->csv_mode ||
+		PG_ENCODING_IS_CLIENT_ONLY(cstate->file_encoding < 0 ? pg_get_client_encoding()
+															  : cstate->file_encoding))
+	{
+		pfree(cstate);
+		return false;
+	}
+	pfree(cstate);
+
+	desc = RelationGetDescr(rel);
+	for (i=0;i<desc->natts;++i)
+	{
+		Form_pg_attribute attr = TupleDescAttr(desc, i);
+		if (attr->attisdropped ||
+			attr->atthasdef == false)
+			continue;
+		defexpr = build_column_default(rel, i+1);
+		if (defexpr != NULL &&
+			contain_volatile_functions(defexpr))
+			return false;
+	}
+
+	return true;
+}
+
+static bool SharedFileCopyHookCopyOut(PQNHookFunctions *pub, struct pg_conn *conn, const char *buf, int len)
+{
+	SharedFileCopyHook *hook = (SharedFileCopyHook*)pub;
+
+	if (len > 0 && buf[0] == CLUSTER_MSG_PROCESSED)
+	{
+		hook->processed += restore_processed_message(buf+1, len-1);
+		return false;
+	}
+
+	return clusterRecvTuple(NULL, buf, len, NULL, conn);
+}
+
+static uint64 CoordinatorCopyFromSharedFile(Relation rel, const CopyStmt *stmt)
+{
+	CopyStmt		   *remote_stmt;
+	CopyState			cstate;
+	ReduceInfo		   *rinfo;
+	List			   *rnodes;
+	List			   *list_conn;
+	ListCell		   *lc;
+	StringInfoData		mem_toc;
+	SharedFileCopyHook	hook;
+
+	/* check read-only transaction and parallel mode */
+	if (XactReadOnly && !rel->rd_islocaltemp)
+		PreventCommandIfReadOnly("COPY FROM");
+
+	/* force refresh currentCommandId */
+	GetCurrentCommandId(true);
+
+	remote_stmt = (CopyStmt*)copyObject(stmt);
+	remote_stmt->relation = makeRangeVar(get_namespace_name(RelationGetNamespace(rel)),
+										 pstrdup(RelationGetRelationName(rel)),
+										 -1);
+
+	/* datanodes must decode the file use our client encoding */
+	cstate = palloc0(sizeof(CopyStateData));
+	ProcessCopyOptions(NULL, cstate, true, stmt->options);
+	if (cstate->file_encoding < 0)
+		remote_stmt->options = lappend(remote_stmt->options,
+									   makeDefElem("encoding",
+												   (Node*)makeString((char*)pg_encoding_to_char(pg_get_client_encoding())),
+												   -1));
+	pfree(cstate);
+
+	rnodes = adbGetUniqueNodeOids(rel->rd_locator_info->nodeids);
+	rinfo = MakeReduceInfoFromLocInfo(rel->rd_locator_info,
+									  NIL,
+									  RelationGetRelid(rel),
+									  1 /* only have one relation */);
+
+	initStringInfo(&mem_toc);
+	begin_mem_toc_insert(&mem_toc, SHARED_FILE_COPY_INFO);
+	saveNode(&mem_toc, (Node*)rnodes);
+	saveNode(&mem_toc, (Node*)CreateExprUsingReduceInfo(rinfo));
+	end_mem_toc_insert(&mem_toc, SHARED_FILE_COPY_INFO);
+
+	list_conn = ExecStartClusterCopy(rnodes,
+									 remote_stmt,
+									 &mem_toc,
+									 EXEC_CLUSTER_FLAG_NEED_REDUCE|EXEC_CLUSTER_FLAG_USE_MEM_REDUCE);
+	Assert(list_length(list_conn) == list_length(rnodes));
+
+	/* datanodes read file by themselves, we have no data to send */
+	foreach(lc, list_conn)
+	{
+		if (PQputCopyEnd(lfirst(lc), NULL) < 0)
+		{
+			ereport(ERROR,
+					(errmsg("%s", PQerrorMessage(lfirst(lc))),
+					 errnode(PQNConnectName(lfirst(lc)))));
+		}
+	}
+	PQNFlush(list_conn, true);
+
+	memcpy(&hook.pub, &PQNDefaultHookFunctions, sizeof(hook.pub));
+	hook.pub.HookCopyOut = SharedFileCopyHookCopyOut;
+	hook.processed = 0;
+	PQNListExecFinish(list_conn, NULL, &hook.pub, true);
+
+	list_free(list_conn);
+	list_free(rnodes);
+	pfree(mem_toc.data);
+
+	return hook.processed;
+}
+
+static int CopyFileByteAt(CopyState cstate, off_t pos)
+{
+	int		c;
+
+	if (fseeko(cstate->copy_file, pos, SEEK_SET) != 0)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not seek in file \"%s\": %m", cstate->filename)));
+	c = getc(cstate->copy_file);
+	if (ferror(cstate->copy_file))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from COPY file: %m")));
+	return c;
+}
+
+/*
+ * Find first line start at or after "pos", lines before it
+ * belong to the previous datanode's range.
+ *
+ * A newline is a line end only when an even number of backslashes
+ * come right before it, otherwise it is escaped and part of the data.
+ * Those backslashes may start before "pos", so back up over them first.
+ */
+static off_t CopyFileLineStart(CopyState cstate, off_t pos)
+{
+	off_t	start;
+	int		backslashes;
+	int		c;
+
+	if (pos == 0)
+		return 0;
+
+	/* the byte before "pos" may be the newline ending the previous line */
+	start = pos - 1;
+	while (start > 0 && CopyFileByteAt(cstate, start - 1) == '\\')
+		--start;
+
+	if (fseeko(cstate->copy_file, start, SEEK_SET) != 0)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not seek in file \"%s\": %m", cstate->filename)));
+
+	backslashes = 0;
+	pos = start;	/* offset of next byte to read */
+	while ((c = getc(cstate->copy_file)) != EOF)
+	{
+		++pos;
+		if (c == '\n' && (backslashes % 2) == 0)
+			break;
+		if (c == '\\')
+			++backslashes;
+		else
+			backslashes = 0;
+	}
+	if (ferror(cstate->copy_file))
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not read from COPY file: %m")));
+
+	return pos;
+}
+
+/*
+ * Limit cstate to read our range of the file, file split into
+ * "count" ranges, we read "index" range
+ */
+static void SetCopyFileRange(CopyState cstate, int index, int count)
+{
+	struct stat st;
+	off_t		start;
+	off_t		end;
+
+	Assert(index >= 0 && index < count);
+	if (fstat(fileno(cstate->copy_file), &st) != 0)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not stat file \"%s\": %m", cstate->filename)));
+
+	start = CopyFileLineStart(cstate, (off_t)((uint64)st.st_size * index / count));
+	end = CopyFileLineStart(cstate, (off_t)((uint64)st.st_size * (index+1) / count));
+	if (fseeko(cstate->copy_file, start, SEEK_SET) != 0)
+		ereport(ERROR,
+				(errcode_for_file_access(),
+				 errmsg("could not seek in file \"%s\": %m", cstate->filename)));
+
+	cstate->copy_file_limited = true;
+	cstate->copy_file_range_last = (end >= st.st_size);
+	cstate->copy_file_remain = end - start;
+}
+
+static TupleTableSlot* NextRowFromSharedFile(CopyState cstate, ExprContext *econtext, void *data)
+{
+	SharedFileCopyState *state = data;
+	TupleTableSlot *slot = state->slot;
+
+	ExecClearTuple(slot);
+	if (NextCopyFrom(state->cstate, econtext, slot->tts_values, slot->tts_isnull) == false)
+		return slot;
+
+	++(state->processed);
+	return ExecStoreVirtualTuple(slot);
+}
+
+/*
+ * Datanode read and parse our range of shared file,
+ * send rows to other datanode(s) using dynamic reduce
+ */
+static void ClusterCopyFromSharedFile(CopyStmt *stmt, Relation rel, StringInfo info)
+{
+	SharedFileCopyState	state;
+	ParseState		   *pstate;
+	List			   *rnodes;
+	Expr			   *reduce;
+	StringInfoData		msg;
+	int					index;
+
+	rnodes = (List*)loadNode(info);
+	reduce = (Expr*)loadNode(info);
+	index = list_member_oid_idx(rnodes, PGXCNodeOid);
+	if (index < 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROTOCOL_VIOLATION),
+				 errmsg("Can not found self node in cluster copy message")));
+
+	pstate = make_parsestate(NULL);
+	addRangeTableEntryForRelation(pstate, rel, RowExclusiveLock, NULL, false, false);
+
+	state.cstate = BeginCopyFrom(pstate, rel, stmt->filename, false,
+								 NULL, stmt->attlist, stmt->options);
+	SetCopyFileRange(state.cstate, index, list_length(rnodes));
+	state.slot = MakeSingleTupleTableSlot(RelationGetDescr(rel), &TTSOpsVirtual);
+	state.processed = 0;
+
+	ClusterCopyFromReduce(rel,
+						  reduce,
+						  rnodes,
+						  1,
+						  state.cstate->freeze,
+						  NextRowFromSharedFile,
+						  &state);
+
+	ExecDropSingleTupleTableSlot(state.slot);
+	EndCopyFrom(state.cstate);
+
+	initStringInfo(&msg);
+	serialize_processed_message(&msg, state.processed);
+	pq_putmessage('d', msg.data, msg.len);
+	pfree(msg.data);
+}
+
 #endif /* ADB */
@@ -52,6 +52,11 @@ ExplainOneQuery_hook_type ExplainOneQuery_hook = NULL;
 /* Hook for plugins to get control in explain_get_index_name() */
 explain_get_index_name_hook_type explain_get_index_name_hook = NULL;
 
+#ifdef ADB
+/* GUC parameter */
+double		explain_skew_threshold = 1.5;
+#endif /* ADB */
+
 
 /* OR-able flags for ExplainXMLTag() */
 #define X_OPENING 0
@@ -97,6 +102,9 @@ static void show_merge_gather_keys(ClusterMergeGatherState *mgstate, List *ances
 					   ExplainState *es);
 static void show_cluster_reduce_keys(ClusterReduceState *crstate, List *ancestors,
 					   ExplainState *es);
+static void show_cluster_node_stats(PlanState *planstate, ExplainState *es);
+static void show_cluster_reduce_volume(ClusterReduceState *crstate, ExplainState *es);
+static void show_cluster_reduce_cost(ClusterReduce *plan, ExplainState *es);
 #endif /* ADB */
 static void show_agg_keys(AggState *astate, List *ancestors,
 						  ExplainState *es);
@@ -207,7 +215,10 @@ ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 			es->settings = defGetBoolean(opt);
 #ifdef ADB
 		else if (strcmp(opt->defname, "nodes") == 0)
+		{
 			es->nodes = defGetBoolean(opt);
+			es->node_stats = es->nodes;
+		}
 		else if (strcmp(opt->defname, "num_nodes") == 0)
 			es->num_nodes = defGetBoolean(opt);
 		else if (strcmp(opt->defname, "plan_id") == 0)
@@ -2192,6 +2203,8 @@ ExplainNode(PlanState *planstate, List *ancestors,
 											  false);
 					ExplainPropertyText(label, expr, es);
 				}
+				if (es->costs)
+					show_cluster_reduce_cost(reducePlan, es);
 			}
 			show_cluster_reduce_keys((ClusterReduceState *) planstate,
 									 ancestors, es);
@@ -2317,6 +2330,12 @@ ExplainNode(PlanState *planstate, List *ancestors,
 			break;
 	}
 #ifdef ADB
+	if (es->analyze && es->node_stats && planstate->list_cluster_instrument != NIL)
+	{
+		show_cluster_node_stats(planstate, es);
+		if (IsA(planstate, ClusterReduceState))
+			show_cluster_reduce_volume((ClusterReduceState *) planstate, es);
+	}
 	if(es->analyze && es->verbose && planstate->list_cluster_instrument != NIL)
 	{
 		ListCell *lc;
@@ -2755,6 +2774,272 @@ show_cluster_reduce_keys(ClusterReduceState *crstate, List *ancestors,
 						 plan->nullsFirst,
 						 ancestors, es);
 }
+
+/*
+ * Merge the instrumentation a datanode sent for a plan node over its
+ * parallel workers.  Returns the rows of all processes together, and sets
+ * *loops to the loops of the node on that datanode (0 when it never ran)
+ * and *time to the per-loop time of its slowest process, in milliseconds.
+ *
+ * Once the workers finished, ExecParallelRetrieveInstrumentation() has
+ * already added them into instrument[0]; otherwise instrument[0] is the
+ * leader's share only.
+ */
+static double
+cluster_instrument_merge(ClusterInstrumentation *ci, double *loops, double *time)
+{
+	Instrumentation *leader = &ci->instrument[0];
+	Instrumentation *worker;
+	double		leader_loops = leader->nloops;
+	double		leader_total = leader->total;
+	double		worker_loops = 0.0;
+	double		worker_total = 0.0;
+	double		worker_rows = 0.0;
+	double		max_time = 0.0;
+	int			i;
+
+	*loops = 0.0;
+	for (i = 1; i <= ci->num_workers; ++i)
+	{
+		worker = &ci->instrument[i];
+		if (worker->nloops <= 0)
+			continue;
+		worker_loops += worker->nloops;
+		worker_total += worker->total;
+		worker_rows += worker->ntuples;
+		*loops = Max(*loops, worker->nloops);
+		max_time = Max(max_time, worker->total / worker->nloops);
+	}
+
+	if (worker_loops > 0.0 && leader_loops >= worker_loops)
+	{
+		/* workers included, take the leader's own share */
+		leader_loops -= worker_loops;
+		leader_total -= worker_total;
+		worker_rows = 0.0;
+	}
+	if (leader_loops > 0.0)
+	{
+		*loops = Max(*loops, leader_loops);
+		max_time = Max(max_time, leader_total / leader_loops);
+	}
+
+	*time = 1000.0 * max_time;
+	return leader->ntuples + worker_rows;
+}
+
+/*
+ * Show min, max and average of the actual time and rows of a plan node over
+ * the datanodes which executed it.  The skew is the max divided by the
+ * average; the node is flagged when either skew exceeds
+ * explain_skew_threshold.
+ */
+static void
+show_cluster_node_stats(PlanState *planstate, ExplainState *es)
+{
+	ListCell   *lc;
+	ClusterInstrumentation *ci;
+	double		nloops;
+	double		time;
+	double		rows;
+	double		min_time = 0.0;
+	double		max_time = 0.0;
+	double		avg_time = 0.0;
+	double		min_rows = 0.0;
+	double		max_rows = 0.0;
+	double		avg_rows = 0.0;
+	double		time_skew;
+	double		rows_skew;
+	int			nnodes = 0;
+	bool		skewed;
+
+	foreach(lc, planstate->list_cluster_instrument)
+	{
+		ci = lfirst(lc);
+		rows = cluster_instrument_merge(ci, &nloops, &time);
+		if (nloops <= 0)
+			continue;
+
+		rows /= nloops;
+		if (nnodes == 0)
+		{
+			min_time = max_time = time;
+			min_rows = max_rows = rows;
+		}else
+		{
+			min_time = Min(min_time, time);
+			max_time = Max(max_time, time);
+			min_rows = Min(min_rows, rows);
+			max_rows = Max(max_rows, rows);
+		}
+		avg_time += time;
+		avg_rows += rows;
+		++nnodes;
+	}
+	if (nnodes == 0)
+		return;
+
+	avg_time /= nnodes;
+	avg_rows /= nnodes;
+	time_skew = avg_time > 0.0 ? max_time / avg_time : 1.0;
+	rows_skew = avg_rows > 0.0 ? max_rows / avg_rows : 1.0;
+	skewed = (es->timing && time_skew > explain_skew_threshold) ||
+			 rows_skew > explain_skew_threshold;
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainIndentText(es);
+		appendStringInfo(es->str, "Datanodes: %d\n", nnodes);
+		if (es->timing)
+		{
+			ExplainIndentText(es);
+			appendStringInfo(es->str,
+							 "Datanode Time: min=%.3f max=%.3f avg=%.3f skew=%.2f\n",
+							 min_time, max_time, avg_time, time_skew);
+		}
+		ExplainIndentText(es);
+		appendStringInfo(es->str,
+						 "Datanode Rows: min=%.0f max=%.0f avg=%.0f skew=%.2f\n",
+						 min_rows, max_rows, avg_rows, rows_skew);
+		if (skewed)
+		{
+			ExplainIndentText(es);
+			appendStringInfo(es->str, "Datanode Skew: exceeds %.2f\n",
+							 explain_skew_threshold);
+		}
+	}
+	else
+	{
+		ExplainPropertyInteger("Datanodes", NULL, nnodes, es);
+		if (es->timing)
+		{
+			ExplainPropertyFloat("Datanode Min Time", "ms", min_time, 3, es);
+			ExplainPropertyFloat("Datanode Max Time", "ms", max_time, 3, es);
+			ExplainPropertyFloat("Datanode Avg Time", "ms", avg_time, 3, es);
+			ExplainPropertyFloat("Datanode Time Skew", NULL, time_skew, 2, es);
+		}
+		ExplainPropertyFloat("Datanode Min Rows", NULL, min_rows, 0, es);
+		ExplainPropertyFloat("Datanode Max Rows", NULL, max_rows, 0, es);
+		ExplainPropertyFloat("Datanode Avg Rows", NULL, avg_rows, 0, es);
+		ExplainPropertyFloat("Datanode Rows Skew", NULL, rows_skew, 2, es);
+		ExplainPropertyBool("Datanode Skewed", skewed, es);
+	}
+}
+
+/*
+ * Show rows each datanode sent into and received from a ClusterReduce.
+ * What a datanode sends is what the reduce's subplan returned on it, and
+ * what it receives (itself included) is what the reduce returned.
+ */
+static void
+show_cluster_reduce_volume(ClusterReduceState *crstate, ExplainState *es)
+{
+	PlanState  *outer = outerPlanState(crstate);
+	ListCell   *lc;
+	ListCell   *lc2;
+	ClusterInstrumentation *ci;
+	ClusterInstrumentation *outer_ci;
+	const char *node_name;
+	double		sent;
+	double		received;
+	double		loops;
+	double		time;
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+		ExplainOpenGroup("Reduce Nodes", "Reduce Nodes", false, es);
+
+	foreach(lc, crstate->ps.list_cluster_instrument)
+	{
+		ci = lfirst(lc);
+		received = cluster_instrument_merge(ci, &loops, &time);
+		if (loops <= 0)
+			continue;
+
+		sent = 0.0;
+		if (outer != NULL)
+		{
+			foreach(lc2, outer->list_cluster_instrument)
+			{
+				outer_ci = lfirst(lc2);
+				if (outer_ci->nodeOid == ci->nodeOid)
+				{
+					sent = cluster_instrument_merge(outer_ci, &loops, &time);
+					break;
+				}
+			}
+		}
+		node_name = GetNodeName(ci->nodeOid);
+
+		if (es->format == EXPLAIN_FORMAT_TEXT)
+		{
+			ExplainIndentText(es);
+			if (node_name)
+				appendStringInfo(es->str, "Reduce %s:", node_name);
+			else
+				appendStringInfo(es->str, "Reduce %u:", ci->nodeOid);
+			appendStringInfo(es->str, " sent=%.0f received=%.0f\n",
+							 sent, received);
+		}
+		else
+		{
+			ExplainOpenGroup("Reduce Node", NULL, true, es);
+			if (node_name)
+				ExplainPropertyText("Node Name", node_name, es);
+			ExplainPropertyInteger("Oid", NULL, ci->nodeOid, es);
+			ExplainPropertyFloat("Sent Rows", NULL, sent, 0, es);
+			ExplainPropertyFloat("Received Rows", NULL, received, 0, es);
+			ExplainCloseGroup("Reduce Node", NULL, true, es);
+		}
+	}
+
+	if (es->format != EXPLAIN_FORMAT_TEXT)
+		ExplainCloseGroup("Reduce Nodes", "Reduce Nodes", false, es);
+}
+
+/*
+ * Show how the planner's cost of a ClusterReduce splits into connecting to
+ * the other nodes and moving the rows, and the network figures it was
+ * calibrated with, if any.
+ */
+static void
+show_cluster_reduce_cost(ClusterReduce *plan, ExplainState *es)
+{
+	bool		calibrated = (plan->reduce_bandwidth > 0.0 ||
+							  plan->reduce_latency > 0.0);
+
+	if (es->format == EXPLAIN_FORMAT_TEXT)
+	{
+		ExplainIndentText(es);
+		appendStringInfo(es->str, "Reduce Cost: connect=%.2f transfer=%.2f\n",
+						 plan->reduce_conn_cost, plan->reduce_transfer_cost);
+		if (calibrated)
+		{
+			ExplainIndentText(es);
+			appendStringInfoString(es->str, "Reduce Network:");
+			if (plan->reduce_bandwidth > 0.0)
+				appendStringInfo(es->str, " bandwidth=%.1fMB/s",
+								 plan->reduce_bandwidth / (1024.0 * 1024.0));
+			if (plan->reduce_latency > 0.0)
+				appendStringInfo(es->str, " latency=%.3fms",
+								 plan->reduce_latency);
+			appendStringInfoChar(es->str, '\n');
+		}
+	}
+	else
+	{
+		ExplainPropertyFloat("Reduce Connect Cost", NULL,
+							 plan->reduce_conn_cost, 2, es);
+		ExplainPropertyFloat("Reduce Transfer Cost", NULL,
+							 plan->reduce_transfer_cost, 2, es);
+		if (calibrated)
+		{
+			ExplainPropertyFloat("Reduce Bandwidth", "MB/s",
+								 plan->reduce_bandwidth / (1024.0 * 1024.0), 1, es);
+			ExplainPropertyFloat("Reduce Latency", "ms",
+								 plan->reduce_latency, 3, es);
+		}
+	}
+}
 #endif /* ADB */
 
 /*
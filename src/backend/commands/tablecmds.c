@@ -1190,6 +1190,7 @@ DefineRelation(CreateStmt *stmt, char relkind, Oid ownerId,
 										   loc_type,
 										   &valuelist,
 										   &nodeoids);
+		valuelist = transformDistributeBuckets(loc_type, count, valuelist);
 
 		PgxcClassCreate(RelationGetRelid(rel),
 						loc_type,
@@ -3847,19 +3848,29 @@ renameatt_internal(Oid myrelid,
 	table_close(attrelation, RowExclusiveLock);
 
 #ifdef ADB
-	/* rename column of auxiliary relation */
+	/*
+	 * Rename column of auxiliary relations, the auxiliary column or INCLUDE
+	 * column, they match the master column by name.
+	 */
 	if (targetrelation->rd_auxlist)
 	{
-		Oid auxrelid = LookupAuxRelation(RelationGetRelid(targetrelation), attnum);
+		ListCell   *lc;
 
-		if (OidIsValid(auxrelid))
-			renameatt_internal(auxrelid,
-							   oldattname,
-							   newattname,
-							   recurse,
-							   recursing,
-							   0,
-							   behavior);
+		foreach (lc, targetrelation->rd_auxlist)
+		{
+			Oid auxrelid = lfirst_oid(lc);
+
+			if (get_attnum(auxrelid, oldattname) >= Anum_aux_table_key)
+				renameatt_internal(auxrelid,
+								   oldattname,
+								   newattname,
+								   recurse,
+								   recursing,
+								   0,
+								   behavior);
+		}
+		/* rd_auxinclude is built by names */
+		CacheInvalidateRelcache(targetrelation);
 	}
 #endif
 
@@ -6569,6 +6580,57 @@ ATAuxTableInternal(List **wqueue, Relation rel,
 					}
 				}
 				break;
+			case AT_AlterColumnType:
+				{
+					ListCell   *lc;
+
+					/*
+					 * INCLUDE columns follow the type of master column.  The
+					 * auxiliary table is padded again when the master is
+					 * rewritten, otherwise cast its own values.
+					 */
+					foreach (lc, rel->rd_auxlist)
+					{
+						AlterTableCmd  *auxcmd;
+						ColumnDef	   *def;
+						AttrNumber		auxattnum;
+						Oid				atttypid;
+						int32			atttypmod;
+						Oid				attcollid;
+						Oid				targettype;
+						int32			targettypmod;
+
+						auxrelid = lfirst_oid(lc);
+						auxattnum = get_attnum(auxrelid, cmd->name);
+						if (auxattnum <= Anum_aux_table_key)
+							continue;
+
+						/* USING of the master does not apply, cast explicitly */
+						auxcmd = copyObject(cmd);
+						def = castNode(ColumnDef, auxcmd->def);
+						get_atttypetypmodcoll(auxrelid, auxattnum,
+											  &atttypid, &atttypmod, &attcollid);
+						typenameTypeIdAndMod(NULL, def->typeName,
+											 &targettype, &targettypmod);
+						def->raw_default = NULL;
+						def->cooked_default =
+							coerce_to_target_type(NULL,
+												  (Node *) makeVar(1, auxattnum,
+																   atttypid, atttypmod,
+																   attcollid, 0),
+												  atttypid,
+												  targettype, targettypmod,
+												  COERCION_EXPLICIT,
+												  COERCE_EXPLICIT_CAST,
+												  -1);
+
+						auxrel = relation_open(auxrelid, lockmode);
+						CheckTableNotInUse(auxrel, "ALTER AUXILIARY TABLE");
+						ATPrepCmd(wqueue, auxrel, auxcmd, false, true, lockmode, context);
+						relation_close(auxrel, NoLock);
+					}
+				}
+				break;
 			case AT_SetLogged:
 			case AT_SetUnLogged:
 				{
@@ -12537,6 +12599,18 @@ ATExecAlterColumnType(AlteredTableInfo *tab, Relation rel,
 						 */
 						Assert(foundObject.objectSubId == 0);
 					}
+#ifdef ADB
+					else if (relKind == RELKIND_RELATION &&
+							 foundObject.objectSubId == 0 &&
+							 RelationIdIsAuxiliary(foundObject.objectId) &&
+							 get_attnum(foundObject.objectId, colName) > Anum_aux_table_key)
+					{
+						/*
+						 * The auxiliary table includes this column, it is
+						 * altered along, see ATAuxTableInternal.
+						 */
+					}
+#endif /* ADB */
 					else if (relKind == RELKIND_RELATION &&
 							 foundObject.objectSubId != 0 &&
 							 get_attgenerated(foundObject.objectId, foundObject.objectSubId))
@@ -16270,6 +16344,8 @@ BuildRedistribCommands(Oid relid, List *subCmds)
 	}
 	list_free(newLocInfo->nodeids);
 	newLocInfo->nodeids = NIL;
+	list_free(newLocInfo->buckets);
+	newLocInfo->buckets = NIL;
 
 	/* Get the list to be modified */
 	new_num = get_pgxc_classnodes(RelationGetRelid(rel), &new_oid_array);
@@ -0,0 +1,433 @@
+/*-------------------------------------------------------------------------
+ *
+ * clusterFunctionScan.c
+ *	  run a set-returning function on every node of the cluster
+ *
+ * adb_cluster_function() sends the function call to all other coordinators
+ * and datanodes at once, runs it locally while they work, and then collects
+ * the remote rows.  Every row is prefixed with the oid and name of the node
+ * it came from, so cluster-wide statistics views can be built on top of any
+ * local statistics function without a connection per node.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/tuptypeconvert.h"
+#include "catalog/pg_proc.h"
+#include "catalog/pg_type.h"
+#include "executor/clusterFunctionScan.h"
+#include "executor/clusterReceiver.h"
+#include "executor/execCluster.h"
+#include "executor/executor.h"
+#include "funcapi.h"
+#include "libpq/libpq.h"
+#include "libpq/libpq-fe.h"
+#include "libpq/libpq-node.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "pgxc/nodemgr.h"
+#include "pgxc/pgxc.h"
+#include "storage/mem_toc.h"
+#include "utils/acl.h"
+#include "utils/array.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/regproc.h"
+#include "utils/syscache.h"
+
+#define REMOTE_KEY_FUNCTION_SCAN_INFO	1
+
+/* number of columns we put in front of the function result */
+#define CLUSTER_FUNCTION_PREFIX_COLUMNS	2
+
+typedef struct ClusterFunctionRecvContext
+{
+	PQNHookFunctions	funcs;			/* must be first */
+	ClusterRecvState   *recv_state;
+	Tuplestorestate	   *tupstore;
+	TupleDesc			result_desc;
+	Datum			   *values;
+	bool			   *nulls;
+	Oid					last_node;
+	NameData			last_name;
+}ClusterFunctionRecvContext;
+
+static FuncExpr* make_cluster_function_expr(Oid funcid, ArrayType *args);
+static Tuplestorestate* exec_local_function(Expr *expr, TupleDesc desc, ExprContext *econtext);
+static void check_cluster_function_acl(Oid funcid);
+static void check_cluster_function_result(TupleDesc result_desc, TupleDesc func_desc, Oid funcid);
+static void put_node_tuple(ClusterFunctionRecvContext *context, TupleTableSlot *slot,
+						   Oid node_oid, const char *node_name);
+static bool process_remote_function_tuple(PQNHookFunctions *pub, struct pg_conn *conn, const char *buf, int len);
+
+Datum adb_cluster_function(PG_FUNCTION_ARGS)
+{
+	ReturnSetInfo		   *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	ClusterFunctionRecvContext context;
+	MemoryContext			per_query_ctx;
+	MemoryContext			oldcontext;
+	FuncExpr			   *expr;
+	TupleDesc				result_desc;
+	TupleDesc				func_desc;
+	TupleTableSlot		   *slot;
+	Tuplestorestate		   *local_store;
+	ExprContext			   *econtext;
+	List				   *list_conn = NIL;
+	Oid						funcid;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, &result_desc) != TYPEFUNC_COMPOSITE)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("a column definition list is required for adb_cluster_function")));
+
+	per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+	oldcontext = MemoryContextSwitchTo(per_query_ctx);
+	result_desc = CreateTupleDescCopy(result_desc);
+	MemSet(&context, 0, sizeof(context));
+	context.tupstore = tuplestore_begin_heap(true, false, work_mem);
+	context.result_desc = result_desc;
+	context.values = palloc(sizeof(Datum) * result_desc->natts);
+	context.nulls = palloc(sizeof(bool) * result_desc->natts);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = context.tupstore;
+	rsinfo->setDesc = result_desc;
+	MemoryContextSwitchTo(oldcontext);
+
+	if (PG_ARGISNULL(0))
+		return (Datum) 0;
+
+	funcid = PG_GETARG_OID(0);
+	expr = make_cluster_function_expr(funcid,
+									  PG_ARGISNULL(1) ? NULL : PG_GETARG_ARRAYTYPE_P(1));
+	if (get_expr_result_type((Node*)expr, NULL, &func_desc) != TYPEFUNC_COMPOSITE)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("function %s does not return a row type",
+						format_procedure(funcid))));
+	check_cluster_function_result(result_desc, func_desc, funcid);
+
+	/* start remote nodes first, they work while we run the local one */
+	if (IsCnMaster())
+	{
+		List		   *list_coord;
+		List		   *list_datanode;
+		List		   *rnodes;
+		StringInfoData	msg;
+
+		adb_get_all_node_oid_list(&list_coord, &list_datanode, false);
+		rnodes = list_concat(list_delete_oid(list_coord, PGXCNodeOid), list_datanode);
+
+		if (rnodes != NIL)
+		{
+			initStringInfo(&msg);
+			ClusterTocSetCustomFun(&msg, DoClusterFunctionScan);
+
+			begin_mem_toc_insert(&msg, REMOTE_KEY_FUNCTION_SCAN_INFO);
+			saveNode(&msg, (Node*)expr);
+			end_mem_toc_insert(&msg, REMOTE_KEY_FUNCTION_SCAN_INFO);
+
+			list_conn = ExecClusterCustomFunction(rnodes, &msg, EXEC_CLUSTER_FLAG_READ_ONLY);
+			pfree(msg.data);
+			list_free(rnodes);
+		}
+	}
+
+	/* local node */
+	econtext = CreateStandaloneExprContext();
+	slot = MakeSingleTupleTableSlot(func_desc, &TTSOpsMinimalTuple);
+	local_store = exec_local_function((Expr*)expr, func_desc, econtext);
+	if (local_store)
+	{
+		while (tuplestore_gettupleslot(local_store, true, false, slot))
+			put_node_tuple(&context, slot, PGXCNodeOid, PGXCNodeName);
+		tuplestore_end(local_store);
+	}
+
+	/* remote nodes */
+	if (list_conn != NIL)
+	{
+		context.funcs = PQNDefaultHookFunctions;
+		context.funcs.HookCopyOut = process_remote_function_tuple;
+		context.recv_state = createClusterRecvStateFromSlot(slot, false);
+		context.last_node = InvalidOid;
+		PQNListExecFinish(list_conn, NULL, &context.funcs, true);
+		freeClusterRecvState(context.recv_state);
+		list_free(list_conn);
+	}
+
+	ExecDropSingleTupleTableSlot(slot);
+	FreeExprContext(econtext, true);
+
+	return (Datum) 0;
+}
+
+void DoClusterFunctionScan(StringInfo mem_toc)
+{
+	MemoryContext			mcxt = AllocSetContextCreate(CurrentMemoryContext,
+														 "DoClusterFunctionScan",
+														 ALLOCSET_DEFAULT_SIZES);
+	MemoryContext			old_context = MemoryContextSwitchTo(mcxt);
+	Expr				   *expr;
+	ExprContext			   *econtext;
+	Tuplestorestate		   *tupstore;
+	TupleDesc				func_desc;
+	TupleTableSlot		   *slot;
+	TupleTableSlot		   *convert_slot;
+	TupleTypeConvert	   *convert;
+	StringInfoData			buf;
+
+	buf.data = mem_toc_lookup(mem_toc, REMOTE_KEY_FUNCTION_SCAN_INFO, &buf.len);
+	if (buf.data == NULL)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROTOCOL_VIOLATION),
+				 errmsg("Can not found function scan info")));
+	buf.maxlen = buf.len;
+	buf.cursor = 0;
+
+	expr = (Expr*)loadNode(&buf);
+	/* don't trust the sender, check the privilege on this node too */
+	check_cluster_function_acl(castNode(FuncExpr, expr)->funcid);
+	if (get_expr_result_type((Node*)expr, NULL, &func_desc) != TYPEFUNC_COMPOSITE)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("function does not return a row type")));
+
+	/* initialize message buffer */
+	initStringInfo(&buf);
+
+	slot = MakeSingleTupleTableSlot(func_desc, &TTSOpsMinimalTuple);
+	convert = create_type_convert(func_desc, true, false);
+	if (convert)
+	{
+		convert_slot = MakeSingleTupleTableSlot(convert->out_desc, &TTSOpsVirtual);
+		serialize_slot_convert_head(&buf, convert->out_desc);
+	}else
+	{
+		convert_slot = NULL;
+		serialize_slot_head_message(&buf, func_desc);
+	}
+	/* send tupedesc message */
+	pq_putmessage('d', buf.data, buf.len);
+
+	econtext = CreateStandaloneExprContext();
+	tupstore = exec_local_function(expr, func_desc, econtext);
+	if (tupstore)
+	{
+		while (tuplestore_gettupleslot(tupstore, true, false, slot))
+		{
+			CHECK_FOR_INTERRUPTS();
+			resetStringInfo(&buf);
+			if (convert)
+			{
+				do_type_convert_slot_out(convert, slot, convert_slot, false);
+				serialize_slot_message(&buf, convert_slot, CLUSTER_MSG_CONVERT_TUPLE);
+			}else
+			{
+				serialize_slot_message(&buf, slot, CLUSTER_MSG_TUPLE_DATA);
+			}
+			pq_putmessage('d', buf.data, buf.len);
+		}
+		tuplestore_end(tupstore);
+	}
+	pq_flush();
+
+	/* clean up */
+	if (convert)
+	{
+		free_type_convert(convert, true);
+		ExecDropSingleTupleTableSlot(convert_slot);
+	}
+	ExecDropSingleTupleTableSlot(slot);
+	FreeExprContext(econtext, true);
+	MemoryContextSwitchTo(old_context);
+	MemoryContextDelete(mcxt);
+}
+
+/*
+ * Build a call of function "funcid", each element of "args" is converted
+ * to the argument type by its input function, NULL elements stay NULL.
+ */
+static FuncExpr* make_cluster_function_expr(Oid funcid, ArrayType *args)
+{
+	HeapTuple		tup;
+	Form_pg_proc	proc;
+	FuncExpr	   *expr;
+	List		   *list_arg = NIL;
+	Datum		   *elems = NULL;
+	bool		   *elem_nulls = NULL;
+	int				nelems = 0;
+	int				i;
+
+	/* fail before any remote node is asked to run it */
+	check_cluster_function_acl(funcid);
+
+	tup = SearchSysCache1(PROCOID, ObjectIdGetDatum(funcid));
+	if (!HeapTupleIsValid(tup))
+		elog(ERROR, "cache lookup failed for function %u", funcid);
+	proc = (Form_pg_proc) GETSTRUCT(tup);
+
+	if (!proc->proretset)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("function %s does not return a set",
+						format_procedure(funcid))));
+
+	if (args != NULL)
+		deconstruct_array(args, TEXTOID, -1, false, 'i',
+						  &elems, &elem_nulls, &nelems);
+	if (nelems != proc->pronargs)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("function %s expects %d arguments, but %d given",
+						format_procedure(funcid), proc->pronargs, nelems)));
+
+	for (i=0;i<nelems;++i)
+	{
+		Oid		typid = proc->proargtypes.values[i];
+		Oid		typinput;
+		Oid		typioparam;
+		int16	typlen;
+		bool	typbyval;
+		Datum	value;
+
+		if (elem_nulls[i])
+		{
+			list_arg = lappend(list_arg, makeNullConst(typid, -1, get_typcollation(typid)));
+			continue;
+		}
+
+		getTypeInputInfo(typid, &typinput, &typioparam);
+		get_typlenbyval(typid, &typlen, &typbyval);
+		value = OidInputFunctionCall(typinput,
+									 TextDatumGetCString(elems[i]),
+									 typioparam,
+									 -1);
+		list_arg = lappend(list_arg, makeConst(typid,
+											   -1,
+											   get_typcollation(typid),
+											   typlen,
+											   value,
+											   false,
+											   typbyval));
+	}
+
+	expr = makeFuncExpr(funcid,
+						proc->prorettype,
+						list_arg,
+						InvalidOid,
+						InvalidOid,
+						COERCE_EXPLICIT_CALL);
+	expr->funcretset = true;
+	ReleaseSysCache(tup);
+
+	return expr;
+}
+
+static Tuplestorestate* exec_local_function(Expr *expr, TupleDesc desc, ExprContext *econtext)
+{
+	SetExprState   *setexpr;
+	MemoryContext	arg_context;
+	Tuplestorestate *tupstore;
+
+	arg_context = AllocSetContextCreate(CurrentMemoryContext,
+										"Cluster function arguments",
+										ALLOCSET_DEFAULT_SIZES);
+	setexpr = ExecInitTableFunctionResult(expr, econtext, NULL);
+	tupstore = ExecMakeTableFunctionResult(setexpr,
+										   econtext,
+										   arg_context,
+										   desc,
+										   false);
+	MemoryContextDelete(arg_context);
+
+	return tupstore;
+}
+
+static void check_cluster_function_acl(Oid funcid)
+{
+	AclResult	aclresult;
+
+	aclresult = pg_proc_aclcheck(funcid, GetUserId(), ACL_EXECUTE);
+	if (aclresult != ACLCHECK_OK)
+		aclcheck_error(aclresult, OBJECT_FUNCTION, get_func_name(funcid));
+}
+
+static void check_cluster_function_result(TupleDesc result_desc, TupleDesc func_desc, Oid funcid)
+{
+	int		i;
+
+	if (result_desc->natts != func_desc->natts + CLUSTER_FUNCTION_PREFIX_COLUMNS ||
+		TupleDescAttr(result_desc, 0)->atttypid != OIDOID ||
+		TupleDescAttr(result_desc, 1)->atttypid != NAMEOID)
+		ereport(ERROR,
+				(errcode(ERRCODE_DATATYPE_MISMATCH),
+				 errmsg("function return row and query-specified return row do not match"),
+				 errdetail("Returned row must be (oid, name) followed by the %d columns of function %s.",
+						   func_desc->natts, format_procedure(funcid))));
+
+	for (i=0;i<func_desc->natts;++i)
+	{
+		Form_pg_attribute attr = TupleDescAttr(func_desc, i);
+		Form_pg_attribute rattr = TupleDescAttr(result_desc, i + CLUSTER_FUNCTION_PREFIX_COLUMNS);
+
+		if (attr->atttypid != rattr->atttypid)
+			ereport(ERROR,
+					(errcode(ERRCODE_DATATYPE_MISMATCH),
+					 errmsg("function return row and query-specified return row do not match"),
+					 errdetail("Returned type %s at ordinal position %d, but query expects %s.",
+							   format_type_be(attr->atttypid),
+							   i + 1 + CLUSTER_FUNCTION_PREFIX_COLUMNS,
+							   format_type_be(rattr->atttypid))));
+	}
+}
+
+static void put_node_tuple(ClusterFunctionRecvContext *context, TupleTableSlot *slot,
+						   Oid node_oid, const char *node_name)
+{
+	int		natts = slot->tts_tupleDescriptor->natts;
+
+	slot_getallattrs(slot);
+	if (node_oid != context->last_node)
+	{
+		namestrcpy(&context->last_name, node_name);
+		context->last_node = node_oid;
+	}
+
+	context->values[0] = ObjectIdGetDatum(node_oid);
+	context->nulls[0] = false;
+	context->values[1] = NameGetDatum(&context->last_name);
+	context->nulls[1] = false;
+	memcpy(&context->values[CLUSTER_FUNCTION_PREFIX_COLUMNS], slot->tts_values, sizeof(Datum) * natts);
+	memcpy(&context->nulls[CLUSTER_FUNCTION_PREFIX_COLUMNS], slot->tts_isnull, sizeof(bool) * natts);
+
+	tuplestore_putvalues(context->tupstore, context->result_desc, context->values, context->nulls);
+}
+
+static bool process_remote_function_tuple(PQNHookFunctions *pub, struct pg_conn *conn, const char *buf, int len)
+{
+	ClusterFunctionRecvContext *context = (ClusterFunctionRecvContext*)pub;
+
+	if (clusterRecvTupleEx(context->recv_state, buf, len, conn))
+	{
+		Oid		node_oid = PQNConnectOid(conn);
+
+		put_node_tuple(context,
+					   context->recv_state->base_slot,
+					   node_oid,
+					   node_oid == context->last_node ? NameStr(context->last_name)
+													  : get_pgxc_nodename(node_oid));
+	}
+
+	return false;
+}
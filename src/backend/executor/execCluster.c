@@ -7,14 +7,17 @@
 #include "catalog/catalog.h"
 #include "catalog/namespace.h"
 #include "catalog/pg_class.h"
+#include "catalog/pg_proc.h"
 #include "catalog/pgxc_node.h"
 #include "commands/copy.h"
 #include "commands/defrem.h"
 #include "commands/matview.h"
 #include "commands/vacuum.h"
 #include "commands/cluster.h"
+#include "executor/clusterFunctionScan.h"
 #include "executor/clusterHeapScan.h"
 #include "executor/execdesc.h"
+#include "executor/execProfile.h"
 #include "executor/executor.h"
 #include "executor/nodeEmptyResult.h"
 #include "intercomm/inter-comm.h"
@@ -76,6 +79,7 @@
 typedef struct ClusterPlanContext
 {
 	bool transaction_read_only;		/* is read only plan */
+	bool have_volatile;				/* have volatile function, may modify data */
 	bool have_temp;					/* have temporary object */
 	bool have_reduce;				/* does this cluster plan have reduce node? */
 	bool start_self_reduce;			/* does this cluster plan need start self-reduce? */
@@ -177,6 +181,7 @@ static const ClusterCustomExecInfo cluster_custom_execute[] =
 		,{CLUSTER_CUSTOM_EXEC_FUNC(ClusterExpansionClean, CLUSTER_CUSTOM_NO_NEED_SEND_STAT)}
 		,{CLUSTER_CUSTOM_EXEC_FUNC(execClusterFinishActiveBackend, CLUSTER_CUSTOM_NO_NEED_SEND_STAT)}
 		,{CLUSTER_CUSTOM_EXEC_FUNC(cluster_reindex, CLUSTER_CUSTOM_NO_NEED_SEND_STAT)}
+		,{CLUSTER_CUSTOM_EXEC_FUNC(DoClusterFunctionScan, CLUSTER_CUSTOM_NO_NEED_SEND_STAT)}
 	};
 
 static void set_cluster_display(const char *activity, ClusterCoordInfo *info);
@@ -209,6 +214,8 @@ void exec_cluster_plan(const void *splan, int length)
 	SetupClusterErrorHook(&error_context_hook ADB_MULTI_GRAM_COMMA_ARG(&msg));
 	restore_cluster_plan_info(&msg);
 	info = RestoreCoordinatorInfo(&msg);
+	if (info)
+		ExecProfileSetCoordinator(info->pid, info->oid);
 	debug_query_string = RestoreDebugQueryString(&msg);
 	pgstat_report_activity(STATE_RUNNING,
 						   debug_query_string ? debug_query_string : "<cluster query>");
@@ -281,6 +288,7 @@ void exec_cluster_plan(const void *splan, int length)
 		Assert(ActiveSnapshotSet() == false);
 	}
 	EndClusterTransaction();
+	ExecProfileSetCoordinator(0, InvalidOid);
 
 	RestoreClusterHook(&error_context_hook);
 
@@ -720,6 +728,7 @@ static void SerializePlanInfo(StringInfo msg, PlannedStmt *stmt,
 	{
 		context->have_temp = false;
 		context->transaction_read_only = true;
+		context->have_volatile = false;
 		context->have_reduce = false;
 		context->start_self_reduce = false;
 	}
@@ -944,6 +953,18 @@ static bool SerializePlanHook(StringInfo buf, Node *node, void *context)
 				cpc->start_self_reduce = true;
 			}
 		}
+		break;
+	case T_FuncExpr:
+		if (context &&
+			func_volatile(((FuncExpr*)node)->funcid) == PROVOLATILE_VOLATILE)
+			((ClusterPlanContext*)context)->have_volatile = true;
+		break;
+	case T_OpExpr:
+		if (context &&
+			OidIsValid(((OpExpr*)node)->opfuncid) &&
+			func_volatile(((OpExpr*)node)->opfuncid) == PROVOLATILE_VOLATILE)
+			((ClusterPlanContext*)context)->have_volatile = true;
+		break;
 	default:
 		break;
 	}
@@ -1336,7 +1357,8 @@ static List* StartRemotePlan(StringInfo msg, List *rnodes, ClusterPlanContext *c
 	if (start_trans &&
 		!context->transaction_read_only)
 		state->need_xact_block = true;
-	InterXactBegin(state, rnodes);
+	InterXactBegin(state, rnodes,
+				   context->transaction_read_only && !context->have_volatile);
 	Assert(state->cur_handle);
 
 	error_context_hook.arg = NULL;
@@ -121,6 +121,7 @@
 #endif /* ADB_EXT */
 #ifdef ADB
 #include "pgxc/execRemote.h"
+#include "executor/execProfile.h"
 #include "executor/nodeClusterGather.h"
 #include "executor/nodeClusterMergeGather.h"
 #include "executor/nodeClusterReduce.h"
@@ -134,6 +135,9 @@
 
 static TupleTableSlot *ExecProcNodeFirst(PlanState *node);
 static TupleTableSlot *ExecProcNodeInstr(PlanState *node);
+#ifdef ADB
+static TupleTableSlot *ExecProcNodeProfile(PlanState *node);
+#endif /* ADB */
 
 
 /* ------------------------------------------------------------------------
@@ -503,6 +507,11 @@ ExecProcNodeFirst(PlanState *node)
 	 * does instrumentation.  Otherwise we can dispense with all wrappers and
 	 * have ExecProcNode() directly call the relevant function from now on.
 	 */
+#ifdef ADB
+	if (track_query_profile)
+		node->ExecProcNode = ExecProcNodeProfile;
+	else
+#endif /* ADB */
 	if (node->instrument)
 		node->ExecProcNode = ExecProcNodeInstr;
 	else
@@ -531,6 +540,27 @@ ExecProcNodeInstr(PlanState *node)
 	return result;
 }
 
+#ifdef ADB
+/*
+ * ExecProcNode wrapper that keeps the node on the plan node stack sampled
+ * by pg_query_profile(), only installed when track_query_profile is on.
+ */
+static TupleTableSlot *
+ExecProcNodeProfile(PlanState *node)
+{
+	TupleTableSlot *result;
+
+	ExecProfilePush(node);
+	if (node->instrument)
+		result = ExecProcNodeInstr(node);
+	else
+		result = node->ExecProcNodeReal(node);
+	ExecProfilePop();
+
+	return result;
+}
+#endif /* ADB */
+
 
 /* ----------------------------------------------------------------
  *		MultiExecProcNode
@@ -549,6 +579,9 @@ Node *
 MultiExecProcNode(PlanState *node)
 {
 	Node	   *result;
+#ifdef ADB
+	bool		profile = track_query_profile;	/* may change while we run */
+#endif /* ADB */
 
 	check_stack_depth();
 
@@ -557,6 +590,10 @@ MultiExecProcNode(PlanState *node)
 	if (node->chgParam != NULL) /* something changed */
 		ExecReScan(node);		/* let ReScan handle this */
 
+#ifdef ADB
+	if (profile)
+		ExecProfilePush(node);
+#endif /* ADB */
 	switch (nodeTag(node))
 	{
 			/*
@@ -590,6 +627,10 @@ MultiExecProcNode(PlanState *node)
 			result = NULL;
 			break;
 	}
+#ifdef ADB
+	if (profile)
+		ExecProfilePop();
+#endif /* ADB */
 
 	return result;
 }
@@ -0,0 +1,765 @@
+/*-------------------------------------------------------------------------
+ *
+ * execProfile.c
+ *	  sample the plan node stack of running backends
+ *
+ * With track_query_profile on, ExecProcNode() and MultiExecProcNode() keep
+ * the plan nodes that are currently being executed in ExecProfileStack.  A
+ * profiler asks a backend for a sample by bumping the request counter in the
+ * backend's slot and sending it PROCSIG_QUERY_PROFILE.  At its next
+ * CHECK_FOR_INTERRUPTS() the backend copies the plan nodes of its top-level
+ * query and the innermost named function of its C stack into the slot and
+ * wakes the profiler up.  The stack is taken there rather than in the signal
+ * handler, because backtrace() may allocate or load libgcc, neither of which
+ * is async-signal-safe; so the function reported is the one that noticed the
+ * request, i.e. the caller of CHECK_FOR_INTERRUPTS(), not the one the signal
+ * interrupted.
+ *
+ * Backends running a cluster plan remember the coordinator backend the
+ * plan came from, so pg_cluster_query_profile() can sample every backend
+ * working for one coordinator session on all nodes at once.
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#ifdef HAVE_EXECINFO_H
+#include <execinfo.h>
+#endif
+
+#include "catalog/pg_authid.h"
+#include "executor/execProfile.h"
+#include "executor/executor.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "pgstat.h"
+#include "pgxc/pgxc.h"
+#include "portability/instr_time.h"
+#include "storage/latch.h"
+#include "storage/proc.h"
+#include "storage/procarray.h"
+#include "storage/procsignal.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "utils/acl.h"
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+
+#define QUERY_PROFILE_MAX_NODES		32
+#define QUERY_PROFILE_COLS			7
+
+typedef struct QueryProfileSlot
+{
+	slock_t		mutex;
+	int			pid;			/* owner, 0 if the slot is unused */
+	int			coord_pid;		/* coordinator backend of the cluster plan */
+	Oid			coord_oid;		/* coordinator node of the cluster plan */
+
+	/* request and response of one sample */
+	int			requester_pid;	/* profiler, 0 if nobody samples us */
+	PGPROC	   *requester;
+	uint32		request;
+	uint32		response;
+
+	/* last sample, only valid when response == request */
+	int			nnodes;
+	int			node_id[QUERY_PROFILE_MAX_NODES];	/* outermost first */
+	NodeTag		node_tag[QUERY_PROFILE_MAX_NODES];
+	char		function[NAMEDATALEN];
+} QueryProfileSlot;
+
+typedef struct QueryProfileTarget
+{
+	int			pid;
+	QueryProfileSlot *slot;
+	uint32		request;		/* request we are waiting for */
+	bool		answered;
+	bool		gone;
+} QueryProfileTarget;
+
+typedef struct QueryProfileKey
+{
+	int			pid;
+	int			plan_node_id;	/* -1 for a function entry */
+	char		name[NAMEDATALEN];
+} QueryProfileKey;
+
+typedef struct QueryProfileEntry
+{
+	QueryProfileKey key;
+	int64		self_samples;
+	int64		total_samples;
+} QueryProfileEntry;
+
+bool		track_query_profile = false;
+
+PlanState  *ExecProfileStack[EXEC_PROFILE_MAX_DEPTH];
+int			ExecProfileDepth = 0;
+
+volatile sig_atomic_t QueryProfilePending = false;
+
+static QueryProfileSlot *QueryProfileSlots = NULL;
+
+static QueryProfileSlot *MyQueryProfileSlot(void);
+static void profile_top_function(char *name);
+static void profile_check_permission(PGPROC *proc);
+static void profile_claim_targets(QueryProfileTarget *targets, int ntargets);
+static void profile_release_targets(QueryProfileTarget *targets, int ntargets);
+static void profile_count(HTAB *htab, int pid, int plan_node_id,
+						  const char *name, bool self);
+static void profile_collect(QueryProfileTarget *targets, int ntargets,
+							int samples, int interval_ms, HTAB *htab);
+static void profile_return_result(FunctionCallInfo fcinfo, HTAB *htab,
+								  int interval_ms);
+static void profile_run(FunctionCallInfo fcinfo, QueryProfileTarget *targets,
+						int ntargets, int samples, int interval_ms);
+static const char *profile_node_name(NodeTag tag);
+
+Size
+QueryProfileShmemSize(void)
+{
+	return mul_size(MaxBackends, sizeof(QueryProfileSlot));
+}
+
+void
+QueryProfileShmemInit(void)
+{
+	bool		found;
+	int			i;
+
+	QueryProfileSlots = ShmemInitStruct("Query Profile Slots",
+										QueryProfileShmemSize(),
+										&found);
+	if (!found)
+	{
+		MemSet(QueryProfileSlots, 0, QueryProfileShmemSize());
+		for (i = 0; i < MaxBackends; i++)
+			SpinLockInit(&QueryProfileSlots[i].mutex);
+	}
+}
+
+static QueryProfileSlot *
+MyQueryProfileSlot(void)
+{
+	if (QueryProfileSlots == NULL ||
+		MyBackendId == InvalidBackendId)
+		return NULL;
+	Assert(MyBackendId >= 1 && MyBackendId <= MaxBackends);
+	return &QueryProfileSlots[MyBackendId - 1];
+}
+
+/*
+ * Remember which coordinator backend the cluster plan we are about to run
+ * belongs to, pass 0 and InvalidOid when it finished.
+ */
+void
+ExecProfileSetCoordinator(int coord_pid, Oid coord_oid)
+{
+	QueryProfileSlot *slot = MyQueryProfileSlot();
+
+	if (slot == NULL)
+		return;
+
+	SpinLockAcquire(&slot->mutex);
+	slot->pid = MyProcPid;
+	slot->coord_pid = coord_pid;
+	slot->coord_oid = coord_oid;
+	SpinLockRelease(&slot->mutex);
+}
+
+/*
+ * The plan nodes above the error are gone, forget them.
+ */
+void
+AtAbort_ExecProfile(void)
+{
+	ExecProfileDepth = 0;
+	ExecProfileSetCoordinator(0, InvalidOid);
+}
+
+/*
+ * Called from procsignal_sigusr1_handler.  Nothing but setting flags is safe
+ * here, the sample is taken in ProcessQueryProfileInterrupt.
+ */
+void
+HandleQueryProfileInterrupt(void)
+{
+	InterruptPending = true;
+	QueryProfilePending = true;
+	/* latch will be set by procsignal_sigusr1_handler */
+}
+
+void
+ProcessQueryProfileInterrupt(void)
+{
+	QueryProfileSlot *slot = MyQueryProfileSlot();
+	EState	   *estate = NULL;
+	PGPROC	   *requester = NULL;
+	char		function[NAMEDATALEN];
+	int			depth;
+	int			i;
+
+	QueryProfilePending = false;
+	if (slot == NULL)
+		return;
+
+	profile_top_function(function);
+
+	depth = Min(ExecProfileDepth, EXEC_PROFILE_MAX_DEPTH);
+
+	SpinLockAcquire(&slot->mutex);
+	if (slot->request != slot->response)
+	{
+		/* only the nodes of the top-level query */
+		slot->nnodes = 0;
+		for (i = 0; i < depth && slot->nnodes < QUERY_PROFILE_MAX_NODES; i++)
+		{
+			PlanState  *ps = ExecProfileStack[i];
+
+			if (estate == NULL)
+				estate = ps->state;
+			else if (ps->state != estate)
+				continue;
+			slot->node_id[slot->nnodes] = ps->plan->plan_node_id;
+			slot->node_tag[slot->nnodes] = nodeTag(ps->plan);
+			slot->nnodes++;
+		}
+		strlcpy(slot->function, function, NAMEDATALEN);
+		slot->response = slot->request;
+		requester = slot->requester;
+	}
+	SpinLockRelease(&slot->mutex);
+
+	if (requester != NULL)
+		SetLatch(&requester->procLatch);
+}
+
+/*
+ * Innermost function with an exported name on our C stack below the
+ * interrupt processing, static functions can not be resolved by
+ * backtrace_symbols().
+ */
+static void
+profile_top_function(char *name)
+{
+#ifdef HAVE_BACKTRACE_SYMBOLS
+	void	   *frames[32];
+	char	  **symbols;
+	int			nframes;
+	int			i;
+
+	name[0] = '\0';
+	nframes = backtrace(frames, lengthof(frames));
+	if (nframes <= 0)
+		return;
+	symbols = backtrace_symbols(frames, nframes);
+	if (symbols == NULL)
+		return;
+
+	for (i = 0; i < nframes; i++)
+	{
+		/* looks like "postgres(ExecScan+0x42) [0x55d1c4c0f0e2]" */
+		char	   *start = strchr(symbols[i], '(');
+		char	   *end;
+
+		if (start == NULL)
+			continue;
+		start++;
+		end = start + strcspn(start, "+)");
+		if (end == start)
+			continue;
+		*end = '\0';
+		if (strcmp(start, "ProcessQueryProfileInterrupt") == 0 ||
+			strcmp(start, "ProcessInterrupts") == 0)
+			continue;
+		strlcpy(name, start, NAMEDATALEN);
+		break;
+	}
+	free(symbols);
+#else
+	strlcpy(name, "<unknown>", NAMEDATALEN);
+#endif							/* HAVE_BACKTRACE_SYMBOLS */
+}
+
+static void
+profile_check_permission(PGPROC *proc)
+{
+	if (!superuser() &&
+		!is_member_of_role(GetUserId(), DEFAULT_ROLE_READ_ALL_STATS) &&
+		!has_privs_of_role(GetUserId(), proc->roleId))
+		ereport(ERROR,
+				(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+				 errmsg("must be a member of the role whose process is being profiled or member of pg_read_all_stats")));
+}
+
+static void
+profile_claim_targets(QueryProfileTarget *targets, int ntargets)
+{
+	int			i;
+
+	for (i = 0; i < ntargets; i++)
+	{
+		QueryProfileSlot *slot = targets[i].slot;
+		int			other;
+
+		SpinLockAcquire(&slot->mutex);
+		other = slot->requester_pid;
+		if (other == 0 || BackendPidGetProc(other) == NULL)
+		{
+			slot->requester_pid = MyProcPid;
+			slot->requester = MyProc;
+			other = 0;
+		}
+		SpinLockRelease(&slot->mutex);
+
+		if (other != 0)
+		{
+			profile_release_targets(targets, i);
+			ereport(ERROR,
+					(errcode(ERRCODE_OBJECT_IN_USE),
+					 errmsg("process %d is already being profiled by process %d",
+							targets[i].pid, other)));
+		}
+	}
+}
+
+static void
+profile_release_targets(QueryProfileTarget *targets, int ntargets)
+{
+	int			i;
+
+	for (i = 0; i < ntargets; i++)
+	{
+		QueryProfileSlot *slot = targets[i].slot;
+
+		SpinLockAcquire(&slot->mutex);
+		if (slot->requester_pid == MyProcPid)
+		{
+			slot->requester_pid = 0;
+			slot->requester = NULL;
+		}
+		SpinLockRelease(&slot->mutex);
+	}
+}
+
+static void
+profile_count(HTAB *htab, int pid, int plan_node_id, const char *name, bool self)
+{
+	QueryProfileKey key;
+	QueryProfileEntry *entry;
+	bool		found;
+
+	MemSet(&key, 0, sizeof(key));
+	key.pid = pid;
+	key.plan_node_id = plan_node_id;
+	strlcpy(key.name, name, NAMEDATALEN);
+
+	entry = hash_search(htab, &key, HASH_ENTER, &found);
+	if (!found)
+		entry->self_samples = entry->total_samples = 0;
+	if (self)
+		entry->self_samples++;
+	entry->total_samples++;
+}
+
+/*
+ * Take samples from all targets at once, one round every interval_ms.
+ * Targets that do not answer within the interval are counted as
+ * "<no response>", they are busy outside CHECK_FOR_INTERRUPTS().
+ */
+static void
+profile_collect(QueryProfileTarget *targets, int ntargets,
+				int samples, int interval_ms, HTAB *htab)
+{
+	int			n;
+	int			i;
+	int			j;
+
+	for (n = 0; n < samples; n++)
+	{
+		instr_time	start;
+		instr_time	now;
+		long		remain;
+
+		INSTR_TIME_SET_CURRENT(start);
+		for (i = 0; i < ntargets; i++)
+		{
+			QueryProfileTarget *target = &targets[i];
+
+			if (target->gone)
+				continue;
+			SpinLockAcquire(&target->slot->mutex);
+			target->request = ++target->slot->request;
+			SpinLockRelease(&target->slot->mutex);
+			target->answered = false;
+			if (SendProcSignal(target->pid, PROCSIG_QUERY_PROFILE,
+							   (target->slot - QueryProfileSlots) + 1) != 0)
+				target->gone = true;
+		}
+
+		/* once everybody answered, sleep out the rest of the interval */
+		for (;;)
+		{
+			for (i = 0; i < ntargets; i++)
+			{
+				QueryProfileTarget *target = &targets[i];
+				QueryProfileSlot *slot = target->slot;
+				int			nnodes;
+				int			node_id[QUERY_PROFILE_MAX_NODES];
+				NodeTag		node_tag[QUERY_PROFILE_MAX_NODES];
+				char		function[NAMEDATALEN];
+
+				if (target->gone || target->answered)
+					continue;
+
+				SpinLockAcquire(&slot->mutex);
+				if (slot->response != target->request)
+				{
+					SpinLockRelease(&slot->mutex);
+					continue;
+				}
+				nnodes = slot->nnodes;
+				memcpy(node_id, slot->node_id, sizeof(int) * nnodes);
+				memcpy(node_tag, slot->node_tag, sizeof(NodeTag) * nnodes);
+				strlcpy(function, slot->function, NAMEDATALEN);
+				SpinLockRelease(&slot->mutex);
+
+				target->answered = true;
+				for (j = 0; j < nnodes; j++)
+				{
+					int			k;
+
+					/* count recursive nodes once per sample */
+					for (k = j + 1; k < nnodes; k++)
+						if (node_id[k] == node_id[j])
+							break;
+					if (k < nnodes)
+						continue;
+					profile_count(htab, target->pid, node_id[j],
+								  profile_node_name(node_tag[j]),
+								  j == nnodes - 1);
+				}
+				profile_count(htab, target->pid, -1,
+							  function[0] ? function : "<unknown>", true);
+			}
+
+			INSTR_TIME_SET_CURRENT(now);
+			INSTR_TIME_SUBTRACT(now, start);
+			remain = interval_ms - (long) INSTR_TIME_GET_MILLISEC(now);
+			if (remain <= 0)
+				break;
+
+			(void) WaitLatch(MyLatch,
+							 WL_LATCH_SET | WL_TIMEOUT | WL_EXIT_ON_PM_DEATH,
+							 remain,
+							 WAIT_EVENT_PG_SLEEP);
+			ResetLatch(MyLatch);
+			CHECK_FOR_INTERRUPTS();
+		}
+
+		for (i = 0; i < ntargets; i++)
+		{
+			if (!targets[i].gone && !targets[i].answered)
+				profile_count(htab, targets[i].pid, -1, "<no response>", true);
+		}
+	}
+}
+
+static void
+profile_return_result(FunctionCallInfo fcinfo, HTAB *htab, int interval_ms)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcontext;
+	HASH_SEQ_STATUS status;
+	QueryProfileEntry *entry;
+	Datum		values[QUERY_PROFILE_COLS];
+	bool		nulls[QUERY_PROFILE_COLS];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	hash_seq_init(&status, htab);
+	while ((entry = hash_seq_search(&status)) != NULL)
+	{
+		MemSet(nulls, 0, sizeof(nulls));
+		values[0] = Int32GetDatum(entry->key.pid);
+		if (entry->key.plan_node_id < 0)
+		{
+			values[1] = CStringGetTextDatum("function");
+			nulls[2] = true;
+		}
+		else
+		{
+			values[1] = CStringGetTextDatum("node");
+			values[2] = Int32GetDatum(entry->key.plan_node_id);
+		}
+		values[3] = CStringGetTextDatum(entry->key.name);
+		values[4] = Int64GetDatum(entry->self_samples);
+		values[5] = Int64GetDatum(entry->total_samples);
+		values[6] = Float8GetDatum((double) entry->self_samples * interval_ms);
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+}
+
+static void
+profile_run(FunctionCallInfo fcinfo, QueryProfileTarget *targets, int ntargets,
+			int samples, int interval_ms)
+{
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	HASHCTL		ctl;
+	HTAB	   *htab;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (samples <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of samples must be greater than zero")));
+	if (interval_ms <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("sample interval must be greater than zero")));
+
+	MemSet(&ctl, 0, sizeof(ctl));
+	ctl.keysize = sizeof(QueryProfileKey);
+	ctl.entrysize = sizeof(QueryProfileEntry);
+	ctl.hcxt = CurrentMemoryContext;
+	htab = hash_create("query profile", 64, &ctl,
+					   HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+	profile_claim_targets(targets, ntargets);
+	PG_TRY();
+	{
+		profile_collect(targets, ntargets, samples, interval_ms, htab);
+	}
+	PG_FINALLY();
+	{
+		profile_release_targets(targets, ntargets);
+	}
+	PG_END_TRY();
+
+	profile_return_result(fcinfo, htab, interval_ms);
+	hash_destroy(htab);
+}
+
+/*
+ * pg_query_profile(pid, samples, interval_ms)
+ *		sample the plan nodes and functions of one local backend
+ */
+Datum
+pg_query_profile(PG_FUNCTION_ARGS)
+{
+	int			pid = PG_GETARG_INT32(0);
+	QueryProfileTarget target;
+	PGPROC	   *proc;
+
+	proc = BackendPidGetProc(pid);
+	if (proc == NULL || proc->backendId == InvalidBackendId)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("PID %d is not a PostgreSQL server process", pid)));
+	if (pid == MyProcPid)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("can not profile the current process")));
+	profile_check_permission(proc);
+
+	MemSet(&target, 0, sizeof(target));
+	target.pid = pid;
+	target.slot = &QueryProfileSlots[proc->backendId - 1];
+
+	profile_run(fcinfo, &target, 1, PG_GETARG_INT32(1), PG_GETARG_INT32(2));
+
+	return (Datum) 0;
+}
+
+/*
+ * pg_query_profile_coord(coord_oid, coord_pid, samples, interval_ms)
+ *		sample all local backends running a cluster plan for the given
+ *		coordinator backend, and that backend itself when it is local
+ */
+Datum
+pg_query_profile_coord(PG_FUNCTION_ARGS)
+{
+	Oid			coord_oid = PG_GETARG_OID(0);
+	int			coord_pid = PG_GETARG_INT32(1);
+	QueryProfileTarget *targets;
+	int			ntargets = 0;
+	int			i;
+
+	targets = palloc0(sizeof(QueryProfileTarget) * MaxBackends);
+	for (i = 0; i < MaxBackends; i++)
+	{
+		QueryProfileSlot *slot = &QueryProfileSlots[i];
+		int			pid;
+
+		SpinLockAcquire(&slot->mutex);
+		pid = slot->pid;
+		if (slot->coord_pid != coord_pid || slot->coord_oid != coord_oid)
+			pid = 0;
+		SpinLockRelease(&slot->mutex);
+
+		if (pid == 0 || pid == MyProcPid)
+			continue;
+		targets[ntargets].pid = pid;
+		targets[ntargets].slot = slot;
+		ntargets++;
+	}
+
+	if (coord_oid == PGXCNodeOid && coord_pid != MyProcPid)
+	{
+		PGPROC	   *proc = BackendPidGetProc(coord_pid);
+
+		if (proc != NULL && proc->backendId != InvalidBackendId)
+		{
+			targets[ntargets].pid = coord_pid;
+			targets[ntargets].slot = &QueryProfileSlots[proc->backendId - 1];
+			ntargets++;
+		}
+	}
+
+	for (i = 0; i < ntargets; i++)
+	{
+		PGPROC	   *proc = BackendPidGetProc(targets[i].pid);
+
+		if (proc == NULL)
+			targets[i].gone = true;
+		else
+			profile_check_permission(proc);
+	}
+
+	profile_run(fcinfo, targets, ntargets, PG_GETARG_INT32(2), PG_GETARG_INT32(3));
+	pfree(targets);
+
+	return (Datum) 0;
+}
+
+/* names as shown by EXPLAIN */
+static const char *
+profile_node_name(NodeTag tag)
+{
+	switch (tag)
+	{
+		case T_Result:
+			return "Result";
+		case T_ProjectSet:
+			return "ProjectSet";
+		case T_ModifyTable:
+			return "ModifyTable";
+		case T_Append:
+			return "Append";
+		case T_MergeAppend:
+			return "Merge Append";
+		case T_RecursiveUnion:
+			return "Recursive Union";
+		case T_BitmapAnd:
+			return "BitmapAnd";
+		case T_BitmapOr:
+			return "BitmapOr";
+		case T_NestLoop:
+			return "Nested Loop";
+		case T_MergeJoin:
+			return "Merge Join";
+		case T_HashJoin:
+			return "Hash Join";
+		case T_SeqScan:
+			return "Seq Scan";
+		case T_SampleScan:
+			return "Sample Scan";
+		case T_Gather:
+			return "Gather";
+		case T_GatherMerge:
+			return "Gather Merge";
+		case T_IndexScan:
+			return "Index Scan";
+		case T_IndexOnlyScan:
+			return "Index Only Scan";
+		case T_BitmapIndexScan:
+			return "Bitmap Index Scan";
+		case T_BitmapHeapScan:
+			return "Bitmap Heap Scan";
+		case T_TidScan:
+			return "Tid Scan";
+		case T_SubqueryScan:
+			return "Subquery Scan";
+		case T_FunctionScan:
+			return "Function Scan";
+		case T_TableFuncScan:
+			return "Table Function Scan";
+		case T_ValuesScan:
+			return "Values Scan";
+		case T_CteScan:
+			return "CTE Scan";
+		case T_NamedTuplestoreScan:
+			return "Named Tuplestore Scan";
+		case T_WorkTableScan:
+			return "WorkTable Scan";
+		case T_RemoteQuery:
+			return "Data Node Scan";
+		case T_ClusterGather:
+			return "Cluster Gather";
+		case T_ClusterMergeGather:
+			return "Cluster Merge Gather";
+		case T_ClusterReduce:
+			return "Cluster Reduce";
+		case T_ReduceScan:
+			return "Reduce Scan";
+		case T_ParamTuplestoreScan:
+			return "Param Tuplestore Scan";
+		case T_EmptyResult:
+			return "Empty Result";
+		case T_ForeignScan:
+			return "Foreign Scan";
+		case T_CustomScan:
+			return "Custom Scan";
+		case T_Material:
+			return "Materialize";
+		case T_Sort:
+			return "Sort";
+#ifdef ADB_EXT
+		case T_BatchSort:
+			return "BatchSort";
+#endif
+		case T_IncrementalSort:
+			return "Incremental Sort";
+		case T_Group:
+			return "Group";
+		case T_Agg:
+			return "Aggregate";
+		case T_WindowAgg:
+			return "WindowAgg";
+		case T_Unique:
+			return "Unique";
+		case T_SetOp:
+			return "SetOp";
+		case T_LockRows:
+			return "LockRows";
+		case T_Limit:
+			return "Limit";
+		case T_Hash:
+			return "Hash";
+#ifdef ADB_GRAM_ORA
+		case T_ConnectByPlan:
+			return "Connect By";
+#endif
+		default:
+			return "???";
+	}
+}
@@ -21,9 +21,15 @@ BufferUsage pgBufferUsage;
 static BufferUsage save_pgBufferUsage;
 WalUsage	pgWalUsage;
 static WalUsage save_pgWalUsage;
+#ifdef ADB
+ClusterUsage pgClusterUsage;
+#endif /* ADB */
 
 static void BufferUsageAdd(BufferUsage *dst, const BufferUsage *add);
 static void WalUsageAdd(WalUsage *dst, WalUsage *add);
+#ifdef ADB
+static void ClusterUsageAdd(ClusterUsage *dst, const ClusterUsage *add);
+#endif /* ADB */
 
 
 /* Allocate new instrumentation structure(s) */
@@ -34,11 +40,14 @@ InstrAlloc(int n, int instrument_options)
 
 	/* initialize all fields to zeroes, then modify as needed */
 	instr = palloc0(n * sizeof(Instrumentation));
-	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL))
+	if (instrument_options & (INSTRUMENT_BUFFERS | INSTRUMENT_TIMER | INSTRUMENT_WAL ADB_ONLY_CODE(| INSTRUMENT_CLUSTER)))
 	{
 		bool		need_buffers = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 		bool		need_wal = (instrument_options & INSTRUMENT_WAL) != 0;
 		bool		need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
+#ifdef ADB
+		bool		need_cluster = (instrument_options & INSTRUMENT_CLUSTER) != 0;
+#endif /* ADB */
 		int			i;
 
 		for (i = 0; i < n; i++)
@@ -46,6 +55,9 @@ InstrAlloc(int n, int instrument_options)
 			instr[i].need_bufusage = need_buffers;
 			instr[i].need_walusage = need_wal;
 			instr[i].need_timer = need_timer;
+#ifdef ADB
+			instr[i].need_clusterusage = need_cluster;
+#endif /* ADB */
 		}
 	}
 
@@ -60,6 +72,9 @@ InstrInit(Instrumentation *instr, int instrument_options)
 	instr->need_bufusage = (instrument_options & INSTRUMENT_BUFFERS) != 0;
 	instr->need_walusage = (instrument_options & INSTRUMENT_WAL) != 0;
 	instr->need_timer = (instrument_options & INSTRUMENT_TIMER) != 0;
+#ifdef ADB
+	instr->need_clusterusage = (instrument_options & INSTRUMENT_CLUSTER) != 0;
+#endif /* ADB */
 }
 
 /* Entry to a plan node */
@@ -76,6 +91,11 @@ InstrStartNode(Instrumentation *instr)
 
 	if (instr->need_walusage)
 		instr->walusage_start = pgWalUsage;
+
+#ifdef ADB
+	if (instr->need_clusterusage)
+		instr->clusterusage_start = pgClusterUsage;
+#endif /* ADB */
 }
 
 /* Exit from a plan node */
@@ -108,6 +128,12 @@ InstrStopNode(Instrumentation *instr, double nTuples)
 		WalUsageAccumDiff(&instr->walusage,
 						  &pgWalUsage, &instr->walusage_start);
 
+#ifdef ADB
+	if (instr->need_clusterusage)
+		ClusterUsageAccumDiff(&instr->clusterusage,
+							  &pgClusterUsage, &instr->clusterusage_start);
+#endif /* ADB */
+
 	/* Is this the first tuple of this cycle? */
 	if (!instr->running)
 	{
@@ -174,6 +200,11 @@ InstrAggNode(Instrumentation *dst, Instrumentation *add)
 
 	if (dst->need_walusage)
 		WalUsageAdd(&dst->walusage, &add->walusage);
+
+#ifdef ADB
+	if (dst->need_clusterusage)
+		ClusterUsageAdd(&dst->clusterusage, &add->clusterusage);
+#endif /* ADB */
 }
 
 /* note current values during parallel executor startup */
@@ -258,3 +289,26 @@ WalUsageAccumDiff(WalUsage *dst, const WalUsage *add, const WalUsage *sub)
 	dst->wal_records += add->wal_records - sub->wal_records;
 	dst->wal_fpi += add->wal_fpi - sub->wal_fpi;
 }
+
+#ifdef ADB
+static void
+ClusterUsageAdd(ClusterUsage *dst, const ClusterUsage *add)
+{
+	INSTR_TIME_ADD(dst->remote_wait_time, add->remote_wait_time);
+	INSTR_TIME_ADD(dst->reduce_wait_time, add->reduce_wait_time);
+	INSTR_TIME_ADD(dst->gtm_wait_time, add->gtm_wait_time);
+}
+
+void
+ClusterUsageAccumDiff(ClusterUsage *dst,
+					  const ClusterUsage *add,
+					  const ClusterUsage *sub)
+{
+	INSTR_TIME_ACCUM_DIFF(dst->remote_wait_time,
+						  add->remote_wait_time, sub->remote_wait_time);
+	INSTR_TIME_ACCUM_DIFF(dst->reduce_wait_time,
+						  add->reduce_wait_time, sub->reduce_wait_time);
+	INSTR_TIME_ACCUM_DIFF(dst->gtm_wait_time,
+						  add->gtm_wait_time, sub->gtm_wait_time);
+}
+#endif /* ADB */
@@ -225,7 +225,8 @@ BitmapHeapNext(BitmapHeapScanState *node)
 			/* after expand activate, before expand clean, the page maybe visinle,
 			 * so it should read the tuple by bitgetpage	
 			 */
-			if (skip_fetch && unlikely(scan->rs_rd->rd_clean))
+			if (skip_fetch && unlikely(scan->rs_rd->rd_clean) &&
+				NeedTestExpansionCleanBlock(scan->rs_rd->rd_clean, tbmres->blockno))
 				skip_fetch = false;
 #endif
 			if (skip_fetch)
@@ -57,6 +57,8 @@ typedef struct NestConnectByState
 	uint32			input_rownum_index;
 	int				hash_reader;
 	bool			inner_ateof;
+	bool			outer_chain_copied;
+	ArrayType	   *outer_chain;	/* detoasted rownum chain of outer row */
 }NestConnectByState;
 
 typedef struct HashConnectByState
@@ -74,6 +76,8 @@ typedef struct HashConnectByState
 	uint32			cur_hashvalue;
 	uint32			input_rownum_index;
 	bool			inner_ateof;
+	bool			outer_chain_copied;
+	ArrayType	   *outer_chain;	/* detoasted rownum chain of outer row */
 }HashConnectByState;
 
 typedef struct TuplestoreConnectByLeaf
@@ -388,6 +392,26 @@ ConnectByState* ExecInitConnectBy(ConnectByPlan *node, EState *estate, int eflag
 	return cbstate;
 }
 
+/*
+ * Detoast rownum chain of a new outer row. A short chain is stored with
+ * 1-byte header in tuplestore, detoast it once, not for each inner row.
+ */
+static ArrayType* LoadOuterRownumChain(TupleTableSlot *outer_slot, AttrNumber attno,
+									   ArrayType *last, bool *copied)
+{
+	ArrayType  *arr;
+	Datum		datum;
+
+	if (*copied)
+		pfree(last);
+
+	datum = outer_slot->tts_values[attno-1];
+	arr = DatumGetArrayTypeP(datum);
+	*copied = ((Pointer) arr != DatumGetPointer(datum));
+
+	return arr;
+}
+
 static bool Int64InArray(ArrayType *arr, int64 v)
 {
 	int i;
@@ -481,6 +505,10 @@ re_get_tuplestore_connect_by_:
 		state->inner_ateof = false;
 		slot_getsomeattrs(outer_slot, cbstate->rownum_chain_attr);
 		Assert(outer_slot->tts_isnull[cbstate->rownum_chain_attr-1] == false);
+		state->outer_chain = LoadOuterRownumChain(outer_slot,
+												  cbstate->rownum_chain_attr,
+												  state->outer_chain,
+												  &state->outer_chain_copied);
 	}
 
 	for(;;)
@@ -498,7 +526,7 @@ re_get_tuplestore_connect_by_:
 		{
 			/* cycle check, but skip limit level */
 			if (!limit_level &&
-				Int64InArray(DatumGetArrayTypeP(outer_slot->tts_values[cbstate->rownum_chain_attr-1]),
+				Int64InArray(state->outer_chain,
 							 DatumGetInt64(inner_slot->tts_values[state->input_rownum_index])))
 			{
 				if (castNode(ConnectByPlan, cbstate->ps.plan)->no_cycle == false)
@@ -756,6 +784,10 @@ reget_hash_connect_by_:
 		state->cur_tuple = NULL;
 		slot_getsomeattrs(outer_slot, cbstate->rownum_chain_attr);
 		Assert(outer_slot->tts_isnull[cbstate->rownum_chain_attr-1] == false);
+		state->outer_chain = LoadOuterRownumChain(outer_slot,
+												  cbstate->rownum_chain_attr,
+												  state->outer_chain,
+												  &state->outer_chain_copied);
 	}
 
 	econtext->ecxt_innertuple = inner_slot;
@@ -782,7 +814,7 @@ reget_hash_connect_by_:
 	/* check is cycle */
 	slot_getsomeattrs(inner_slot, state->input_rownum_index+1);
 	Assert(inner_slot->tts_isnull[state->input_rownum_index] == false);
-	if (Int64InArray(DatumGetArrayTypeP(outer_slot->tts_values[cbstate->rownum_chain_attr-1]),
+	if (Int64InArray(state->outer_chain,
 					 DatumGetInt64(inner_slot->tts_values[state->input_rownum_index])))
 	{
 		if (no_cycle == false)
@@ -328,7 +328,15 @@ HandleBegin(InterXactState state, NodeHandle *handle,
 	if (!HandleSendBegin(handle, xid, timestamp, need_xact_block, already_begin))
 		return 0;
 
-	if (*already_begin || !need_xact_block)
+	if (*already_begin)
+	{
+		/* the node may be modified by the current query */
+		if (!state->cur_read_only)
+			InterXactSaveBeginNodes(state, handle->node_id);
+		return 1;
+	}
+
+	if (!need_xact_block)
 		return 1;
 
 	if (HandleFinishCommand(handle, TRANS_START_TAG))
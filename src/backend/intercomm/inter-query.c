@@ -25,6 +25,7 @@
 #include "intercomm/inter-comm.h"
 #include "libpq-int.h"
 #include "nodes/nodeFuncs.h"
+#include "pgstat.h"
 #include "utils/snapmgr.h"
 
 #define REMOTE_FETCH_SIZE	64
@@ -570,7 +571,7 @@ HandleFetchRemote(NodeHandle *handle, RemoteQueryState *node, TupleTableSlot *de
 	context.fetch_batch = batch;
 	context.fetch_count = 0;
 
-	PQNOneExecFinish(handle->node_conn, &context.pub, blocking);
+	PQNOneExecFinishEvent(handle->node_conn, &context.pub, blocking, WAIT_EVENT_REMOTE_FETCH);
 
 	return destslot;
 }
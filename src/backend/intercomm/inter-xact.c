@@ -45,9 +45,12 @@ static InterXactStateData TopInterXactStateData = {
 	false,						/* is GID missing ok in the second phase of two-phase commit? */
 	false,						/* is the inter transaction implicit two-phase commit? */
 	false,						/* is the inter transaction start any transaction block? */
+	false,						/* is the current query read only on remote nodes? */
 	NULL,						/* array of remote nodes already start transaction */
+	NULL,						/* array of flags whether remote nodes are modified */
 	0,							/* count of remote nodes already start transaction */
 	0,							/* max count of remote nodes already malloc */
+	0,							/* count of remote nodes modified */
 	NULL,						/* NodeMixHandle for the current query in the inter transaction block */
 	NULL						/* NodeMixHandle for the whole inter transaction block */
 };
@@ -113,13 +116,17 @@ ResetInterXactState(InterXactState state)
 			pfree(state->gid);
 		if (state->trans_nodes)
 			MemSet(state->trans_nodes, 0, sizeof(Oid) * state->trans_max);
+		if (state->trans_writes)
+			MemSet(state->trans_writes, 0, sizeof(bool) * state->trans_max);
 		FreeMixHandle(state->cur_handle);
 		FreeMixHandle(state->all_handle);
 		state->gid = NULL;
 		state->missing_ok = false;
 		state->implicit = false;
 		state->need_xact_block = false;
+		state->cur_read_only = false;
 		state->trans_count = 0;
+		state->write_count = 0;
 		state->cur_handle = NULL;
 		state->all_handle = NULL;
 	}
@@ -139,6 +146,8 @@ FreeInterXactState(InterXactState state)
 			pfree(state->gid);
 		if (state->trans_nodes)
 			pfree(state->trans_nodes);
+		if (state->trans_writes)
+			pfree(state->trans_writes);
 		FreeMixHandle(state->cur_handle);
 		FreeMixHandle(state->all_handle);
 		if (state != &TopInterXactStateData)
@@ -191,9 +200,12 @@ MakeInterXactState(MemoryContext context, const List *node_list)
 	state->missing_ok = false;
 	state->implicit = false;
 	state->need_xact_block = false;
+	state->cur_read_only = false;
 	state->trans_nodes = NULL;
+	state->trans_writes = NULL;
 	state->trans_count = 0;
 	state->trans_max = 0;
+	state->write_count = 0;
 	if (node_list)
 	{
 		NodeMixHandle  *cur_handle;
@@ -377,7 +389,8 @@ InterXactSetXID(InterXactState state, TransactionId xid)
 /*
  * InterXactSaveBeginNodes
  *
- * save nodes which start transaction
+ * save nodes which start transaction, and remember whether
+ * the node is modified unless the current query is read only.
  */
 void
 InterXactSaveBeginNodes(InterXactState state, Oid node)
@@ -390,7 +403,15 @@ InterXactSaveBeginNodes(InterXactState state, Oid node)
 	{
 		/* return if already exists */
 		if (state->trans_nodes[i] == node)
+		{
+			if (!state->cur_read_only &&
+				!state->trans_writes[i])
+			{
+				state->trans_writes[i] = true;
+				state->write_count++;
+			}
 			return ;
+		}
 	}
 	/* a new node will be saved */
 	old_context = MemoryContextSwitchTo(state->context);
@@ -399,19 +420,39 @@ InterXactSaveBeginNodes(InterXactState state, Oid node)
 		Assert(state->trans_count == 0);
 		new_max = 16;
 		state->trans_nodes = (Oid *) palloc(sizeof(Oid) * new_max);
+		state->trans_writes = (bool *) palloc0(sizeof(bool) * new_max);
 		state->trans_max = new_max;
 	} else
 	if (state->trans_count >= state->trans_max)
 	{
 		new_max = state->trans_max + 16;
 		state->trans_nodes = (Oid *) repalloc(state->trans_nodes, sizeof(Oid) * new_max);
+		state->trans_writes = (bool *) repalloc(state->trans_writes, sizeof(bool) * new_max);
 		state->trans_max = new_max;
 	}
+	state->trans_writes[state->trans_count] = !state->cur_read_only;
+	if (!state->cur_read_only)
+		state->write_count++;
 	state->trans_nodes[state->trans_count++] = node;
 	Assert(state->trans_count <= state->trans_max);
 	(void) MemoryContextSwitchTo(old_context);
 }
 
+/*
+ * InterXactWriteNodeCount
+ *
+ * return count of remote nodes which may be modified by the transaction,
+ * remote nodes only read by the transaction need not two-phase commit.
+ */
+int
+InterXactWriteNodeCount(InterXactState state)
+{
+	if (!IsCnMaster() || state == NULL)
+		return 0;
+
+	return state->write_count;
+}
+
 /*
  * InterXactBeginNodes
  *
@@ -623,10 +664,11 @@ InterXactUtility(InterXactState state, Snapshot snapshot,
 /*
  * InterXactBegin
  *
- * Begin transaction by InterXactState and node_list
+ * Begin transaction by InterXactState and node_list, "read_only"
+ * means the query will not modify any data of the remote nodes.
  */
 void
-InterXactBegin(InterXactState state, const List *node_list)
+InterXactBegin(InterXactState state, const List *node_list, bool read_only)
 {
 	GlobalTransactionId gxid;
 	TimestampTz			timestamp;
@@ -652,6 +694,7 @@ InterXactBegin(InterXactState state, const List *node_list)
 			gxid = GetCurrentTransactionIdIfAny();
 		timestamp = GetCurrentTransactionStartTimestamp();
 
+		state->cur_read_only = read_only;
 		foreach (lc_handle, cur_handle->handles)
 		{
 			handle = (NodeHandle *) lfirst(lc_handle);
@@ -661,8 +704,10 @@ InterXactBegin(InterXactState state, const List *node_list)
 						 errnode(NameStr(handle->node_name)),
 						 errdetail("%s:", HandleGetError(handle))));
 		}
+		state->cur_read_only = false;
 	} PG_CATCH();
 	{
+		state->cur_read_only = false;
 		InterXactGCCurrent(new_state);
 		PG_RE_THROW();
 	} PG_END_TRY();
@@ -3,6 +3,7 @@
 #include "catalog/pgxc_node.h"
 #include "common/hashfn.h"
 #include "executor/clusterReceiver.h"
+#include "executor/instrument.h"
 #include "intercomm/inter-node.h"
 #include "libpq-fe.h"
 #include "libpq/pqcomm.h"
@@ -10,6 +11,7 @@
 #include "utils/dynamicreduce.h"
 #include "utils/memutils.h"
 #include "nodes/pg_list.h"
+#include "pgstat.h"
 #include "pgxc/nodemgr.h"
 #include "pgxc/pgxcnode.h"
 #include "pgxc/poolmgr.h"
@@ -332,8 +334,20 @@ static List* pg_conn_attach_socket(int *fds, Size n)
 //#endif
 
 bool PQNOneExecFinish(struct pg_conn *conn, const PQNHookFunctions *hook, bool blocking)
+{
+	return PQNOneExecFinishEvent(conn, hook, blocking, WAIT_EVENT_REMOTE_RESULT);
+}
+
+/*
+ * Same as PQNOneExecFinish, but a blocking wait for the result is reported
+ * as wait_event_info.
+ */
+bool PQNOneExecFinishEvent(struct pg_conn *conn, const PQNHookFunctions *hook,
+						   bool blocking, uint32 wait_event_info)
 {
 	struct pollfd pfd;
+	instr_time wait_start;
+	instr_time wait_end;
 	int connecting_status;
 	int poll_res;
 	AssertArg(conn && hook);
@@ -418,11 +432,24 @@ bool PQNOneExecFinish(struct pg_conn *conn, const PQNHookFunctions *hook, bool b
 			|| PQtransactionStatus(conn) != PQTRANS_ACTIVE)
 			break;
 
+		/* a non-blocking poll is not a wait, don't count it */
+		if (blocking)
+		{
+			INSTR_TIME_SET_CURRENT(wait_start);
+			pgstat_report_wait_start(wait_event_info);
+		}
 #ifdef WITH_RDMA
 		poll_res = adb_rpoll(&pfd, 1, blocking ? -1:0);
 #else
 		poll_res = poll(&pfd, 1, blocking ? -1:0);
 #endif
+		if (blocking)
+		{
+			pgstat_report_wait_end();
+			INSTR_TIME_SET_CURRENT(wait_end);
+			INSTR_TIME_ACCUM_DIFF(pgClusterUsage.remote_wait_time, wait_end, wait_start);
+			pgstat_report_cluster_wait();
+		}
 		if(poll_res < 0)
 		{
 			if(errno == EINTR)
@@ -454,6 +481,8 @@ PQNListExecFinish(List *conn_list, GetPGconnHook get_pgconn_hook,
 	ListCell *lc;
 	PGconn *conn;
 	struct pollfd *pfds;
+	instr_time wait_start;
+	instr_time wait_end;
 	int i,n;
 	bool res;
 
@@ -541,11 +570,23 @@ PQNListExecFinish(List *conn_list, GetPGconnHook get_pgconn_hook,
 		}
 
 re_poll_:
+		if (blocking)
+		{
+			INSTR_TIME_SET_CURRENT(wait_start);
+			pgstat_report_wait_start(WAIT_EVENT_REMOTE_RESULT);
+		}
 #ifdef WITH_RDMA
 		n = adb_rpoll(pfds, list_length(list), blocking ? -1:0);
 #else
 		n = poll(pfds, list_length(list), blocking ? -1:0);
 #endif
+		if (blocking)
+		{
+			pgstat_report_wait_end();
+			INSTR_TIME_SET_CURRENT(wait_end);
+			INSTR_TIME_ACCUM_DIFF(pgClusterUsage.remote_wait_time, wait_end, wait_start);
+			pgstat_report_cluster_wait();
+		}
 		if(n < 0)
 		{
 			if(errno == EINTR)
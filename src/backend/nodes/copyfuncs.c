@@ -5112,6 +5112,10 @@ _copyClusterReduce(const ClusterReduce *from)
 
 	COPY_SCALAR_FIELD(reduce_flags);
 	COPY_BITMAPSET_FIELD(ignore_params);
+	COPY_SCALAR_FIELD(reduce_conn_cost);
+	COPY_SCALAR_FIELD(reduce_transfer_cost);
+	COPY_SCALAR_FIELD(reduce_bandwidth);
+	COPY_SCALAR_FIELD(reduce_latency);
 
 	return newnode;
 }
@@ -5247,6 +5251,7 @@ _copyCreateAuxStmt(const CreateAuxStmt *from)
 	COPY_NODE_FIELD(index_stmt);
 	COPY_NODE_FIELD(master_relation);
 	COPY_STRING_FIELD(aux_column);
+	COPY_NODE_FIELD(aux_include);
 
 	return newnode;
 }
@@ -3202,6 +3202,7 @@ _equalCreateAuxStmt(const CreateAuxStmt *a, const CreateAuxStmt *b)
 	COMPARE_NODE_FIELD(index_stmt);
 	COMPARE_NODE_FIELD(master_relation);
 	COMPARE_STRING_FIELD(aux_column);
+	COMPARE_NODE_FIELD(aux_include);
 
 	return true;
 }
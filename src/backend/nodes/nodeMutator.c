@@ -100,6 +100,7 @@ BEGIN_STRUCT(ReduceInfo)
 	NODE_NODE(List,storage_nodes)
 	NODE_NODE(List,exclude_exec)
 	NODE_NODE(List,values)
+	NODE_NODE(List,buckets)
 	NODE_BITMAPSET(Bitmapset,relids)
 	/*NODE_SCALAR(char,type)*/
 	for (i=0;i<nkey;++i)
@@ -701,6 +701,10 @@ _outClusterReduce(StringInfo str, const ClusterReduce *node)
 
 	WRITE_INT_FIELD(reduce_flags);
 	WRITE_BITMAPSET_FIELD(ignore_params);
+	WRITE_FLOAT_FIELD(reduce_conn_cost, "%.2f");
+	WRITE_FLOAT_FIELD(reduce_transfer_cost, "%.2f");
+	WRITE_FLOAT_FIELD(reduce_bandwidth, "%.0f");
+	WRITE_FLOAT_FIELD(reduce_latency, "%.3f");
 }
 
 static void
@@ -3977,6 +3981,26 @@ _outPriorExpr(StringInfo str, const PriorExpr *node)
 	WRITE_LOCATION_FIELD(location);
 	WRITE_NODE_FIELD(expr);
 }
+
+static void
+_outConnectByPlan(StringInfo str, const ConnectByPlan *node)
+{
+	WRITE_NODE_TYPE("CONNECTBYPLAN");
+
+	_outPlanInfo(str, (const Plan *) node);
+
+	WRITE_NODE_FIELD(save_targetlist);
+	WRITE_NODE_FIELD(hash_quals);
+	WRITE_NODE_FIELD(join_quals);
+	WRITE_NODE_FIELD(start_with);
+	WRITE_BOOL_FIELD(no_cycle);
+	WRITE_INT_FIELD(numCols);
+	WRITE_ATTRNUMBER_ARRAY(sortColIdx, node->numCols);
+	WRITE_OID_ARRAY(sortOperators, node->numCols);
+	WRITE_OID_ARRAY(collations, node->numCols);
+	WRITE_BOOL_ARRAY(nullsFirst, node->numCols);
+	WRITE_NODE_FIELD(sort_targetlist);
+}
 #endif /* ADB_GRAM_ORA */
 
 #ifdef ADB_EXT
@@ -4347,6 +4371,9 @@ outNode(StringInfo str, const void *obj)
 			case T_OracleConnectBy:
 				_outOracleConnectBy(str, obj);
 				break;
+			case T_ConnectByPlan:
+				_outConnectByPlan(str, obj);
+				break;
 #endif /* ADB_GRAM_ORA */
 			case T_InferenceElem:
 				_outInferenceElem(str, obj);
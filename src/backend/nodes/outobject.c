@@ -540,6 +540,7 @@ BEGIN_STRUCT(ReduceInfo)
 	NODE_NODE(List,storage_nodes)
 	NODE_NODE(List,exclude_exec)
 	NODE_NODE(List,values)
+	NODE_NODE(List,buckets)
 	NODE_RELIDS(Relids,relids)
 	NODE_SCALAR(ReduceType,type)
 	NODE_STRUCT_ARRAY(ReduceKeyInfo, keys, NODE_ARG_->nkey)
@@ -2752,6 +2752,10 @@ _readClusterReduce(void)
 
 	READ_INT_FIELD(reduce_flags);
 	READ_BITMAPSET_FIELD(ignore_params);
+	READ_FLOAT_FIELD(reduce_conn_cost);
+	READ_FLOAT_FIELD(reduce_transfer_cost);
+	READ_FLOAT_FIELD(reduce_bandwidth);
+	READ_FLOAT_FIELD(reduce_latency);
 
 	READ_DONE();
 }
@@ -2842,6 +2846,28 @@ _readOracleConnectBy(void)
 
 	READ_DONE();
 }
+
+static ConnectByPlan *
+_readConnectByPlan(void)
+{
+	READ_LOCALS(ConnectByPlan);
+
+	ReadCommonPlan(&local_node->plan);
+
+	READ_NODE_FIELD(save_targetlist);
+	READ_NODE_FIELD(hash_quals);
+	READ_NODE_FIELD(join_quals);
+	READ_NODE_FIELD(start_with);
+	READ_BOOL_FIELD(no_cycle);
+	READ_INT_FIELD(numCols);
+	READ_ATTRNUMBER_ARRAY(sortColIdx, local_node->numCols);
+	READ_OID_ARRAY(sortOperators, local_node->numCols);
+	READ_OID_ARRAY(collations, local_node->numCols);
+	READ_BOOL_ARRAY(nullsFirst, local_node->numCols);
+	READ_NODE_FIELD(sort_targetlist);
+
+	READ_DONE();
+}
 #endif /* ADB_GRAM_ORA */
 
 /*
@@ -3187,6 +3213,8 @@ parseNodeString(void)
 		return_value = _readConnectByRootExpr();
 	else if (MATCH("ORACLECONNECTBY", 15))
 		return_value = _readOracleConnectBy();
+	else if (MATCH("CONNECTBYPLAN", 13))
+		return_value = _readConnectByPlan();
 #endif /* ADB_GRAM_ORA */
 #ifdef ADB_EXT
 	else if (MATCH("KEEPCLAUSE", 10))
@@ -5052,6 +5052,10 @@ void add_paths_to_connect_by_rel(PlannerInfo *root,
 		path->subpath = subpath = lfirst(lc);
 		path->path.pathtarget = connect_rel->reltarget;
 		path->path.rows = connect_rel->rows;
+		/* can run in a parallel worker, but input is not partial */
+		path->path.parallel_safe = connect_rel->consider_parallel &&
+								   subpath->parallel_safe;
+		path->path.parallel_workers = 0;
 		if (hash_quals)
 		{
 			initial_cost_hashjoin(root, &workspace, JOIN_INNER, hash_quals, subpath, subpath, &extra, false);
@@ -98,6 +98,7 @@
 #include "utils/tuplesort.h"
 #ifdef ADB
 #include "optimizer/reduceinfo.h"
+#include "utils/dynamicreduce.h"
 #endif /* ABD */
 
 #define LOG2(x)  (log(x) / 0.693147180559945)
@@ -123,6 +124,7 @@ double		pgxc_remote_tuple_cost = DEFAULT_PGXC_REMOTE_TUPLE_COST;
 double		reduce_setup_cost = DEFAULT_REDUCE_SETUP_COST;
 double		reduce_conn_cost = DEFAULT_REDUCE_CONN_COST;
 double		reduce_page_cost = DEFAULT_REDUCE_PAGE_COST;
+bool		reduce_cost_calibration = false;
 #endif /* ADB */
 
 int			effective_cache_size = DEFAULT_EFFECTIVE_CACHE_SIZE;
@@ -6225,10 +6227,42 @@ compute_bitmap_pages(PlannerInfo *root, RelOptInfo *baserel, Path *bitmapqual,
 	return pages_fetched;
 }
 #ifdef ADB
+/*
+ * Scale factors for the transfer and connection parts of a cluster path from
+ * what dynamic reduce measured to nodes, see dr_netstat.c.  Both factors are
+ * 1.0 when reduce_cost_calibration is off or nothing was measured yet.
+ */
+static void
+reduce_calibration_factors(List *nodes, double *bandwidth, double *latency,
+						   double *transfer_factor, double *conn_factor)
+{
+	*transfer_factor = *conn_factor = 1.0;
+	*bandwidth = *latency = 0.0;
+
+	if (!reduce_cost_calibration ||
+		nodes == NIL ||
+		!DRNetStatEstimate(nodes, bandwidth, latency))
+		return;
+
+	if (*bandwidth > 0.0)
+	{
+		*transfer_factor = REDUCE_REFERENCE_BANDWIDTH / *bandwidth;
+		*transfer_factor = Min(Max(*transfer_factor, 1.0 / REDUCE_CALIBRATION_MAX_FACTOR),
+							   REDUCE_CALIBRATION_MAX_FACTOR);
+	}
+	if (*latency > 0.0)
+	{
+		*conn_factor = *latency / REDUCE_REFERENCE_LATENCY;
+		*conn_factor = Min(Max(*conn_factor, 1.0 / REDUCE_CALIBRATION_MAX_FACTOR),
+						   REDUCE_CALIBRATION_MAX_FACTOR);
+	}
+}
+
 void cost_cluster_gather(ClusterGatherPath *path, RelOptInfo *baserel, ParamPathInfo *param_info, double *rows)
 {
 	Cost		startup_cost = 0;
 	Cost		run_cost = 0;
+	double		transfer_factor = 1.0;
 
 	/* Mark the path with the correct row estimate */
 	if (rows)
@@ -6245,7 +6279,18 @@ void cost_cluster_gather(ClusterGatherPath *path, RelOptInfo *baserel, ParamPath
 
 	run_cost = path->subpath->total_cost - path->subpath->startup_cost;
 
-	run_cost += remote_tuple_cost * path->path.rows;
+	if (reduce_cost_calibration)
+	{
+		List   *nodes = ReduceInfoListGetExecuteOidList(get_reduce_info_list(path->subpath));
+		double	bandwidth,
+				latency,
+				conn_factor;
+
+		reduce_calibration_factors(nodes, &bandwidth, &latency,
+								   &transfer_factor, &conn_factor);
+		list_free(nodes);
+	}
+	run_cost += remote_tuple_cost * path->path.rows * transfer_factor;
 
 	path->path.startup_cost = startup_cost;
 	path->path.total_cost = (startup_cost + run_cost);
@@ -6325,6 +6370,9 @@ void cost_cluster_reduce(ClusterReducePath *path)
 					sort_run_cost,
 					startup_cost;
 	Cost			reduce_run_cost;
+	Cost			conn_cost;
+	double			transfer_factor,
+					conn_factor;
 	int				compare;
 	int				storage_count = 0;
 	int				exclude_count = 0;
@@ -6365,9 +6413,11 @@ void cost_cluster_reduce(ClusterReducePath *path)
 			/*
 			 * out count = all rows - stay rows
 			 *           = cluster_rows - src_rows
+			 * every node receive rows from all other nodes,
+			 * in count = out count
 			 */
 			reduce_out_rows = cluster_rows - src_rows;
-			reduce_in_rows = cluster_rows - reduce_out_rows;
+			reduce_in_rows = reduce_out_rows;
 		}else
 		{
 			reduce_out_rows = reduce_in_rows = cluster_rows;
@@ -6387,11 +6437,12 @@ void cost_cluster_reduce(ClusterReducePath *path)
 		if (compare == REDUCE_LIST_EQUAL)
 		{
 			/*
-			 * out count = src_rows / (node count - 1)
+			 * only 1/(node count) rows stay in local node
+			 * out count = src_rows * (node count - 1) / node count
 			 * in count = out count
 			 */
 			if (storage_count > 1)
-				reduce_out_rows = reduce_in_rows = src_rows / (storage_count - 1);
+				reduce_out_rows = reduce_in_rows = src_rows * (storage_count - 1) / storage_count;
 		}else if (compare == REDUCE_LIST_DIFFERENCE)
 		{
 			/* ondes all rows out */
@@ -6435,10 +6486,24 @@ void cost_cluster_reduce(ClusterReducePath *path)
 	}
 end_compare_in_out_:
 
+	transfer_factor = conn_factor = 1.0;
+	path->bandwidth = path->latency = 0.0;
+	if (reduce_cost_calibration)
+	{
+		List	   *nodes = list_copy(reduce_to->storage_nodes);
+		ListCell   *lc;
+
+		foreach (lc, reduce_from_list)
+			nodes = list_concat_unique_oid(nodes, ((ReduceInfo*)lfirst(lc))->storage_nodes);
+		reduce_calibration_factors(nodes, &path->bandwidth, &path->latency,
+								   &transfer_factor, &conn_factor);
+		list_free(nodes);
+	}
+
 	reduce_max_rows = Max(reduce_out_rows, reduce_in_rows);
 	reduce_run_cost = remote_tuple_cost * reduce_max_rows	/* rows cost */
 					/* plus page cost */
-					+ page_size(reduce_max_rows,  subpath->pathtarget->width) * reduce_page_cost
+					+ page_size(reduce_max_rows,  subpath->pathtarget->width) * reduce_page_cost * transfer_factor
 					/* here should plus reduce expr cost */
 					;
 
@@ -6465,10 +6530,18 @@ end_compare_in_out_:
 		sort_run_cost += cpu_operator_cost * path->path.rows;
 	}
 
-	/* here we calulate the average cost of ClusterReduce */
-	startup_cost = reduce_conn_cost + sort_startup_cost;
+	/*
+	 * here we calulate the average cost of ClusterReduce,
+	 * each node connect to all other nodes
+	 */
+	conn_cost = reduce_conn_cost * conn_factor * Max(storage_count - 1, 1);
+	startup_cost = conn_cost + sort_startup_cost;
 	path->path.startup_cost = subpath->startup_cost + startup_cost;
 	path->path.total_cost = subpath->total_cost + startup_cost + reduce_run_cost + sort_run_cost;
+
+	/* remember the parts for EXPLAIN */
+	path->conn_cost = conn_cost;
+	path->transfer_cost = reduce_run_cost;
 }
 
 #endif /* ADB */
@@ -7765,6 +7765,10 @@ static Plan *create_cluster_reduce_plan(PlannerInfo *root, ClusterReducePath *pa
 	from_oids = ReduceInfoListGetExecuteOidList(reduce_list);
 	plan->special_node = path->special_node;
 	plan->special_reduce = path->special_reduce;
+	plan->reduce_conn_cost = path->conn_cost;
+	plan->reduce_transfer_cost = path->transfer_cost;
+	plan->reduce_bandwidth = path->bandwidth;
+	plan->reduce_latency = path->latency;
 
 	/* Is replicate to replicate? */
 	if (IsReduceInfoReplicated(to) &&
@@ -1,8 +1,10 @@
 #include "postgres.h"
 
+#include "access/hash.h"
 #include "access/htup_details.h"
 #include "catalog/namespace.h"
 #include "catalog/pg_am_d.h"
+#include "catalog/pg_collation.h"
 #include "catalog/pg_namespace.h"
 #include "catalog/pg_operator_d.h"
 #include "catalog/pg_type.h"
@@ -28,6 +30,7 @@
 #include "utils/builtins.h"
 #include "utils/fmgroids.h"
 #include "utils/lsyscache.h"
+#include "utils/pg_locale.h"
 #include "utils/rel.h"
 #include "utils/syscache.h"
 #include "utils/typcache.h"
@@ -85,6 +88,24 @@ static inline void SetReduceKeyDefaultInfo(ReduceKeyInfo *key, const Expr *expr,
 	key->opfamily = get_opclass_family(key->opclass);
 }
 
+/*
+ * storage of hash and modulo is the node of each remainder, a node appear
+ * more than once when it owns more than one bucket, keep storage_nodes
+ * unique and save the map in buckets
+ */
+static void SetReduceInfoStorageByValue(ReduceInfo *rinfo, const List *storage)
+{
+	const ListCell *lc;
+	List		   *unique = NIL;
+
+	foreach (lc, storage)
+		unique = list_append_unique_oid(unique, lfirst_oid(lc));
+
+	rinfo->storage_nodes = unique;
+	if (list_length(unique) != list_length(storage))
+		rinfo->buckets = list_copy(storage);
+}
+
 ReduceInfo *MakeHashReduceInfo(const List *storage, const List *exclude, const Expr *key)
 {
 	ReduceInfo *rinfo;
@@ -93,7 +114,7 @@ ReduceInfo *MakeHashReduceInfo(const List *storage, const List *exclude, const E
 
 	rinfo = MakeEmptyReduceInfo(1);
 	SetReduceKeyDefaultInfo(&rinfo->keys[0], key, HASH_AM_OID, "hash");
-	rinfo->storage_nodes = list_copy(storage);
+	SetReduceInfoStorageByValue(rinfo, storage);
 	rinfo->exclude_exec = list_copy(exclude);
 	rinfo->relids = pull_varnos((Node*)key);
 	rinfo->type = REDUCE_TYPE_HASH;
@@ -109,7 +130,7 @@ ReduceInfo *MakeModuloReduceInfo(const List *storage, const List *exclude, const
 
 	rinfo = MakeEmptyReduceInfo(1);
 	SetReduceKeyDefaultInfo(&rinfo->keys[0], key, BTREE_AM_OID, "btree");
-	rinfo->storage_nodes = list_copy(storage);
+	SetReduceInfoStorageByValue(rinfo, storage);
 	rinfo->exclude_exec = list_copy(exclude);
 	rinfo->relids = pull_varnos((Node*)key);
 	rinfo->type = REDUCE_TYPE_MODULO;
@@ -199,6 +220,8 @@ ReduceInfo *MakeReduceInfoFromLocInfo(const RelationLocInfo *loc_info, const Lis
 		}
 		rinfo->relids = bms_make_singleton(relid);
 		rinfo->storage_nodes = list_copy(rnodes);
+		if (loc_info->buckets != NIL)
+			rinfo->buckets = GetLocatorBucketNodes(loc_info);
 		rinfo->exclude_exec = list_copy(exclude);
 		if(loc_info->locatorType == LOCATOR_TYPE_HASH)
 		{
@@ -247,6 +270,8 @@ ReduceInfo *MakeReduceInfoUsingPathTarget(const RelationLocInfo *loc_info, const
 		Assert(list_length(loc_info->keys) > 0);
 		rinfo = MakeEmptyReduceInfo(list_length(loc_info->keys));
 		rinfo->storage_nodes = list_copy(rnodes);
+		if (loc_info->buckets != NIL)
+			rinfo->buckets = GetLocatorBucketNodes(loc_info);
 		rinfo->exclude_exec = list_copy(exclude);
 		i = 0;
 		foreach(lc, loc_info->keys)
@@ -379,6 +404,7 @@ void FreeReduceInfo(ReduceInfo *reduce)
 	{
 		list_free(reduce->storage_nodes);
 		list_free(reduce->exclude_exec);
+		list_free(reduce->buckets);
 		i = reduce->nkey;
 		while (i>0)
 		{
@@ -691,7 +717,7 @@ int ReducePathByReduceInfo(Expr *expr, PlannerInfo *root, RelOptInfo *rel, Path
 							root,
 							rel,
 							path,
-							reduce->storage_nodes,
+							ReduceInfoBucketNodes(reduce),
 							reduce->exclude_exec,
 							func,
 							context,
@@ -711,7 +737,7 @@ int ReducePathListByReduceInfo(Expr *expr, PlannerInfo *root, RelOptInfo *rel, L
 								  root,
 								  rel,
 								  lfirst(lc),
-								  reduce->storage_nodes,
+								  ReduceInfoBucketNodes(reduce),
 								  reduce->exclude_exec,
 								  func,
 								  context,
@@ -738,7 +764,7 @@ int ReducePathByReduceInfoList(Expr *expr, PlannerInfo *root, RelOptInfo *rel, P
 								  root,
 								  rel,
 								  path,
-								  reduce->storage_nodes,
+								  ReduceInfoBucketNodes(reduce),
 								  reduce->exclude_exec,
 								  func,
 								  context,
@@ -768,7 +794,7 @@ int ReducePathListByReduceInfoList(Expr *expr, PlannerInfo *root, RelOptInfo *re
 									  root,
 									  rel,
 									  lfirst(lc_path),
-									  reduce->storage_nodes,
+									  ReduceInfoBucketNodes(reduce),
 									  reduce->exclude_exec,
 									  func,
 									  context,
@@ -1305,7 +1331,10 @@ ReduceInfo *CopyReduceInfoExtend(const ReduceInfo *reduce, int mark)
 	rinfo = MakeEmptyReduceInfo(reduce->nkey);
 
 	if(mark & REDUCE_MARK_STORAGE)
+	{
 		rinfo->storage_nodes = list_copy(reduce->storage_nodes);
+		rinfo->buckets = list_copy(reduce->buckets);
+	}
 
 	if((mark & REDUCE_MARK_EXCLUDE) && reduce->exclude_exec)
 		rinfo->exclude_exec = list_copy(reduce->exclude_exec);
@@ -1357,7 +1386,8 @@ bool CompReduceInfo(const ReduceInfo *left, const ReduceInfo *right, int mark)
 		return false;
 
 	if ((mark & REDUCE_MARK_STORAGE) &&
-		equal(left->storage_nodes, right->storage_nodes) == false)
+		(equal(left->storage_nodes, right->storage_nodes) == false ||
+		 equal(left->buckets, right->buckets) == false))
 		return false;
 
 	if ((mark & REDUCE_MARK_EXCLUDE) &&
@@ -2311,8 +2341,8 @@ Expr *CreateExprUsingReduceInfo(ReduceInfo *reduce)
 			List *args;
 			uint32 i,nkey;
 
-			/* make hash_combin_mod(node_count, hash_value1, hash_value2 ...) */
-			args = list_make1(MakeInt4Const(list_length(reduce->storage_nodes)));
+			/* make hash_combin_mod(bucket_count, hash_value1, hash_value2 ...) */
+			args = list_make1(MakeInt4Const(list_length(ReduceInfoBucketNodes(reduce))));
 			for(i=0,nkey=reduce->nkey;i<nkey;++i)
 			{
 				ReduceKeyInfo *key = &reduce->keys[i];
@@ -2320,7 +2350,7 @@ Expr *CreateExprUsingReduceInfo(ReduceInfo *reduce)
 			}
 			result = (Expr*)makeSimpleFuncExpr(F_HASH_COMBIN_MOD, INT4OID, args);
 
-			result = makeReduceArrayRef(reduce->storage_nodes, result, bms_is_empty(reduce->relids), true);
+			result = makeReduceArrayRef(ReduceInfoBucketNodes(reduce), result, bms_is_empty(reduce->relids), true);
 		}
 		break;
 
@@ -2342,8 +2372,8 @@ Expr *CreateExprUsingReduceInfo(ReduceInfo *reduce)
 												  -1);
 			result = (Expr*)makeSimpleFuncExpr(F_HASH_COMBIN_MOD,
 											   INT4OID,
-											   list_make2(MakeInt4Const(list_length(reduce->storage_nodes)), result));
-			result = makeReduceArrayRef(reduce->storage_nodes, result, bms_is_empty(reduce->relids), true);
+											   list_make2(MakeInt4Const(list_length(ReduceInfoBucketNodes(reduce))), result));
+			result = makeReduceArrayRef(ReduceInfoBucketNodes(reduce), result, bms_is_empty(reduce->relids), true);
 		}
 		break;
 	case REDUCE_TYPE_REPLICATED:
@@ -2734,9 +2764,243 @@ re_start_:
 	return ObjectIdGetDatum(oid);
 }
 
+typedef enum ReduceKeyKind
+{
+	RK_INT4_VALUE = 0,	/* modulo reduce, int4 value self */
+	RK_HASH_INT2,
+	RK_HASH_INT4,
+	RK_HASH_INT8,
+	RK_HASH_OID,
+	RK_HASH_TEXT		/* deterministic collation only */
+}ReduceKeyKind;
+
+typedef struct ReduceKeyState
+{
+	ReduceKeyKind	kind;
+	int				varno;
+	AttrNumber		attno;
+}ReduceKeyState;
+
+/*
+ * Native evaluation of "oids[coalesce(hash_combin_mod(N, hash(Var)...), 0)]",
+ * without walking ExprState and fmgr calls for each row
+ */
+typedef struct ReduceHashExprState
+{
+	uint32			modulus;
+	uint32			nkey;
+	Oid			   *oids;
+	ReduceKeyState	keys[FLEXIBLE_ARRAY_MEMBER];
+}ReduceHashExprState;
+
+static bool InitReduceKeyState(ReduceKeyState *key, Expr *expr, bool is_hash)
+{
+	FuncExpr   *func;
+	Var		   *var;
+
+	if (is_hash)
+	{
+		if (!IsA(expr, FuncExpr) ||
+			list_length(((FuncExpr*)expr)->args) != 1)
+			return false;
+		func = (FuncExpr*)expr;
+		switch(func->funcid)
+		{
+		case F_HASHINT2:
+			key->kind = RK_HASH_INT2;
+			break;
+		case F_HASHINT4:
+			key->kind = RK_HASH_INT4;
+			break;
+		case F_HASHINT8:
+			key->kind = RK_HASH_INT8;
+			break;
+		case F_HASHOID:
+			key->kind = RK_HASH_OID;
+			break;
+		case F_HASHTEXT:
+			if (func->inputcollid != DEFAULT_COLLATION_OID &&
+				(!OidIsValid(func->inputcollid) ||
+				 !lc_collate_is_c(func->inputcollid)))
+				return false;
+			key->kind = RK_HASH_TEXT;
+			break;
+		default:
+			return false;
+		}
+		expr = linitial(func->args);
+		while (IsA(expr, RelabelType))
+			expr = ((RelabelType*)expr)->arg;
+	}else
+	{
+		key->kind = RK_INT4_VALUE;
+	}
+
+	if (!IsA(expr, Var))
+		return false;
+	var = (Var*)expr;
+	if (var->varattno <= 0 ||
+		(is_hash == false && var->vartype != INT4OID))
+		return false;
+
+	key->varno = var->varno;
+	key->attno = var->varattno;
+	return true;
+}
+
+static ReduceHashExprState* InitReduceHashExprState(Expr *expr)
+{
+	SubscriptingRef	   *sref;
+	CoalesceExpr	   *coalesce;
+	FuncExpr		   *func;
+	Const			   *c;
+	oidvector		   *ov;
+	ReduceHashExprState *state;
+	ListCell		   *lc;
+	bool				is_hash;
+
+	if (!IsA(expr, SubscriptingRef))
+		return NULL;
+	sref = (SubscriptingRef*)expr;
+	if (sref->refelemtype != OIDOID ||
+		sref->reflowerindexpr != NIL ||
+		list_length(sref->refupperindexpr) != 1 ||
+		!IsA(sref->refexpr, Const) ||
+		((Const*)sref->refexpr)->constisnull)
+		return NULL;
+
+	/* coalesce(hash_combin_mod(...), 0) */
+	coalesce = linitial(sref->refupperindexpr);
+	if (!IsA(coalesce, CoalesceExpr) ||
+		list_length(coalesce->args) != 2 ||
+		!IsA(llast(coalesce->args), Const) ||
+		((Const*)llast(coalesce->args))->constisnull ||
+		DatumGetInt32(((Const*)llast(coalesce->args))->constvalue) != 0)
+		return NULL;
+
+	func = linitial(coalesce->args);
+	if (!IsA(func, FuncExpr) ||
+		func->funcid != F_HASH_COMBIN_MOD ||
+		func->funcvariadic ||
+		list_length(func->args) < 2 ||
+		!IsA(linitial(func->args), Const))
+		return NULL;
+	c = linitial(func->args);
+	if (c->constisnull ||
+		DatumGetInt32(c->constvalue) <= 0)
+		return NULL;
+
+	ov = (oidvector*)DatumGetPointer(((Const*)sref->refexpr)->constvalue);
+	if (ov->elemtype != OIDOID ||
+		ov->lbound1 != 0 ||
+		ov->dim1 != DatumGetInt32(c->constvalue))
+		return NULL;
+
+	state = palloc(offsetof(ReduceHashExprState, keys) + sizeof(ReduceKeyState) * (list_length(func->args) - 1));
+	state->modulus = DatumGetInt32(c->constvalue);
+	state->nkey = list_length(func->args) - 1;
+	state->oids = ov->values;
+
+	/* modulo reduce is hash_combin_mod(N, int4), others all are hash function */
+	is_hash = (state->nkey > 1 || !IsA(lsecond(func->args), Var));
+	state->nkey = 0;
+	for_each_cell(lc, func->args, list_second_cell(func->args))
+	{
+		if (!InitReduceKeyState(&state->keys[state->nkey], lfirst(lc), is_hash))
+		{
+			pfree(state);
+			return NULL;
+		}
+		++(state->nkey);
+	}
+
+	return state;
+}
+
+static Datum
+ExecReduceHashExpr(ReduceHashExprState *state, ExprContext *econtext, bool *isnull, ExprDoneCond *isDone)
+{
+	ReduceKeyState *key;
+	TupleTableSlot *slot;
+	Datum			datum;
+	uint32			hashval = 0;
+	uint32			value;
+	uint32			i;
+	bool			null;
+
+	*isDone = ExprSingleResult;
+	*isnull = false;
+
+	for (i=0;i<state->nkey;++i)
+	{
+		key = &state->keys[i];
+		if (key->varno == INNER_VAR)
+			slot = econtext->ecxt_innertuple;
+		else if (key->varno == OUTER_VAR)
+			slot = econtext->ecxt_outertuple;
+		else
+			slot = econtext->ecxt_scantuple;
+
+		datum = slot_getattr(slot, key->attno, &null);
+		if (null)
+		{
+			/* hash_combin_mod is strict, when null reduce to first node */
+			return ObjectIdGetDatum(state->oids[0]);
+		}
+
+		switch(key->kind)
+		{
+		case RK_INT4_VALUE:
+			value = (uint32)DatumGetInt32(datum);
+			break;
+		case RK_HASH_INT2:
+			value = DatumGetUInt32(hash_uint32((int32)DatumGetInt16(datum)));
+			break;
+		case RK_HASH_INT4:
+			value = DatumGetUInt32(hash_uint32(DatumGetInt32(datum)));
+			break;
+		case RK_HASH_INT8:
+			{
+				/* same as hashint8 */
+				int64	val = DatumGetInt64(datum);
+				uint32	lohalf = (uint32) val;
+				uint32	hihalf = (uint32) (val >> 32);
+
+				lohalf ^= (val >= 0) ? hihalf : ~hihalf;
+				value = DatumGetUInt32(hash_uint32(lohalf));
+			}
+			break;
+		case RK_HASH_OID:
+			value = DatumGetUInt32(hash_uint32((uint32)DatumGetObjectId(datum)));
+			break;
+		case RK_HASH_TEXT:
+			{
+				text   *txt = DatumGetTextPP(datum);
+
+				value = DatumGetUInt32(hash_any((unsigned char *) VARDATA_ANY(txt),
+												VARSIZE_ANY_EXHDR(txt)));
+				if ((Pointer)txt != DatumGetPointer(datum))
+					pfree(txt);
+			}
+			break;
+		default:
+			elog(ERROR, "unknown reduce key kind %d", key->kind);
+			value = 0;	/* keep compiler quiet */
+		}
+
+		if (i == 0)
+			hashval = value;
+		else
+			hashval = hash_combine(hashval, value);
+	}
+
+	return ObjectIdGetDatum(state->oids[hashval % state->modulus]);
+}
+
 ReduceExprState* ExecInitReduceExpr(Expr *expr)
 {
 	ReduceExprState *result = palloc(sizeof(ReduceExprState));
+	ReduceHashExprState *hash_state;
 
 	if (IsA(expr, FuncExpr) &&
 		((FuncExpr*)expr)->funcid == F_ARRAY_UNNEST)
@@ -2783,6 +3047,10 @@ ReduceExprState* ExecInitReduceExpr(Expr *expr)
 	{
 		result->state = NULL;
 		result->evalfunc = ExecReduceSelfNodeExpr;
+	}else if ((hash_state = InitReduceHashExprState(expr)) != NULL)
+	{
+		result->state = hash_state;
+		result->evalfunc = (Datum(*)(void*, ExprContext*, bool*,ExprDoneCond*))ExecReduceHashExpr;
 	}else
 	{
 		result->state = ExecInitExpr(expr, NULL);
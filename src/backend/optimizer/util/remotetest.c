@@ -297,6 +297,7 @@ List *relation_remote_by_constraints_base(PlannerInfo *root, Node *quals, Relati
 	List		   *null_test_list;
 	ListCell	   *lc;
 	int				i;
+	int				count;
 
 	MemSet(&context, 0, sizeof(context));
 	AssertArg(loc_info != NULL);
@@ -339,12 +340,22 @@ List *relation_remote_by_constraints_base(PlannerInfo *root, Node *quals, Relati
 
 	new_clauses = make_new_qual_list(&context, quals, root == NULL);
 
-	i=0;
+	/* test each remainder when distribute by hash or modulo, or each node */
+	count = context.partition_expr ? LocatorModulus(loc_info) : list_length(loc_info->nodeids);
 	result = NIL;
-	foreach(lc, loc_info->nodeids)
+	for (i=0;i<count;++i)
 	{
 		Expr *expr;
-		Oid node_oid = lfirst_oid(lc);
+		Oid node_oid;
+
+		if (context.partition_expr)
+			node_oid = LocatorBucketNode(loc_info, i);
+		else
+			node_oid = list_nth_oid(loc_info->nodeids, i);
+		/* other bucket of this node already can not refuted */
+		if (list_member_oid(result, node_oid))
+			continue;
+
 		MemoryContextSwitchTo(temp_mctx);
 		MemoryContextResetAndDeleteChildren(temp_mctx);
 		temp_constraints = list_copy(safe_constraints);
@@ -374,7 +385,6 @@ List *relation_remote_by_constraints_base(PlannerInfo *root, Node *quals, Relati
 			result = list_append_unique_oid(result, node_oid);
 			/* MemoryContextSwitchTo(...) */
 		}
-		++i;
 	}
 
 	MemoryContextSwitchTo(old_mctx);
@@ -459,7 +469,7 @@ static Expr* makePartitionExpr(RelationLocInfo *loc_info, Node *node)
 				 errmsg("not distribute by only one expression not support yet")));
 	key = FirstLocKeyInfo(loc_info);
 
-	n = list_length(loc_info->nodeids);
+	n = LocatorModulus(loc_info);
 
 	count = makeConst(INT4OID,
 					  -1,
@@ -907,6 +917,14 @@ static bool push_const_to_aux_col_info(GatherAuxColumnInfo *info, Const *c, bool
 			return false;	/* can not coerce */
 	}
 
+	/* make sure have space for all values, large IN list need it */
+	if (info->cur_size + count > info->max_size)
+	{
+		uint32 new_size = Max(info->max_size * 2, info->cur_size + count);
+		info->datum = repalloc(info->datum, sizeof(Datum) * new_size);
+		info->max_size = new_size;
+	}
+
 	for(i=0;i<count;++i)
 	{
 		if (nulls[i])
@@ -936,13 +954,6 @@ static bool push_const_to_aux_col_info(GatherAuxColumnInfo *info, Const *c, bool
 			value = datums[i];
 		}
 
-		Assert(info->cur_size <= info->max_size);
-		if (info->cur_size == info->max_size)
-		{
-			uint32 new_size = info->max_size + AUX_SCAN_INFO_SIZE_STEP;
-			info->datum = repalloc(info->datum, new_size);
-			info->max_size = new_size;
-		}
 		Assert(info->cur_size < info->max_size);
 		info->datum[info->cur_size++] = value;
 	}
@@ -957,7 +968,7 @@ static void push_aux_col_info_to_gather(GatherAuxInfoContext *context, GatherAux
 	if (old_info->max_size < old_info->cur_size+info->cur_size)
 	{
 		uint32 new_size = old_info->max_size + info->max_size;
-		old_info->datum = repalloc(old_info->datum, new_size);
+		old_info->datum = repalloc(old_info->datum, sizeof(Datum) * new_size);
 		old_info->max_size = new_size;
 	}
 	Assert(old_info->cur_size+info->cur_size <= old_info->max_size);
@@ -1290,8 +1301,8 @@ static List* get_aux_table_execute_on(GatherAuxColumnInfo *info)
 		ExprContext *econtext = info->econtext;
 		ParamExecData *param = info->param_data;
 		Bitmapset *bms = NULL;
-		ListCell *lc;
 		uint32 i;
+		int x;
 		bool isnull;
 
 		param->isnull = false;
@@ -1317,12 +1328,10 @@ static List* get_aux_table_execute_on(GatherAuxColumnInfo *info)
 			bms = bms_add_member(bms, DatumGetInt32(value));
 		}
 
-		i = 0;
-		foreach(lc, info->rel->rd_locator_info->nodeids)
-		{
-			if (bms_is_member(i++, bms))
-				exec_on = lappend_oid(exec_on, lfirst_oid(lc));
-		}
+		x = -1;
+		while ((x = bms_next_member(bms, x)) >= 0)
+			exec_on = list_append_unique_oid(exec_on,
+											 LocatorBucketNode(info->rel->rd_locator_info, x));
 		bms_free(bms);
 	}else
 	{
@@ -1376,6 +1385,22 @@ static GatherMainRelExecOn* get_main_table_execute_on(GatherAuxInfoContext *cont
 	exec_on->funcs.HookCopyOut = process_remote_aux_tuple;
 	PQNListExecFinish(list_conn, NULL, &exec_on->funcs, true);
 
+	/* remove duplicate tids, they come from duplicate values */
+	if (exec_on->cur_tid_size > 1)
+	{
+		uint32 i,n;
+		qsort(exec_on->tids,
+			  exec_on->cur_tid_size,
+			  sizeof(ItemPointerData),
+			  (int(*)(const void*, const void*))ItemPointerCompare);
+		for (i=n=1;i<exec_on->cur_tid_size;++i)
+		{
+			if (!ItemPointerEquals(&exec_on->tids[i], &exec_on->tids[n-1]))
+				exec_on->tids[n++] = exec_on->tids[i];
+		}
+		exec_on->cur_tid_size = n;
+	}
+
 	ExecDropSingleTupleTableSlot(exec_on->slot);
 	exec_on->slot = NULL;
 	FreeTupleDesc(result_desc);
@@ -1401,18 +1426,12 @@ static bool process_remote_aux_tuple(PQNHookFunctions *pub, struct pg_conn *conn
 
 static void push_tid_to_exec_on(GatherMainRelExecOn *context, Datum datum)
 {
-	uint32	i,count = context->cur_tid_size;
 	ItemPointer itemPtr = (ItemPointer)DatumGetPointer(datum);
 
-	for (i=0;i<count;++i)
-	{
-		if (ItemPointerEquals(itemPtr, &context->tids[i]))
-			return;
-	}
-
+	/* duplicates are removed after all tuples received */
 	if (context->cur_tid_size == context->max_tid_size)
 	{
-		uint32 new_size = context->max_tid_size + AUX_SCAN_INFO_SIZE_STEP;
+		uint32 new_size = context->max_tid_size * 2;
 		context->tids = repalloc(context->tids, new_size * sizeof(ItemPointerData));
 		context->max_tid_size = new_size;
 	}
@@ -5073,6 +5073,8 @@ static List* make_aux_rel_result_vars_rel(RangeTblEntry *rte, Relation aux_rel,
 {
 	List *result = NIL;
 	const FormData_pg_attribute *attr;
+	TupleDesc desc = RelationGetDescr(aux_rel);
+	int i;
 
 #if (Anum_aux_table_auxnodeid == 1)
 	attr = SystemAttributeDefinition(XC_NodeIdAttributeNumber);
@@ -5104,6 +5106,18 @@ static List* make_aux_rel_result_vars_rel(RangeTblEntry *rte, Relation aux_rel,
 #error need change var list order
 #endif
 
+	/* INCLUDE columns */
+	for (i=Anum_aux_table_key;i<desc->natts;++i)
+	{
+		attr = TupleDescAttr(desc, i);
+		if (attr->attisdropped)
+			continue;
+		result = lappend(result,
+						 get_ts_scan_var_for_aux_key(rte,
+													 NameStr(attr->attname),
+													 aux_relid));
+	}
+
 	return result;
 }
 
@@ -3279,7 +3279,7 @@ copy_generic_opt_arg_list_item:
  *
  *****************************************************************************/
 CreateAuxStmt:	CREATE AUXILIARY TABLE opt_aux_name ON
-			qualified_name '(' ColId OptIndex ')'
+			qualified_name '(' ColId OptIndex ')' opt_include
 			OptTableSpace OptDistributeBy OptSubCluster
 				{
 					CreateAuxStmt *n = makeNode(CreateAuxStmt);
@@ -3296,13 +3296,13 @@ CreateAuxStmt:	CREATE AUXILIARY TABLE opt_aux_name ON
 					cs->constraints = NIL;
 					cs->options = NULL;
 					cs->oncommit = ONCOMMIT_NOOP;
-					cs->tablespacename = $11;
+					cs->tablespacename = $12;
 					cs->if_not_exists = false;
 					cs->auxiliary = true;
 					cs->master_relation = $6;	/* master relation rangevar */
 					cs->aux_attnum = InvalidAttrNumber;	/* set when AnalyzeRewriteCreateAuxStmt */
-					cs->distributeby = $12;
-					cs->subcluster = $13;
+					cs->distributeby = $13;
+					cs->subcluster = $14;
 					if (is)
 					{
 						IndexElem *ie = makeNode(IndexElem);
@@ -3322,6 +3322,7 @@ CreateAuxStmt:	CREATE AUXILIARY TABLE opt_aux_name ON
 					n->index_stmt = (Node *) is;
 					n->master_relation = $6;
 					n->aux_column = $8;
+					n->aux_include = $11;
 					$$ = (Node *) n;
 				}
 		;
@@ -5203,6 +5203,33 @@ dup_node_:
 	return 0;	/* never run, keep compiler quiet */
 }
 
+/*
+ * Hash into hash_distribute_buckets virtual buckets and assign buckets to
+ * nodes round-robin, node expansion only need move whole buckets.  Only for
+ * CREATE TABLE, ALTER TABLE keeps the distribution it asked for.
+ */
+List *transformDistributeBuckets(char loc_type, int count, List *values)
+{
+	ListCell   *lc;
+	int			i;
+
+	if (loc_type != LOCATOR_TYPE_HASH ||
+		values != NIL ||
+		hash_distribute_buckets <= count)
+		return values;
+
+	for (i=0;i<count;++i)
+		values = lappend(values, list_make1_int(i));
+	for (lc=list_head(values);i<hash_distribute_buckets;++i)
+	{
+		lfirst(lc) = lappend_int(lfirst(lc), i);
+		if ((lc = lnext(values, lc)) == NULL)
+			lc = list_head(values);
+	}
+
+	return values;
+}
+
 static bool
 checkAttachPartitionTableInfo(Relation parent_rel, Relation sub_rel)
 {
@@ -5224,12 +5251,13 @@ checkAttachPartitionTableInfo(Relation parent_rel, Relation sub_rel)
 	/* Check the partition type, key and node. */
 	if (a->locatorType != b->locatorType ||
 		list_length(a->keys) != list_length(b->keys) ||
-		list_length(a->nodeids) != list_length(a->nodeids))
+		list_length(a->nodeids) != list_length(b->nodeids))
 		return false;
 
 	if (IsRelationDistributedByValue(a))
 	{
-		if (equal(a->nodeids, b->nodeids) == false)
+		if (equal(a->nodeids, b->nodeids) == false ||
+			equal(a->buckets, b->buckets) == false)
 			return false;
 	}else if(list_equal_oid_without_order(a->nodeids, b->nodeids) == false)
 	{
@@ -135,12 +135,14 @@ GetPreferredRepNodeIds(List *nodeids)
  * compute_modulo
  */
 static Oid
-get_nodeid_from_modulo(int modulo, List *nodeids)
+get_nodeid_from_modulo(int modulo, RelationLocInfo *rel_loc_info)
 {
-	if (nodeids == NIL || modulo >= list_length(nodeids) || modulo < 0)
+	if (rel_loc_info->nodeids == NIL ||
+		modulo >= LocatorModulus(rel_loc_info) ||
+		modulo < 0)
 		ereport(ERROR, (errmsg("Modulo value out of range\n")));
 
-	return list_nth_oid(nodeids, modulo);
+	return LocatorBucketNode(rel_loc_info, modulo);
 }
 
 
@@ -297,12 +299,13 @@ IsLocatorInfoEqual(const RelationLocInfo *a, const RelationLocInfo *b)
 	if (a->relid != b->relid ||
 		a->locatorType != b->locatorType ||
 		list_length(a->keys) != list_length(b->keys) ||
-		list_length(a->nodeids) != list_length(a->nodeids))
+		list_length(a->nodeids) != list_length(b->nodeids))
 		return false;
 
 	if (IsRelationDistributedByValue(a))
 	{
-		if (equal(a->nodeids, b->nodeids) == false)
+		if (equal(a->nodeids, b->nodeids) == false ||
+			equal(a->buckets, b->buckets) == false)
 			return false;
 	}else if(list_equal_oid_without_order(a->nodeids, b->nodeids) == false)
 	{
@@ -439,15 +442,15 @@ GetRelationNodes(RelationLocInfo *rel_loc_info,
 						int32 hashVal = execHashValue(dist_col_values[0],
 													  dist_col_types[0],
 													  DEFAULT_COLLATION_OID);
-						modulo = (uint32)hashVal % (uint32)list_length(rel_loc_info->nodeids);
+						modulo = (uint32)hashVal % (uint32)LocatorModulus(rel_loc_info);
 					}else
 					{
 						modulo = execModuloValue(dist_col_values[0],
 												dist_col_types[0],
-												list_length(rel_loc_info->nodeids));
+												LocatorModulus(rel_loc_info));
 					}
 				}
-				exec_nodes->nodeids = list_make1_oid(get_nodeid_from_modulo(modulo, rel_loc_info->nodeids));
+				exec_nodes->nodeids = list_make1_oid(get_nodeid_from_modulo(modulo, rel_loc_info));
 			}
 			break;
 
@@ -719,7 +722,7 @@ RelationIdBuildLocator(Oid relid)
 		char *str = text_to_cstring(txt);
 		List *list = stringToNode(str);
 		ListCell *lc,*lc2;
-		Oid *oids;
+		int *buckets;
 		uint32 count = 0;
 
 		if (!IsA(list, List) ||
@@ -738,7 +741,8 @@ RelationIdBuildLocator(Oid relid)
 								Anum_pgxc_class_pcvalues, relid)));
 			count += list_length(lfirst(lc));
 		}
-		oids = palloc0(sizeof(oids[0]) * count);
+		buckets = palloc(sizeof(buckets[0]) * count);
+		memset(buckets, -1, sizeof(buckets[0]) * count);
 		j = 0;
 		foreach (lc, list)
 		{
@@ -746,29 +750,28 @@ RelationIdBuildLocator(Oid relid)
 			{
 				if (lfirst_int(lc2) < 0 ||
 					lfirst_int(lc2) >= count ||
-					oids[lfirst_int(lc2)] != InvalidOid)
+					buckets[lfirst_int(lc2)] != -1)
 				{
 					ereport(ERROR,
 							(errcode(ERRCODE_DATA_CORRUPTED),
 							 errmsg("invalid column(%d) data for pgxc_class(%u)",
 									Anum_pgxc_class_pcvalues, relid)));
 				}
-				oids[lfirst_int(lc2)] = pgxc_class->nodeoids.values[j];
+				buckets[lfirst_int(lc2)] = j;
 			}
 			++j;
 		}
+		/* nodeids keep one entry each node, buckets map remainder to it */
 		for (j=0; j<count; ++j)
-			relationLocInfo->nodeids = lappend_oid(relationLocInfo->nodeids, oids[j]);
+			relationLocInfo->buckets = lappend_int(relationLocInfo->buckets, buckets[j]);
 		pfree(str);
-		pfree(oids);
+		pfree(buckets);
 		list_free_deep(list);
 	}
-	else
-	{
-		for (j = 0; j < pgxc_class->nodeoids.dim1; j++)
-			relationLocInfo->nodeids = lappend_oid(relationLocInfo->nodeids,
-												   pgxc_class->nodeoids.values[j]);
-	}
+
+	for (j = 0; j < pgxc_class->nodeoids.dim1; j++)
+		relationLocInfo->nodeids = lappend_oid(relationLocInfo->nodeids,
+											   pgxc_class->nodeoids.values[j]);
 
 	if (IsCnMaster())
 	{
@@ -863,6 +866,7 @@ CopyRelationLocInfo(RelationLocInfo *srcInfo)
 		destInfo->keys = lappend(destInfo->keys, key);
 	}
 	destInfo->values = copyObject(srcInfo->values);
+	destInfo->buckets = list_copy(srcInfo->buckets);
 	destInfo->masternodeids = list_copy(srcInfo->masternodeids);
 	destInfo->slavenodeids = list_copy(srcInfo->slavenodeids);
 	Assert(srcInfo->nodeids == srcInfo->masternodeids ||
@@ -906,6 +910,7 @@ FreeRelationLocInfo(RelationLocInfo *relationLocInfo)
 		}
 		list_free(relationLocInfo->keys);
 		list_free(relationLocInfo->values);
+		list_free(relationLocInfo->buckets);
 		pfree(relationLocInfo);
 	}
 }
@@ -1071,7 +1076,7 @@ GetInvolvedNodes(RelationLocInfo *rel_loc,
 				int nnodes;
 
 				Assert(rel_loc->nodeids);
-				nnodes = list_length(rel_loc->nodeids);
+				nnodes = LocatorModulus(rel_loc);
 				Assert(nnodes > 0);
 
 				if(dist_nulls[0])
@@ -1092,7 +1097,7 @@ GetInvolvedNodes(RelationLocInfo *rel_loc,
 					}else
 						modulo = execModuloValue(dist_values[0], dist_types[0], nnodes);
 				}
-				node_list = list_make1_oid(list_nth_oid(rel_loc->nodeids, modulo));
+				node_list = list_make1_oid(LocatorBucketNode(rel_loc, modulo));
 			}
 			break;
 
@@ -1229,6 +1234,25 @@ adbGetRelationNodeids(Oid relid)
 }
 
 /* this is an transition function */
+/*
+ * Get node of each remainder of a hash or modulo locator, a node appear
+ * more than once when it owns more than one bucket.
+ */
+List *GetLocatorBucketNodes(const RelationLocInfo *loc)
+{
+	List	   *result;
+	ListCell   *lc;
+
+	if (loc->buckets == NIL)
+		return list_copy(loc->nodeids);
+
+	result = NIL;
+	foreach (lc, loc->buckets)
+		result = lappend_oid(result, list_nth_oid(loc->nodeids, lfirst_int(lc)));
+
+	return result;
+}
+
 AttrNumber GetFirstLocAttNumIfOnlyOne(RelationLocInfo *loc)
 {
 	LocatorKeyInfo *key;
@@ -52,6 +52,7 @@
 #include "utils/fmgroids.h"
 #include "utils/inval.h"
 #include "utils/memutils.h"
+#include "utils/portal.h"
 #include "utils/ruleutils.h"
 #include "../../src/interfaces/libpq/libpq-fe.h"
 #include "utils/syscache.h"
@@ -1112,11 +1113,23 @@ DoReduceDataForShadowRel(Relation masterRel,
 	TupleDesc		scan_desc;
 	ShadowReduceState state;
 	bool			needReduce = true;
+	bool			freeze;
 
 	Assert(masterRel && shadowRel);
 	Assert(redistcopy);
 	Assert(list_length(rnodes) > 0);
 
+	/*
+	 * The shadow relation is created in this transaction and swapped with
+	 * the master under AccessExclusiveLock, like CLUSTER we can insert
+	 * frozen tuples, so a huge table is not read and written again by the
+	 * next anti-wraparound vacuum. Same conditions as COPY FREEZE.
+	 */
+	InvalidateCatalogSnapshot();
+	freeze = (shadowRel->rd_createSubid == GetCurrentSubTransactionId() &&
+			  ThereAreNoPriorRegisteredSnapshots() &&
+			  ThereAreNoReadyPortals());
+
 	PushActiveSnapshot(GetCatalogSnapshot(RelationGetRelid(masterRel)));
 
 	shadow_context = AllocSetContextCreate(CurrentMemoryContext,
@@ -1147,7 +1160,7 @@ DoReduceDataForShadowRel(Relation masterRel,
 							redistcopy->reduce,
 							rnodes,
 							redistcopy->id,
-							false,
+							freeze,
 							NextRowForDistribScanNone,
 							&state);
 	}
@@ -1156,7 +1169,7 @@ DoReduceDataForShadowRel(Relation masterRel,
 							redistcopy->reduce,
 							rnodes,
 							redistcopy->id,
-							false,
+							freeze,
 							NextRowForPadding,
 							&state);
 
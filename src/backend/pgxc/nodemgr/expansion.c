@@ -18,6 +18,7 @@
 #include "catalog/pg_collation.h"
 #include "commands/copy.h"
 #include "commands/dbcommands.h"
+#include "commands/vacuum.h"
 #include "executor/clusterReceiver.h"
 #include "executor/execCluster.h"
 #include "executor/executor.h"
@@ -57,6 +58,10 @@
 
 void RemoveCleanInfoFromExpansionClean(Oid relOid);
 
+/* GUC parameters, -1 uses vacuum_cost_delay and vacuum_cost_limit */
+double		expansion_clean_cost_delay = -1;
+int			expansion_clean_cost_limit = -1;
+
 #define EXPANSION_QUEUE_SIZE	(16*1024)
 
 #define EW_TOC_MAGIC				UINT64CONST(0xaf93442bbc367cfd)
@@ -104,6 +109,7 @@ typedef struct ExpansionClean
 	TupleTableSlot *slot;
 	BlockNumber		max_block;
 	bool			limit_insert;
+	uint8		   *clean_blocks;	/* blocks known to hold no moved rows */
 }ExpansionClean;
 
 static void CreateSHMQPipe(dsm_segment *seg, shm_mq_handle** mqh_sender, shm_mq_handle **mqh_receiver, bool is_worker)
@@ -803,6 +809,31 @@ re_loop_:
 	return least_common;
 }
 
+/*
+ * When old node has enough remainders (virtual buckets), we can move
+ * whole buckets to new nodes without change modulus, even if the
+ * count of buckets is not a multiple of new node count
+ */
+#define MIN_BUCKETS_PER_NODE	16
+static bool CanMoveHashModuloBuckets(List *old_values, oidvector *old_nodeoids, List *expansion)
+{
+	ListCell   *lc;
+	List	   *list;
+	uint32		count;
+
+	foreach (lc, expansion)
+	{
+		list = lfirst(lc);
+		Assert(IsA(list, OidList));
+		count = GetOldModulus(old_values, old_nodeoids, linitial_oid(list));
+		if (count % list_length(list) != 0 &&
+			count < list_length(list) * MIN_BUCKETS_PER_NODE)
+			return false;
+	}
+
+	return true;
+}
+
 static void ReplaceHashModuloExpansionNode(Oid *oids, uint32 count, List *expansion)
 {
 	ListCell	   *lc;
@@ -820,7 +851,7 @@ static void ReplaceHashModuloExpansionNode(Oid *oids, uint32 count, List *expans
 			bms = bms_add_member(bms, n);
 	}
 	Assert(bms_membership(bms) == BMS_MULTIPLE);
-	Assert(bms_num_members(bms) % list_length(expansion) == 0);
+	Assert(bms_num_members(bms) >= list_length(expansion));
 
 	while (bms_is_empty(bms) == false)
 	{
@@ -828,8 +859,9 @@ static void ReplaceHashModuloExpansionNode(Oid *oids, uint32 count, List *expans
 		n = bms_first_member(bms);
 		lc = list_head(expansion);
 
-		/* replace */
-		while ((lc=lnext(expansion, lc)) != NULL)
+		/* replace, last round maybe not enough for all new nodes */
+		while ((lc=lnext(expansion, lc)) != NULL &&
+			   bms_is_empty(bms) == false)
 		{
 			n = bms_first_member(bms);
 			oids[n] = lfirst_oid(lc);
@@ -861,7 +893,10 @@ static HeapTuple ExpansionHashModuloUpdate(Form_pgxc_class form_class, HeapTuple
 	}
 
 	/* get best new modulus */
-	new_modulus = GetBestMultiple(old_values, &form_class->nodeoids, expansion) * old_modulus;
+	if (CanMoveHashModuloBuckets(old_values, &form_class->nodeoids, expansion))
+		new_modulus = old_modulus;
+	else
+		new_modulus = GetBestMultiple(old_values, &form_class->nodeoids, expansion) * old_modulus;
 
 	/* expansion old modulus to new modulus */
 	new_oid_remainder = palloc(sizeof(Oid)*new_modulus);
@@ -1428,37 +1463,25 @@ static bool HaveItemPointerVar(Node *node, void *context)
 	return expression_tree_walker(node, HaveItemPointerVar, NULL);
 }
 
-void RelationBuildExpansionClean(Relation rel)
+/*
+ * Build the clean state of a relation: tuples on blocks up to max_block are
+ * only visible when the expression is true for them.  expr_str is the
+ * expression as stored in adb_clean.clnexpr.
+ */
+struct ExpansionClean* CreateExpansionClean(Relation rel, BlockNumber max_block, const char *expr_str)
 {
 	MemoryContext volatile context;
 	MemoryContext volatile oldcontext;
-	HeapTuple		tuple;
 	ExpansionClean *clean;
-	Form_adb_clean	form_clean;
-	text		   *txt;
-	char		   *str;
-	if (RelationGetRelid(rel) < FirstNormalObjectId ||
-		!IsDnNode())
-		return;
-
-	tuple = SearchSysCache2(ADBCLEANOID, ObjectIdGetDatum(MyDatabaseId), ObjectIdGetDatum(RelationGetRelid(rel)));
-	if (!HeapTupleIsValid(tuple))
-		return;
 
 	context = AllocSetContextCreate(CacheMemoryContext, "expansion clean", ALLOCSET_DEFAULT_SIZES);
 	oldcontext = MemoryContextSwitchTo(context);
 	PG_TRY();
 	{
-		form_clean = (Form_adb_clean) GETSTRUCT(tuple);
 		clean = palloc0(sizeof(*clean));
 		clean->mcontext = CurrentMemoryContext;
-		clean->max_block = form_clean->clnblocks;
-		txt = pg_detoast_datum_packed(&form_clean->clnexpr);
-		str = text_to_cstring(txt);
-		clean->expr = stringToNode(str);
-		pfree(str);
-		if (txt != &form_clean->clnexpr)
-			pfree(txt);
+		clean->max_block = max_block;
+		clean->expr = stringToNode(expr_str);
 		clean->state = ExecInitExpr(clean->expr, NULL);
 		clean->econtext = CreateStandaloneExprContext();
 		clean->slot = table_slot_create(rel, NULL);
@@ -1477,9 +1500,32 @@ void RelationBuildExpansionClean(Relation rel)
 		PG_RE_THROW();
 	}PG_END_TRY();
 
-	ReleaseSysCache(tuple);
 	MemoryContextSwitchTo(oldcontext);
-	rel->rd_clean = clean;
+	return clean;
+}
+
+void RelationBuildExpansionClean(Relation rel)
+{
+	HeapTuple		tuple;
+	Form_adb_clean	form_clean;
+	text		   *txt;
+	char		   *str;
+	if (RelationGetRelid(rel) < FirstNormalObjectId ||
+		!IsDnNode())
+		return;
+
+	tuple = SearchSysCache2(ADBCLEANOID, ObjectIdGetDatum(MyDatabaseId), ObjectIdGetDatum(RelationGetRelid(rel)));
+	if (!HeapTupleIsValid(tuple))
+		return;
+
+	form_clean = (Form_adb_clean) GETSTRUCT(tuple);
+	txt = pg_detoast_datum_packed(&form_clean->clnexpr);
+	str = text_to_cstring(txt);
+	rel->rd_clean = CreateExpansionClean(rel, form_clean->clnblocks, str);
+	pfree(str);
+	if (txt != &form_clean->clnexpr)
+		pfree(txt);
+	ReleaseSysCache(tuple);
 }
 
 void DestroyExpansionClean(struct ExpansionClean *clean)
@@ -1509,12 +1555,41 @@ bool IsExpansionCleanEqual(struct ExpansionClean *a, struct ExpansionClean *b)
 	return false;
 }
 
+static inline bool IsExpansionCleanBlock(ExpansionClean *clean, BlockNumber blk)
+{
+	return blk > clean->max_block ||
+		   (clean->clean_blocks != NULL &&
+			(clean->clean_blocks[blk / BITS_PER_BYTE] & (1 << (blk % BITS_PER_BYTE))) != 0);
+}
+
+/*
+ * Rows which moved to other nodes never come back into a block, so once every
+ * tuple on a page passed the clean expression the whole page can skip it.
+ * Not for "ctid" based clean, tuple versions change their ctid.
+ */
+bool NeedTestExpansionCleanBlock(struct ExpansionClean *clean, BlockNumber blk)
+{
+	return !IsExpansionCleanBlock(clean, blk);
+}
+
+void MarkExpansionCleanBlock(struct ExpansionClean *clean, BlockNumber blk)
+{
+	if (clean->limit_insert ||
+		blk > clean->max_block)
+		return;
+
+	if (clean->clean_blocks == NULL)
+		clean->clean_blocks = MemoryContextAllocZero(clean->mcontext,
+													 clean->max_block / BITS_PER_BYTE + 1);
+	clean->clean_blocks[blk / BITS_PER_BYTE] |= (1 << (blk % BITS_PER_BYTE));
+}
+
 bool ExecTestExpansionClean(struct ExpansionClean *clean, void *tup)
 {
 	Datum			datum;
 	bool			isnull;
 
-	if (ItemPointerGetBlockNumberNoCheck(&((HeapTuple)tup)->t_self) > clean->max_block)
+	if (IsExpansionCleanBlock(clean, ItemPointerGetBlockNumberNoCheck(&((HeapTuple)tup)->t_self)))
 	{
 		datum = BoolGetDatum(true);
 	}else
@@ -1537,7 +1612,7 @@ ExecTestSlotExpansionClean(struct ExpansionClean *clean, TupleTableSlot *slot)
 	bool			isnull;
 	Assert(!TTS_EMPTY(slot));
 
-	if (ItemPointerGetBlockNumberNoCheck(&slot->tts_tid) > clean->max_block)
+	if (IsExpansionCleanBlock(clean, ItemPointerGetBlockNumberNoCheck(&slot->tts_tid)))
 		return true;
 
 	clean->econtext->ecxt_scantuple = slot;
@@ -1550,7 +1625,7 @@ ExecTestSlotExpansionClean(struct ExpansionClean *clean, TupleTableSlot *slot)
 
 bool NeedTestExpansionClean(struct ExpansionClean *clean, const ItemPointer tid)
 {
-	return ItemPointerGetBlockNumberNoCheck(tid) <= clean->max_block;
+	return !IsExpansionCleanBlock(clean, ItemPointerGetBlockNumberNoCheck(tid));
 }
 
 BlockNumber GetExpansionInsertLimitBlock(struct ExpansionClean *clean)
@@ -1822,6 +1897,9 @@ static int ProcessClusterCleanCommand(ClusterCleanContext *context, const char *
 		}
 		UnlockReleaseBuffer(buffer);
 		CHECK_FOR_INTERRUPTS();
+
+		/* throttle, see ClusterExpansionClean() */
+		vacuum_delay_point();
 	}
 
 end_clean_rel_:
@@ -1841,13 +1919,50 @@ end_clean_rel_:
 	return 0;
 }
 
+/*
+ * New datanodes are seeded as physical copies of the node they split from,
+ * and pgxc_class moves whole buckets to them at once, there is no row
+ * stream to migrate bucket by bucket.  What is left to do online is this
+ * clean, which deletes the rows of buckets a node no longer owns.  It runs
+ * one relation at a time, each finished relation is removed from adb_clean
+ * so an interrupted clean resumes with the remaining relations, and it is
+ * throttled by expansion_clean_cost_delay/limit to keep normal traffic
+ * latency stable.
+ */
 void ClusterExpansionClean(StringInfo mem_toc)
 {
 	ClusterCleanContext context;
+	double		save_cost_delay = VacuumCostDelay;
+	int			save_cost_limit = VacuumCostLimit;
+
 	MemSet(&context, 0, sizeof(context));
 	context.rel_clean = relation_open(AdbCleanRelationId, AccessExclusiveLock);
 	context.snapshot = GetActiveSnapshot();
-	SimpleNextCopyFromNewFE((SimpleCopyDataFunction)ProcessClusterCleanCommand, &context);
+
+	if (expansion_clean_cost_delay >= 0)
+		VacuumCostDelay = expansion_clean_cost_delay;
+	if (expansion_clean_cost_limit > 0)
+		VacuumCostLimit = expansion_clean_cost_limit;
+	VacuumCostActive = (VacuumCostDelay > 0);
+	VacuumCostBalance = 0;
+	VacuumPageHit = 0;
+	VacuumPageMiss = 0;
+	VacuumPageDirty = 0;
+	PG_TRY();
+	{
+		SimpleNextCopyFromNewFE((SimpleCopyDataFunction)ProcessClusterCleanCommand, &context);
+	}
+	PG_CATCH();
+	{
+		VacuumCostActive = false;
+		VacuumCostDelay = save_cost_delay;
+		VacuumCostLimit = save_cost_limit;
+		PG_RE_THROW();
+	}
+	PG_END_TRY();
+	VacuumCostActive = false;
+	VacuumCostDelay = save_cost_delay;
+	VacuumCostLimit = save_cost_limit;
 	relation_close(context.rel_clean, AccessExclusiveLock);
 	CacheInvalidateRelcacheAll();
 	InvalidateSystemCaches();
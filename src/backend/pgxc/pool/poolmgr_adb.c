@@ -10,19 +10,25 @@
 #include "access/xact.h"
 #include "catalog/pgxc_node.h"
 #include "commands/dbcommands.h"
+#include "executor/instrument.h"
+#include "funcapi.h"
 #include "libpq/pqformat.h"
 #include "libpq/pqsignal.h"
 #include "lib/ilist.h"
 #include "lib/stringinfo.h"
 #include "miscadmin.h"
+#include "pgstat.h"
 #include "pgxc/pgxc.h"
 #include "pgxc/poolmgr.h"
 #include "pgxc/poolutils.h"
 #include "postmaster/postmaster.h"		/* For Unix_socket_directories */
 #include "storage/ipc.h"
 #include "tcop/tcopprot.h"
+#include "utils/builtins.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
+#include "utils/timestamp.h"
+#include "utils/tuplestore.h"
 #include "utils/varlena.h"
 #include "utils/syscache.h"
 #include "libpq-fe.h"
@@ -65,6 +71,7 @@ static int PMGR_BACKTRACE_DETIAL()
 #define PM_MSG_ERROR				'E'
 #define PM_MSG_CLOSE_IDLE_CONNECT	'S'
 #define PM_MSG_GET_DBINFO_CONNECT	'T'
+#define PM_MSG_GET_POOL_STATS		'P'
 
 typedef enum SlotStateType
 {
@@ -172,6 +179,26 @@ typedef struct HostInfo
 	uint16		hosttype;
 }HostInfo;
 
+/*
+ * Upper bounds (in milliseconds) of the acquire wait histogram buckets,
+ * the last bucket counts everything slower
+ */
+#define POOL_WAIT_HIST_BUCKETS	5
+static const int64 pool_wait_hist_bounds[POOL_WAIT_HIST_BUCKETS-1] = {1, 10, 100, 1000};
+
+/* Counters of one ADBNodePool, reported by pool_get_node_stats() */
+typedef struct ADBNodePoolStats
+{
+	int64		acquire_count;		/* slots handed out to agents */
+	int64		acquire_wait_us;	/* total time agents waited for them */
+	int64		acquire_wait_hist[POOL_WAIT_HIST_BUCKETS];
+	int64		connect_count;		/* remote connections started */
+	int64		connect_failures;	/* connections failed to start or establish */
+	int64		retry_count;		/* reconnects of a slot got an error */
+	TimestampTz	last_retry_time;	/* 0 for never */
+	int64		reset_count;		/* "reset all" round trips */
+} ADBNodePoolStats;
+
 /* Pool of connections to specified pgxc node */
 typedef struct ADBNodePool
 {
@@ -182,6 +209,8 @@ typedef struct ADBNodePool
 	dlist_head	busy_slot;
 	char	   *connstr;
 	Size		last_idle;
+	Size		slot_count;	/* all slots, including the ones in no list */
+	ADBNodePoolStats stats;
 	struct DatabasePool *parent;
 } ADBNodePool;
 
@@ -222,6 +251,7 @@ typedef struct PoolAgent
 	uint32			session_magic;	/* magic number for session_params */
 	uint32			local_magic;	/* magic number for local_params */
 	List		   *list_wait;		/* List of ADBNodePoolSlot in connecting */
+	instr_time		acquire_start;	/* when the last PM_MSG_GET_CONNECT came */
 	MemoryContext	mctx;
 	/* Process ID of postmaster child process associated to pool agent */
 	int				pid;
@@ -307,6 +337,8 @@ static int pool_wait_pq(PGconn *conn);
 static int pq_custom_msg(PGconn *conn, char id, int msgLength);
 static void close_idle_connection(void);
 static void check_idle_slot(void);
+static void count_acquire_wait(ADBNodePool *node_pool, instr_time *start);
+static void send_pool_stats(PoolAgent *agent);
 
 #ifdef WITH_RDMA
 static bool pool_getstringdata(PoolPort *port, StringInfo msg);
@@ -1246,6 +1278,9 @@ PoolManagerGetConnectionsOid(List *oidlist)
 	pgsocket *fds;
 	StringInfoData buf;
 	int val;
+	int res;
+	instr_time wait_start;
+	instr_time wait_end;
 
 re_try_:
 	if (!poolHandle)
@@ -1290,7 +1325,14 @@ re_try_:
 	/* we reuse buf.data, here palloc maybe failed */
 	Assert(buf.maxlen >= sizeof(pgsocket)*val);
 	fds = (int*)(buf.data);
-	if(pool_recvfds(poolHandle->port.fdsock, fds, val) != 0)
+	INSTR_TIME_SET_CURRENT(wait_start);
+	pgstat_report_wait_start(WAIT_EVENT_POOL_CONNECT);
+	res = pool_recvfds(poolHandle->port.fdsock, fds, val);
+	pgstat_report_wait_end();
+	INSTR_TIME_SET_CURRENT(wait_end);
+	INSTR_TIME_ACCUM_DIFF(pgClusterUsage.remote_wait_time, wait_end, wait_start);
+	pgstat_report_cluster_wait();
+	if(res != 0)
 	{
 		pfree(fds);
 		return NULL;
@@ -1537,6 +1579,7 @@ static void agent_handle_input(PoolAgent * agent, StringInfo s)
 							(errcode(ERRCODE_PROTOCOL_VIOLATION),
 							 errmsg("invalid agtm port number %d", agent->agtm_port)));
 				}*/
+				INSTR_TIME_SET_CURRENT(agent->acquire_start);
 				agent_acquire_connections(agent, s);
 				AssertState(agent->list_wait != NIL);
 			}
@@ -1568,6 +1611,9 @@ static void agent_handle_input(PoolAgent * agent, StringInfo s)
 				close_idle_connection();
 			}
 			break;
+		case PM_MSG_GET_POOL_STATS:
+			send_pool_stats(agent);
+			break;
 #ifdef WITH_RDMA
 		case PM_MSG_GET_DBINFO_CONNECT:
 			{
@@ -1737,6 +1783,7 @@ send_agtm_port_:
 						break;
 					}
 					slot->slot_state = SLOT_STATE_QUERY_RESET_ALL;
+					slot->parent->stats.reset_count++;
 					Assert(slot->current_list != NULL_SLOT);
 					if (slot->current_list != BUSY_SLOT)
 					{
@@ -1862,8 +1909,14 @@ end_params_local_:
 									dlist_push_head(&slot->parent->busy_slot, &slot->dnode);
 									SET_SLOT_LIST(slot, BUSY_SLOT);
 								}
+							}else
+							{
+								node_pool->stats.connect_failures++;
 							}
 							slot->retry++;
+							node_pool->stats.connect_count++;
+							node_pool->stats.retry_count++;
+							node_pool->stats.last_retry_time = GetCurrentTimestamp();
 							ereport(PMGRLOG,
 									(errmsg("[pool] agent %p pid %d reconnect slot %p thimes %d",
 											agent, agent->pid, slot, slot->retry)));
@@ -1890,6 +1943,7 @@ end_params_local_:
 				Assert(slot->current_list != NULL_SLOT);
 				dlist_delete(&slot->dnode);
 				SET_SLOT_LIST(slot, NULL_SLOT);
+				count_acquire_wait(slot->parent, &agent->acquire_start);
 			}
 		}
 	}PG_CATCH();
@@ -2413,6 +2467,7 @@ static void idle_slot(ADBNodePoolSlot *slot, bool reset)
 			return;
 		}
 		slot->slot_state = SLOT_STATE_QUERY_RESET_ALL;
+		slot->parent->stats.reset_count++;
 		Assert(slot->current_list == NULL_SLOT);
 		dlist_push_head(&slot->parent->busy_slot, &slot->dnode);
 		SET_SLOT_LIST(slot, BUSY_SLOT);
@@ -2787,6 +2842,7 @@ static void process_slot_event(ADBNodePoolSlot *slot)
 		case PGRES_POLLING_FAILED:
 			save_slot_error(slot);
 			slot->slot_state = SLOT_STATE_ERROR;
+			slot->parent->stats.connect_failures++;
 			ereport(PMGRLOG,
 					(errmsg("process connectiong slot %p owner %p pid %d got error:\"%s\"",
 							slot, slot->owner, slot->owner ? slot->owner->pid:0, slot->last_error),
@@ -3026,6 +3082,8 @@ static void agent_acquire_connections(PoolAgent *agent, StringInfo msg)
 					PG_RE_THROW();
 				}PG_END_TRY();
 				node_pool->last_idle = 0;
+				node_pool->slot_count = 0;
+				MemSet(&node_pool->stats, 0, sizeof(node_pool->stats));
 				dlist_init(&node_pool->uninit_slot);
 				dlist_init(&node_pool->released_slot);
 				dlist_init(&node_pool->idle_slot);
@@ -3107,6 +3165,7 @@ static void agent_acquire_connections(PoolAgent *agent, StringInfo msg)
 				INIT_SLOT_PARAMS_MAGIC(slot, local_magic);
 				dlist_push_head(&node_pool->uninit_slot, &slot->dnode);
 				SET_SLOT_LIST(slot, UNINIT_SLOT);
+				node_pool->slot_count++;
 				ereport(PMGRLOG,
 						(errmsg("agent %p pid %d alloc new slot %p", agent, agent->pid, slot),
 						 PMGR_BACKTRACE_DETIAL()));
@@ -3120,6 +3179,7 @@ static void agent_acquire_connections(PoolAgent *agent, StringInfo msg)
 			{
 				static PGcustumFuns funs = {NULL, NULL, NULL, pq_custom_msg};
 				Assert(node_pool->connstr != NULL);
+				node_pool->stats.connect_count++;
 				slot->conn = PQconnectStart(node_pool->connstr);
 				if(slot->conn == NULL)
 				{
@@ -3128,6 +3188,7 @@ static void agent_acquire_connections(PoolAgent *agent, StringInfo msg)
 						,errmsg("out of memory")));
 				}else if(PQstatus(slot->conn) == CONNECTION_BAD)
 				{
+					node_pool->stats.connect_failures++;
 					ereport(ERROR,
 						(errmsg("%s", PQerrorMessage(slot->conn))));
 				}
@@ -3622,3 +3683,211 @@ re_try_:
 	pfree(buf.data);
 	PG_RETURN_BOOL(true);
 }
+
+static void count_acquire_wait(ADBNodePool *node_pool, instr_time *start)
+{
+	instr_time	now;
+	int64		wait_us;
+	int			i;
+
+	INSTR_TIME_SET_CURRENT(now);
+	INSTR_TIME_SUBTRACT(now, *start);
+	wait_us = INSTR_TIME_GET_MICROSEC(now);
+
+	node_pool->stats.acquire_count++;
+	node_pool->stats.acquire_wait_us += wait_us;
+	for (i=0;i<lengthof(pool_wait_hist_bounds);++i)
+	{
+		if (wait_us < pool_wait_hist_bounds[i] * 1000)
+			break;
+	}
+	node_pool->stats.acquire_wait_hist[i]++;
+}
+
+static int count_slot_list(dlist_head *head)
+{
+	dlist_iter	iter;
+	int			count = 0;
+
+	dlist_foreach(iter, head)
+		++count;
+	return count;
+}
+
+/*
+ * Send one row for each (database, user, node) pool, read by
+ * pool_get_node_stats()
+ */
+static void send_pool_stats(PoolAgent *agent)
+{
+	HASH_SEQ_STATUS hash_database_stats;
+	HASH_SEQ_STATUS hash_nodepool_status;
+	DatabasePool *db_pool;
+	ADBNodePool *node_pool;
+	StringInfoData buf;
+	int			count;
+	int			in_list;
+	int			n;
+	int			i;
+
+	pq_beginmessage(&buf, PM_MSG_GET_POOL_STATS);
+
+	count = 0;
+	if (htab_database != NULL)
+	{
+		hash_seq_init(&hash_database_stats, htab_database);
+		while((db_pool = hash_seq_search(&hash_database_stats)) != NULL)
+			count += hash_get_num_entries(db_pool->htab_nodes);
+	}
+	pool_sendint(&buf, count);
+
+	if (count > 0)
+	{
+		hash_seq_init(&hash_database_stats, htab_database);
+		while((db_pool = hash_seq_search(&hash_database_stats)) != NULL)
+		{
+			hash_seq_init(&hash_nodepool_status, db_pool->htab_nodes);
+			while((node_pool = hash_seq_search(&hash_nodepool_status)) != NULL)
+			{
+				pool_sendstring(&buf, db_pool->db_info.database);
+				pool_sendstring(&buf, db_pool->db_info.user_name);
+				pool_sendstring(&buf, node_pool->hostinfo.hostname);
+				pool_sendint(&buf, node_pool->hostinfo.port);
+
+				in_list = 0;
+				n = count_slot_list(&node_pool->idle_slot);
+				pool_sendint(&buf, n);
+				in_list += n;
+				n = count_slot_list(&node_pool->busy_slot);
+				pool_sendint(&buf, n);
+				in_list += n;
+				n = count_slot_list(&node_pool->released_slot);
+				pool_sendint(&buf, n);
+				in_list += n;
+				n = count_slot_list(&node_pool->uninit_slot);
+				pool_sendint(&buf, n);
+				in_list += n;
+				/* locked slots are in no list, they belong to a backend */
+				pool_sendint(&buf, (int)node_pool->slot_count - in_list);
+
+				pq_sendint64(&buf, node_pool->stats.acquire_count);
+				pq_sendint64(&buf, node_pool->stats.acquire_wait_us);
+				for (i=0;i<POOL_WAIT_HIST_BUCKETS;++i)
+					pq_sendint64(&buf, node_pool->stats.acquire_wait_hist[i]);
+				pq_sendint64(&buf, node_pool->stats.connect_count);
+				pq_sendint64(&buf, node_pool->stats.connect_failures);
+				pq_sendint64(&buf, node_pool->stats.retry_count);
+				pq_sendint64(&buf, node_pool->stats.last_retry_time);
+				pq_sendint64(&buf, node_pool->stats.reset_count);
+			}
+		}
+	}
+
+	pool_end_flush_msg(&agent->port, &buf);
+}
+
+/*
+ * Report slot counts and acquire/connect counters of every node pool
+ * in this node's pool manager.  Counters start from zero when the node
+ * pool is created, so pgxc_pool_reload() resets them.
+ */
+Datum pool_get_node_stats(PG_FUNCTION_ARGS)
+{
+#define POOL_NODE_STATS_COLS	21
+	ReturnSetInfo *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc	tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext oldcontext;
+	StringInfoData buf;
+	Datum		values[POOL_NODE_STATS_COLS];
+	bool		nulls[POOL_NODE_STATS_COLS];
+	TimestampTz	last_retry_time;
+	int			qtype;
+	int			count;
+	int			col;
+	int			i;
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	oldcontext = MemoryContextSwitchTo(rsinfo->econtext->ecxt_per_query_memory);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	if (!(IS_PGXC_COORDINATOR || IsConnFromCoord()))
+		return (Datum) 0;
+
+re_try_:
+	if (!poolHandle)
+		PoolManagerReconnect();
+	Assert(poolHandle != NULL);
+
+	pq_beginmessage(&buf, PM_MSG_GET_POOL_STATS);
+	if (pool_putmessage(&poolHandle->port, (char)(buf.cursor), buf.data, buf.len) != 0 ||
+		pool_flush(&poolHandle->port) != 0 ||
+		poolHandle->port.SendPointer != 0)
+	{
+		PoolManagerCloseHandle(poolHandle);
+		poolHandle = NULL;
+		pfree(buf.data);
+		goto re_try_;
+	}
+
+	/* Receive response */
+	resetStringInfo(&buf);
+	qtype = pool_getbyte(&poolHandle->port);
+	if (qtype == EOF)
+		ereport(ERROR,
+				(errcode(ERRCODE_CONNECTION_FAILURE),
+				 errmsg("unexpected EOF on pool manager connection")));
+	pool_getmessage(&poolHandle->port, &buf, 0);
+	if (qtype == PM_MSG_ERROR)
+		ereport(ERROR,
+				(errmsg("error message from poolmgr:%s", buf.len > 0 ? buf.data:"missing error text"),
+				 errnode_poolmgr()));
+	else if (qtype != PM_MSG_GET_POOL_STATS)
+		ereport(ERROR,
+				(errcode(ERRCODE_PROTOCOL_VIOLATION),
+				 errmsg("unexpected message code %d from pool manager", qtype)));
+
+	count = pool_getint(&buf);
+	while (count-- > 0)
+	{
+		MemSet(nulls, 0, sizeof(nulls));
+		values[0] = DirectFunctionCall1(namein, CStringGetDatum(pool_getstring(&buf)));
+		values[1] = DirectFunctionCall1(namein, CStringGetDatum(pool_getstring(&buf)));
+		values[2] = DirectFunctionCall1(namein, CStringGetDatum(pool_getstring(&buf)));
+		for (col=3;col<9;++col)
+			values[col] = Int32GetDatum(pool_getint(&buf));
+		values[9] = Int64GetDatum(pq_getmsgint64(&buf));
+		values[10] = Float8GetDatum(pq_getmsgint64(&buf) / 1000.0);
+		for (i=0,col=11;i<POOL_WAIT_HIST_BUCKETS;++i,++col)
+			values[col] = Int64GetDatum(pq_getmsgint64(&buf));
+		values[16] = Int64GetDatum(pq_getmsgint64(&buf));
+		values[17] = Int64GetDatum(pq_getmsgint64(&buf));
+		values[18] = Int64GetDatum(pq_getmsgint64(&buf));
+		last_retry_time = (TimestampTz) pq_getmsgint64(&buf);
+		if (last_retry_time == 0)
+			nulls[19] = true;
+		else
+			values[19] = TimestampTzGetDatum(last_retry_time);
+		values[20] = Int64GetDatum(pq_getmsgint64(&buf));
+
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+	pq_getmsgend(&buf);
+	pfree(buf.data);
+
+	return (Datum) 0;
+}
@@ -70,6 +70,7 @@
 #include "utils/timestamp.h"
 #ifdef ADB
 #include "catalog/catalog.h"
+#include "executor/instrument.h"
 #include "utils/lsyscache.h"
 
 #endif
@@ -341,6 +342,9 @@ static const char *pgstat_get_wait_client(WaitEventClient w);
 static const char *pgstat_get_wait_ipc(WaitEventIPC w);
 static const char *pgstat_get_wait_timeout(WaitEventTimeout w);
 static const char *pgstat_get_wait_io(WaitEventIO w);
+#ifdef ADB
+static const char *pgstat_get_wait_cluster(WaitEventCluster w);
+#endif /* ADB */
 
 static void pgstat_setheader(PgStat_MsgHdr *hdr, StatMsgType mtype);
 static void pgstat_send(void *msg, int len);
@@ -955,6 +959,10 @@ pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg)
 {
 	int			n;
 	int			len;
+#ifdef ADB
+	/* pgClusterUsage is never reset, remember what we already sent */
+	static ClusterUsage prevClusterUsage;
+#endif /* ADB */
 
 	/* It's unlikely we'd get here with no socket, but maybe not impossible */
 	if (pgStatSock == PGINVALID_SOCKET)
@@ -974,6 +982,15 @@ pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg)
 		pgStatXactRollback = 0;
 		pgStatBlockReadTime = 0;
 		pgStatBlockWriteTime = 0;
+#ifdef ADB
+		tsmsg->m_remote_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.remote_wait_time) -
+									INSTR_TIME_GET_MICROSEC(prevClusterUsage.remote_wait_time);
+		tsmsg->m_reduce_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.reduce_wait_time) -
+									INSTR_TIME_GET_MICROSEC(prevClusterUsage.reduce_wait_time);
+		tsmsg->m_gtm_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.gtm_wait_time) -
+								 INSTR_TIME_GET_MICROSEC(prevClusterUsage.gtm_wait_time);
+		prevClusterUsage = pgClusterUsage;
+#endif /* ADB */
 	}
 	else
 	{
@@ -981,6 +998,11 @@ pgstat_send_tabstat(PgStat_MsgTabstat *tsmsg)
 		tsmsg->m_xact_rollback = 0;
 		tsmsg->m_block_read_time = 0;
 		tsmsg->m_block_write_time = 0;
+#ifdef ADB
+		tsmsg->m_remote_wait_time = 0;
+		tsmsg->m_reduce_wait_time = 0;
+		tsmsg->m_gtm_wait_time = 0;
+#endif /* ADB */
 	}
 
 	n = tsmsg->m_nentries;
@@ -3057,6 +3079,11 @@ pgstat_bestart(void)
 	lbeentry.st_state = STATE_UNDEFINED;
 	lbeentry.st_progress_command = PROGRESS_COMMAND_INVALID;
 	lbeentry.st_progress_command_target = InvalidOid;
+#ifdef ADB
+	lbeentry.st_remote_wait_time = 0;
+	lbeentry.st_reduce_wait_time = 0;
+	lbeentry.st_gtm_wait_time = 0;
+#endif /* ADB */
 
 	/*
 	 * we don't zero st_progress_param here to save cycles; nobody should
@@ -3323,6 +3350,30 @@ pgstat_progress_end_command(void)
 	PGSTAT_END_WRITE_ACTIVITY(beentry);
 }
 
+#ifdef ADB
+/*-----------
+ * pgstat_report_cluster_wait() -
+ *
+ * Publish the time this backend has waited for other nodes so far, as
+ * accumulated in pgClusterUsage.  Called after each cluster wait.
+ *-----------
+ */
+void
+pgstat_report_cluster_wait(void)
+{
+	volatile PgBackendStatus *beentry = MyBEEntry;
+
+	if (!beentry || !pgstat_track_activities)
+		return;
+
+	PGSTAT_BEGIN_WRITE_ACTIVITY(beentry);
+	beentry->st_remote_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.remote_wait_time);
+	beentry->st_reduce_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.reduce_wait_time);
+	beentry->st_gtm_wait_time = INSTR_TIME_GET_MICROSEC(pgClusterUsage.gtm_wait_time);
+	PGSTAT_END_WRITE_ACTIVITY(beentry);
+}
+#endif /* ADB */
+
 /* ----------
  * pgstat_report_appname() -
  *
@@ -3578,6 +3629,11 @@ pgstat_get_wait_event_type(uint32 wait_event_info)
 		case PG_WAIT_IO:
 			event_type = "IO";
 			break;
+#ifdef ADB
+		case PG_WAIT_CLUSTER:
+			event_type = "Cluster";
+			break;
+#endif /* ADB */
 		default:
 			event_type = "???";
 			break;
@@ -3655,6 +3711,15 @@ pgstat_get_wait_event(uint32 wait_event_info)
 				event_name = pgstat_get_wait_io(w);
 				break;
 			}
+#ifdef ADB
+		case PG_WAIT_CLUSTER:
+			{
+				WaitEventCluster w = (WaitEventCluster) wait_event_info;
+
+				event_name = pgstat_get_wait_cluster(w);
+				break;
+			}
+#endif /* ADB */
 		default:
 			event_name = "unknown wait event";
 			break;
@@ -3954,6 +4019,57 @@ pgstat_get_wait_timeout(WaitEventTimeout w)
 	return event_name;
 }
 
+#ifdef ADB
+/* ----------
+ * pgstat_get_wait_cluster() -
+ *
+ * Convert WaitEventCluster to string.
+ * ----------
+ */
+static const char *
+pgstat_get_wait_cluster(WaitEventCluster w)
+{
+	const char *event_name = "unknown wait event";
+
+	switch (w)
+	{
+		case WAIT_EVENT_GTM_FINISH_XID:
+			event_name = "GTMFinishXid";
+			break;
+		case WAIT_EVENT_GTM_GET_XID:
+			event_name = "GTMGetXid";
+			break;
+		case WAIT_EVENT_GTM_SYNC_SNAPSHOT:
+			event_name = "GTMSyncSnapshot";
+			break;
+		case WAIT_EVENT_GTM_XACT_END:
+			event_name = "GTMXactEnd";
+			break;
+		case WAIT_EVENT_POOL_CONNECT:
+			event_name = "PoolConnect";
+			break;
+		case WAIT_EVENT_REDUCE_INTERNAL:
+			event_name = "ReduceInternal";
+			break;
+		case WAIT_EVENT_REDUCE_RECEIVE:
+			event_name = "ReduceReceive";
+			break;
+		case WAIT_EVENT_REDUCE_SEND:
+			event_name = "ReduceSend";
+			break;
+		case WAIT_EVENT_REMOTE_FETCH:
+			event_name = "RemoteFetch";
+			break;
+		case WAIT_EVENT_REMOTE_RESULT:
+			event_name = "RemoteResult";
+			break;
+			/* no default case, so that compiler will warn */
+	}
+
+	return event_name;
+}
+#endif /* ADB */
+
 /* ----------
  * pgstat_get_wait_io() -
  *
@@ -4776,6 +4892,11 @@ reset_dbentry_counters(PgStat_StatDBEntry *dbentry)
 	dbentry->last_checksum_failure = 0;
 	dbentry->n_block_read_time = 0;
 	dbentry->n_block_write_time = 0;
+#ifdef ADB
+	dbentry->n_remote_wait_time = 0;
+	dbentry->n_reduce_wait_time = 0;
+	dbentry->n_gtm_wait_time = 0;
+#endif /* ADB */
 
 	dbentry->stat_reset_timestamp = GetCurrentTimestamp();
 	dbentry->stats_timestamp = 0;
@@ -6000,6 +6121,11 @@ pgstat_recv_tabstat(PgStat_MsgTabstat *msg, int len)
 	dbentry->n_xact_rollback += (PgStat_Counter) (msg->m_xact_rollback);
 	dbentry->n_block_read_time += msg->m_block_read_time;
 	dbentry->n_block_write_time += msg->m_block_write_time;
+#ifdef ADB
+	dbentry->n_remote_wait_time += msg->m_remote_wait_time;
+	dbentry->n_reduce_wait_time += msg->m_reduce_wait_time;
+	dbentry->n_gtm_wait_time += msg->m_gtm_wait_time;
+#endif /* ADB */
 
 	/*
 	 * Process all table entries in the message.
@@ -9,6 +9,7 @@
 #include "pgstat.h"
 #include "pgxc/pgxc.h"
 #include "agtm/agtm.h"
+#include "executor/instrument.h"
 #include "postmaster/postmaster.h"
 #include "replication/walreceiver.h"
 #include "replication/snapreceiver.h"
@@ -169,7 +170,8 @@ static bool WaitSnapRcvSyncSnap(void *context);
 static void WakeupSnapSync(uint32_t req_key);
 static void SnapRcvDeleteProcList(proclist_head *reters, int procno);
 static bool SnapRcvWaitGxidEvent(TimestampTz end, WaitGxidRcvCond test,
-			proclist_head *reters, proclist_head *geters, void *context, bool is_need_setlatch);
+			proclist_head *reters, proclist_head *geters, void *context, bool is_need_setlatch,
+			uint32 wait_event_info);
 static void SnapRcvStopAllWaitFinishBackend(void);
 
 static void
@@ -328,7 +330,8 @@ static void SnapRcvCheckPreAssignArray(void)
  * mutex must be locked
  */
 static bool SnapRcvWaitGxidEvent(TimestampTz end, WaitGxidRcvCond test,
-			proclist_head *reters, proclist_head *geters, void *context, bool is_need_setlatch)
+			proclist_head *reters, proclist_head *geters, void *context, bool is_need_setlatch,
+			uint32 wait_event_info)
 {
 	Latch				   *latch = &MyProc->procLatch;
 	long					timeout;
@@ -337,6 +340,8 @@ static bool SnapRcvWaitGxidEvent(TimestampTz end, WaitGxidRcvCond test,
 	int						rc;
 	int						waitEvent;
 	bool					ret;
+	instr_time				wait_start;
+	instr_time				wait_end;
 
 	ret = true;
 	while ((*test)(context, reters))
@@ -391,7 +396,11 @@ static bool SnapRcvWaitGxidEvent(TimestampTz end, WaitGxidRcvCond test,
 			timeout = -1;
 		}
 
-		rc = WaitLatch(latch, waitEvent, timeout, PG_WAIT_EXTENSION);
+		INSTR_TIME_SET_CURRENT(wait_start);
+		rc = WaitLatch(latch, waitEvent, timeout, wait_event_info);
+		INSTR_TIME_SET_CURRENT(wait_end);
+		INSTR_TIME_ACCUM_DIFF(pgClusterUsage.gtm_wait_time, wait_end, wait_start);
+		pgstat_report_cluster_wait();
 		ResetLatch(latch);
 		if (rc & WL_POSTMASTER_DEATH)
 		{
@@ -1764,6 +1773,8 @@ static bool WaitSnapRcvEvent(TimestampTz end, proclist_head *waiters, bool is_ss
 	int						rc;
 	int						waitEvent;
 	bool					ret;
+	instr_time				wait_start;
+	instr_time				wait_end;
 
 	ret = true;
 	while ((*test)(context))
@@ -1802,7 +1813,12 @@ static bool WaitSnapRcvEvent(TimestampTz end, proclist_head *waiters, bool is_ss
 		{
 			timeout = -1;
 		}
-		rc = WaitLatch(latch, waitEvent, timeout, PG_WAIT_EXTENSION);
+		INSTR_TIME_SET_CURRENT(wait_start);
+		rc = WaitLatch(latch, waitEvent, timeout,
+					   is_ss ? WAIT_EVENT_GTM_SYNC_SNAPSHOT : WAIT_EVENT_GTM_XACT_END);
+		INSTR_TIME_SET_CURRENT(wait_end);
+		INSTR_TIME_ACCUM_DIFF(pgClusterUsage.gtm_wait_time, wait_end, wait_start);
+		pgstat_report_cluster_wait();
 		ResetLatch(latch);
 		if (rc & WL_POSTMASTER_DEATH)
 		{
@@ -2254,7 +2270,8 @@ RETRY:
 	}
 
 	endtime = TimestampTzPlusMilliseconds(GetCurrentTimestamp(), wait_loop_time * (retry_time + 1));
-	SnapRcvWaitGxidEvent(endtime, WaitSnapRcvCondReturn, &SnapRcv->reters, &SnapRcv->geters, NULL, true);
+	SnapRcvWaitGxidEvent(endtime, WaitSnapRcvCondReturn, &SnapRcv->reters, &SnapRcv->geters, NULL, true,
+						 WAIT_EVENT_GTM_GET_XID);
 
 	if (!TransactionIdIsValid(MyProc->getGlobalTransaction))
 	{
@@ -2357,7 +2374,7 @@ void SnapRcvCommitTransactionId(TransactionId txid, SnapXidFinishOption finish_f
 	MyProc->getGlobalTransaction = txid;
 	endtime = TimestampTzPlusMilliseconds(GetCurrentTimestamp(), snapshot_sync_waittime);
 	ret = SnapRcvWaitGxidEvent(endtime, WaitSnapRcvCommitReturn, &SnapRcv->wait_commiters,
-				&SnapRcv->send_commiters, (void*)((size_t)txid), true);
+				&SnapRcv->send_commiters, (void*)((size_t)txid), true, WAIT_EVENT_GTM_FINISH_XID);
 
 	if (!ret)
 	{
@@ -46,11 +46,13 @@
 #include "storage/spin.h"
 #include "utils/snapmgr.h"
 #ifdef ADB
+#include "executor/execProfile.h"
 #include "pgxc/nodemgr.h"
 #include "pgxc/pause.h"
 #include "pgxc/pgxc.h"
 #include "replication/snapreceiver.h"
 #include "replication/snapsender.h"
+#include "utils/dynamicreduce.h"
 
 #endif
 #if defined(ADBMGRD)
@@ -169,6 +171,8 @@ CreateSharedMemoryAndSemaphores(void)
 			
 		if (IS_PGXC_COORDINATOR)
 			size = add_size(size, ClusterLockShmemSize());
+		size = add_size(size, QueryProfileShmemSize());
+		size = add_size(size, DRNetStatShmemSize());
 #endif
 
 #if defined(ADB_GRAM_ORA) && defined(USE_SEQ_ROWID)
@@ -300,6 +304,8 @@ CreateSharedMemoryAndSemaphores(void)
 	
 	if (IS_PGXC_COORDINATOR)
 		ClusterLockShmemInit();
+	QueryProfileShmemInit();
+	DRNetStatShmemInit();
 #endif
 
 	/*
@@ -29,6 +29,7 @@
 #include "storage/sinval.h"
 #include "tcop/tcopprot.h"
 #ifdef ADB
+#include "executor/execProfile.h"
 #include "pgxc/poolutils.h"
 #endif
 
@@ -549,6 +550,11 @@ procsignal_sigusr1_handler(SIGNAL_ARGS)
 	if (CheckProcSignal(PROCSIG_WALSND_INIT_STOPPING))
 		HandleWalSndInitStopping();
 
+#ifdef ADB
+	if (CheckProcSignal(PROCSIG_QUERY_PROFILE))
+		HandleQueryProfileInterrupt();
+#endif /* ADB */
+
 	if (CheckProcSignal(PROCSIG_RECOVERY_CONFLICT_DATABASE))
 		RecoveryConflictInterrupt(PROCSIG_RECOVERY_CONFLICT_DATABASE);
 
@@ -89,6 +89,7 @@
 #include "catalog/pg_class.h"
 #include "executor/clusterReceiver.h"
 #include "executor/execCluster.h"
+#include "executor/execProfile.h"
 #include "intercomm/inter-node.h"
 #include "parser/parse_type.h"
 #include "pgxc/cluster_barrier.h"
@@ -3883,6 +3884,11 @@ ProcessInterrupts(void)
 
 	if (ParallelMessagePending)
 		HandleParallelMessages();
+
+#ifdef ADB
+	if (QueryProfilePending)
+		ProcessQueryProfileInterrupt();
+#endif /* ADB */
 }
 
 
@@ -1065,6 +1065,31 @@ pg_stat_get_backend_wait_event(PG_FUNCTION_ARGS)
 }
 
 
+#ifdef ADB
+/*
+ * Cluster wait time of a backend, converted from microsec to millisec.
+ * Returns NULL when the backend is not visible to the caller.
+ */
+#define PG_STAT_GET_BACKEND_CLUSTER_WAIT(func, field)				\
+Datum																\
+func(PG_FUNCTION_ARGS)												\
+{																	\
+	int32		beid = PG_GETARG_INT32(0);							\
+	PgBackendStatus *beentry;										\
+																	\
+	if ((beentry = pgstat_fetch_stat_beentry(beid)) == NULL)		\
+		PG_RETURN_NULL();											\
+	else if (!HAS_PGSTAT_PERMISSIONS(beentry->st_userid))			\
+		PG_RETURN_NULL();											\
+																	\
+	PG_RETURN_FLOAT8(((double) beentry->field) / 1000.0);			\
+}
+
+PG_STAT_GET_BACKEND_CLUSTER_WAIT(pg_stat_get_backend_remote_wait_time, st_remote_wait_time)
+PG_STAT_GET_BACKEND_CLUSTER_WAIT(pg_stat_get_backend_reduce_wait_time, st_reduce_wait_time)
+PG_STAT_GET_BACKEND_CLUSTER_WAIT(pg_stat_get_backend_gtm_wait_time, st_gtm_wait_time)
+#endif /* ADB */
+
 Datum
 pg_stat_get_backend_activity_start(PG_FUNCTION_ARGS)
 {
@@ -1623,6 +1648,29 @@ pg_stat_get_db_blk_write_time(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT8(result);
 }
 
+#ifdef ADB
+#define PG_STAT_GET_DB_CLUSTER_WAIT(func, field)					\
+Datum																\
+func(PG_FUNCTION_ARGS)												\
+{																	\
+	Oid			dbid = PG_GETARG_OID(0);							\
+	double		result;												\
+	PgStat_StatDBEntry *dbentry;									\
+																	\
+	/* convert counter from microsec to millisec for display */	\
+	if ((dbentry = pgstat_fetch_stat_dbentry(dbid)) == NULL)		\
+		result = 0;													\
+	else															\
+		result = ((double) dbentry->field) / 1000.0;				\
+																	\
+	PG_RETURN_FLOAT8(result);										\
+}
+
+PG_STAT_GET_DB_CLUSTER_WAIT(pg_stat_get_db_remote_wait_time, n_remote_wait_time)
+PG_STAT_GET_DB_CLUSTER_WAIT(pg_stat_get_db_reduce_wait_time, n_reduce_wait_time)
+PG_STAT_GET_DB_CLUSTER_WAIT(pg_stat_get_db_gtm_wait_time, n_gtm_wait_time)
+#endif /* ADB */
+
 Datum
 pg_stat_get_bgwriter_timed_checkpoints(PG_FUNCTION_ARGS)
 {
@@ -2473,6 +2473,7 @@ RelationDestroyRelation(Relation relation, bool remember_tupdesc)
 	if (relation->rd_auxlist)
 		list_free(relation->rd_auxlist);
 	bms_free(relation->rd_auxatt);
+	bms_free(relation->rd_auxinclude);
 	if (relation->rd_clean)
 		DestroyExpansionClean(relation->rd_clean);
 #endif
@@ -2793,6 +2794,8 @@ RelationClearRelation(Relation relation, bool rebuild)
 
 			if (bms_equal(relation->rd_auxatt, newrel->rd_auxatt))
 				SWAPFIELD(Bitmapset *, rd_auxatt);
+			if (bms_equal(relation->rd_auxinclude, newrel->rd_auxinclude))
+				SWAPFIELD(Bitmapset *, rd_auxinclude);
 		}
 		if (IsLocatorInfoEqual(relation->rd_locator_info, newrel->rd_locator_info))
 			SWAPFIELD(RelationLocInfo *, rd_locator_info);
@@ -236,6 +236,13 @@ re_connect_:
 		{
 			DR_CONNECT_DEBUG((errmsg("connect to node %u success", ned->nodeoid)));
 			DELETE_CONNECTING_NODE(ned);
+			if (ned->try_count == 0)
+			{
+				instr_time	elapsed;
+				INSTR_TIME_SET_CURRENT(elapsed);
+				INSTR_TIME_SUBTRACT(elapsed, ned->connect_start);
+				DRNetStatReportConnect(ned->nodeoid, INSTR_TIME_GET_MILLISEC(elapsed));
+			}
 			/* update status */
 			resetStringInfo(&ned->sendBuf);
 			DROnNodeConectSuccess(ned);
@@ -340,6 +347,7 @@ static void ConnectToOneNode(const DynamicReduceNodeInfo *info, const struct add
 
 	fd = PGINVALID_SOCKET;
 	ned->addr_cur = ned->addrlist;
+	INSTR_TIME_SET_CURRENT(ned->connect_start);
 	while (ned->addr_cur != NULL)
 	{
 		fd = ConnectToAddress(ned->addr_cur);
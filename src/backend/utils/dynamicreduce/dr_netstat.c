@@ -0,0 +1,324 @@
+/*-------------------------------------------------------------------------
+ *
+ * dr_netstat.c
+ *	  per-peer network measurements of dynamic reduce
+ *
+ * Every dynamic reduce worker reports how fast it could drain its send
+ * buffer to a peer node and how long connecting to that peer took.  The
+ * figures are kept as moving averages in shared memory, one slot per peer
+ * node, so the planner can cost reduce paths with the bandwidth and latency
+ * the cluster really has instead of the fixed reduce_* GUCs only.
+ *
+ * Portions Copyright (c) 2019, AntDB Development Group
+ *
+ * src/backend/utils/dynamicreduce/dr_netstat.c
+ *
+ *-------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "catalog/pg_type.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "pgxc/nodemgr.h"
+#include "storage/shmem.h"
+#include "storage/spin.h"
+#include "utils/builtins.h"
+#include "utils/timestamp.h"
+#include "utils/tuplestore.h"
+
+#include "utils/dynamicreduce.h"
+
+/* weight of a new sample in the moving averages */
+#define DR_NETSTAT_WEIGHT		0.2
+
+typedef struct DRNetStatSlot
+{
+	Oid			nodeoid;		/* peer node, InvalidOid for a free slot */
+	double		bandwidth;		/* bytes per second */
+	double		latency;		/* connect time in milliseconds */
+	int64		bandwidth_samples;
+	int64		latency_samples;
+	TimestampTz	last_update;
+}DRNetStatSlot;
+
+typedef struct DRNetStatShared
+{
+	slock_t		mutex;
+	int			max_slots;
+	DRNetStatSlot slots[FLEXIBLE_ARRAY_MEMBER];
+}DRNetStatShared;
+
+static DRNetStatShared *dr_netstat = NULL;
+
+static int DRNetStatMaxSlots(void)
+{
+	return MaxCoords + MaxDataNodes;
+}
+
+Size DRNetStatShmemSize(void)
+{
+	return add_size(offsetof(DRNetStatShared, slots),
+					mul_size(DRNetStatMaxSlots(), sizeof(DRNetStatSlot)));
+}
+
+void DRNetStatShmemInit(void)
+{
+	bool found;
+
+	dr_netstat = ShmemInitStruct("Dynamic Reduce Network Stats",
+								 DRNetStatShmemSize(),
+								 &found);
+	if (!found)
+	{
+		MemSet(dr_netstat, 0, DRNetStatShmemSize());
+		SpinLockInit(&dr_netstat->mutex);
+		dr_netstat->max_slots = DRNetStatMaxSlots();
+	}
+}
+
+/*
+ * Find the slot of node, take a free one or the oldest one when it is not
+ * there yet.  Must hold the mutex.
+ */
+static DRNetStatSlot* DRNetStatGetSlot(Oid nodeoid)
+{
+	DRNetStatSlot  *slot;
+	DRNetStatSlot  *victim = NULL;
+	int				i;
+
+	for (i=0;i<dr_netstat->max_slots;++i)
+	{
+		slot = &dr_netstat->slots[i];
+		if (slot->nodeoid == nodeoid)
+			return slot;
+		if (victim == NULL ||
+			(OidIsValid(victim->nodeoid) &&
+			 (!OidIsValid(slot->nodeoid) || slot->last_update < victim->last_update)))
+			victim = slot;
+	}
+
+	MemSet(victim, 0, sizeof(*victim));
+	victim->nodeoid = nodeoid;
+	return victim;
+}
+
+static inline double DRNetStatAverage(double old_value, int64 samples, double value)
+{
+	if (samples == 0)
+		return value;
+	return old_value + (value - old_value) * DR_NETSTAT_WEIGHT;
+}
+
+/*
+ * Report bytes sent to node during elapsed milliseconds while the send
+ * buffer was never empty.
+ */
+void DRNetStatReportSend(Oid nodeoid, uint64 bytes, double elapsed)
+{
+	DRNetStatSlot  *slot;
+	TimestampTz		now;
+	double			bandwidth;
+
+	if (dr_netstat == NULL ||
+		!OidIsValid(nodeoid) ||
+		elapsed <= 0.0)
+		return;
+
+	bandwidth = (double) bytes * 1000.0 / elapsed;
+	now = GetCurrentTimestamp();
+	SpinLockAcquire(&dr_netstat->mutex);
+	slot = DRNetStatGetSlot(nodeoid);
+	slot->bandwidth = DRNetStatAverage(slot->bandwidth, slot->bandwidth_samples, bandwidth);
+	slot->bandwidth_samples++;
+	slot->last_update = now;
+	SpinLockRelease(&dr_netstat->mutex);
+}
+
+/*
+ * Report it took elapsed milliseconds to connect to node.
+ */
+void DRNetStatReportConnect(Oid nodeoid, double elapsed)
+{
+	DRNetStatSlot  *slot;
+	TimestampTz		now;
+
+	if (dr_netstat == NULL ||
+		!OidIsValid(nodeoid) ||
+		elapsed < 0.0)
+		return;
+
+	now = GetCurrentTimestamp();
+	SpinLockAcquire(&dr_netstat->mutex);
+	slot = DRNetStatGetSlot(nodeoid);
+	slot->latency = DRNetStatAverage(slot->latency, slot->latency_samples, elapsed);
+	slot->latency_samples++;
+	slot->last_update = now;
+	SpinLockRelease(&dr_netstat->mutex);
+}
+
+/*
+ * Get the slowest bandwidth (bytes per second) and the highest latency
+ * (milliseconds) measured to any of nodes.  Return false when nothing has
+ * been measured for them, both outputs are left 0 for a figure with no
+ * samples.
+ */
+bool DRNetStatEstimate(List *nodes, double *bandwidth, double *latency)
+{
+	DRNetStatSlot  *slot;
+	ListCell	   *lc;
+	int				i;
+	bool			found = false;
+
+	*bandwidth = *latency = 0.0;
+	if (dr_netstat == NULL)
+		return false;
+
+	SpinLockAcquire(&dr_netstat->mutex);
+	for (i=0;i<dr_netstat->max_slots;++i)
+	{
+		slot = &dr_netstat->slots[i];
+		if (!OidIsValid(slot->nodeoid))
+			continue;
+		foreach (lc, nodes)
+		{
+			if (lfirst_oid(lc) != slot->nodeoid)
+				continue;
+			if (slot->bandwidth_samples > 0 &&
+				(*bandwidth == 0.0 || slot->bandwidth < *bandwidth))
+			{
+				*bandwidth = slot->bandwidth;
+				found = true;
+			}
+			if (slot->latency_samples > 0 &&
+				slot->latency > *latency)
+			{
+				*latency = slot->latency;
+				found = true;
+			}
+			break;
+		}
+	}
+	SpinLockRelease(&dr_netstat->mutex);
+
+	return found;
+}
+
+Datum adb_reduce_network_stats(PG_FUNCTION_ARGS)
+{
+#define ADB_REDUCE_NETWORK_STATS_COLS	6
+	ReturnSetInfo  *rsinfo = (ReturnSetInfo *) fcinfo->resultinfo;
+	TupleDesc		tupdesc;
+	Tuplestorestate *tupstore;
+	MemoryContext	per_query_ctx;
+	MemoryContext	oldcontext;
+	DRNetStatSlot  *slots;
+	int				count;
+	int				i;
+	Datum			values[ADB_REDUCE_NETWORK_STATS_COLS];
+	bool			nulls[ADB_REDUCE_NETWORK_STATS_COLS];
+
+	if (rsinfo == NULL || !IsA(rsinfo, ReturnSetInfo))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("set-valued function called in context that cannot accept a set")));
+	if (!(rsinfo->allowedModes & SFRM_Materialize))
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("materialize mode required, but it is not allowed in this context")));
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	per_query_ctx = rsinfo->econtext->ecxt_per_query_memory;
+	oldcontext = MemoryContextSwitchTo(per_query_ctx);
+	tupstore = tuplestore_begin_heap(true, false, work_mem);
+	rsinfo->returnMode = SFRM_Materialize;
+	rsinfo->setResult = tupstore;
+	rsinfo->setDesc = tupdesc;
+	MemoryContextSwitchTo(oldcontext);
+
+	if (dr_netstat == NULL)
+		return (Datum) 0;
+
+	/* copy out, don't build tuples under the spinlock */
+	count = dr_netstat->max_slots;
+	slots = palloc(sizeof(DRNetStatSlot) * count);
+	SpinLockAcquire(&dr_netstat->mutex);
+	memcpy(slots, dr_netstat->slots, sizeof(DRNetStatSlot) * count);
+	SpinLockRelease(&dr_netstat->mutex);
+
+	MemSet(nulls, false, sizeof(nulls));
+	for (i=0;i<count;++i)
+	{
+		if (!OidIsValid(slots[i].nodeoid))
+			continue;
+
+		values[0] = ObjectIdGetDatum(slots[i].nodeoid);
+		values[1] = Float8GetDatum(slots[i].bandwidth / (1024.0 * 1024.0));
+		nulls[1] = (slots[i].bandwidth_samples == 0);
+		values[2] = Float8GetDatum(slots[i].latency);
+		nulls[2] = (slots[i].latency_samples == 0);
+		values[3] = Int64GetDatum(slots[i].bandwidth_samples);
+		values[4] = Int64GetDatum(slots[i].latency_samples);
+		values[5] = TimestampTzGetDatum(slots[i].last_update);
+		tuplestore_putvalues(tupstore, tupdesc, values, nulls);
+	}
+	pfree(slots);
+
+	return (Datum) 0;
+}
+
+/*
+ * Overwrite the figures of a peer node, used to load the measurements other
+ * nodes made, see adb_reduce_calibrate().  NULL leaves a figure unchanged.
+ */
+Datum adb_reduce_network_stats_set(PG_FUNCTION_ARGS)
+{
+	DRNetStatSlot  *slot;
+	TimestampTz		now;
+	Oid				nodeoid = PG_GETARG_OID(0);
+
+	if (!superuser())
+		ereport(ERROR,
+				(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+				 errmsg("must be superuser to set dynamic reduce network statistics")));
+
+	if (!OidIsValid(nodeoid) || dr_netstat == NULL)
+		PG_RETURN_BOOL(false);
+
+	now = GetCurrentTimestamp();
+	SpinLockAcquire(&dr_netstat->mutex);
+	slot = DRNetStatGetSlot(nodeoid);
+	if (!PG_ARGISNULL(1) && PG_GETARG_FLOAT8(1) > 0.0)
+	{
+		slot->bandwidth = PG_GETARG_FLOAT8(1) * 1024.0 * 1024.0;
+		slot->bandwidth_samples = Max(slot->bandwidth_samples, 1);
+	}
+	if (!PG_ARGISNULL(2) && PG_GETARG_FLOAT8(2) >= 0.0)
+	{
+		slot->latency = PG_GETARG_FLOAT8(2);
+		slot->latency_samples = Max(slot->latency_samples, 1);
+	}
+	slot->last_update = now;
+	SpinLockRelease(&dr_netstat->mutex);
+
+	PG_RETURN_BOOL(true);
+}
+
+Datum adb_reduce_network_stats_reset(PG_FUNCTION_ARGS)
+{
+	if (!superuser())
+		ereport(ERROR,
+				(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+				 errmsg("must be superuser to reset dynamic reduce network statistics")));
+
+	if (dr_netstat != NULL)
+	{
+		SpinLockAcquire(&dr_netstat->mutex);
+		MemSet(dr_netstat->slots, 0, sizeof(DRNetStatSlot) * dr_netstat->max_slots);
+		SpinLockRelease(&dr_netstat->mutex);
+	}
+
+	PG_RETURN_VOID();
+}
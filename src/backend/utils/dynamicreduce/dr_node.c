@@ -123,6 +123,13 @@ bool PutMessageToNode(DRNodeEventData *ned, char msg_type, const char *data, uin
 	if (len > 0)
 		appendBinaryStringInfoNT(&ned->sendBuf, data, len);								/* message data */
 
+	if (is_empty)
+	{
+		INSTR_TIME_SET_CURRENT(ned->send_start);
+		ned->send_bytes = 0;
+		ned->send_full = false;
+	}
+
 	DR_NODE_DEBUG((errmsg("PutMessageToNode(node=%u, type=%d, len=%u, plan=%d) == true",
 						  ned->nodeoid, msg_type, len, plan_id)));
 
@@ -558,8 +565,26 @@ resend_:
 	{
 		DR_NODE_DEBUG((errmsg("node %u send message of length %zd to remote success", ned->nodeoid, result)));
 		ned->sendBuf.cursor += result;
+		ned->send_bytes += result;
 		if (ned->sendBuf.cursor == ned->sendBuf.len)
+		{
 			ned->sendBuf.cursor = ned->sendBuf.len = 0;
+			/*
+			 * only when the socket was full the time we took to drain the
+			 * buffer is bound by the network, not by how fast we fill it
+			 */
+			if (ned->send_full)
+			{
+				instr_time	elapsed;
+				INSTR_TIME_SET_CURRENT(elapsed);
+				INSTR_TIME_SUBTRACT(elapsed, ned->send_start);
+				DRNetStatReportSend(ned->nodeoid, ned->send_bytes, INSTR_TIME_GET_MILLISEC(elapsed));
+				ned->send_full = false;
+			}
+		}else
+		{
+			ned->send_full = true;
+		}
 		ActiveWaitingPlan(ned);
 	}else
 	{
@@ -2,6 +2,7 @@
 
 #include "access/htup_details.h"
 #include "executor/clusterReceiver.h"
+#include "executor/instrument.h"
 #include "executor/tuptable.h"
 #include "libpq/pqmq.h"
 #include "miscadmin.h"
@@ -23,14 +24,14 @@ dsa_area	  *dr_dsa = NULL;
 static uint32 dr_shared_fs_num = 0U;
 
 #if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-static void dr_wait_latch(void)
+static void dr_wait_latch(uint32 wait_event_info)
 {
 	sigset_t	sigmask;
 	sigset_t	origmask;
 
 	if (MyLatch->is_set)
 		return;
-	pgstat_report_wait_start(WAIT_EVENT_MQ_INTERNAL);
+	pgstat_report_wait_start(wait_event_info);
 	sigprocmask(0, NULL, &sigmask);
 	sigaddset(&sigmask, SIGUSR1);
 	sigaddset(&sigmask, SIGINT);
@@ -47,6 +48,29 @@ static void dr_wait_latch(void)
 }
 #endif
 
+/*
+ * Wait until dynamic reduce wake us up,
+ * time spent is accumulated in pgClusterUsage
+ */
+static void dr_wait_reduce(uint32 wait_event_info)
+{
+	instr_time	start;
+	instr_time	end;
+#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
+	WaitEvent	event;
+#endif
+
+	INSTR_TIME_SET_CURRENT(start);
+#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
+	dr_wait_latch(wait_event_info);
+#else
+	WaitEventSetWait(dr_wait_event_set, -1, &event, 1, wait_event_info);
+#endif
+	INSTR_TIME_SET_CURRENT(end);
+	INSTR_TIME_ACCUM_DIFF(pgClusterUsage.reduce_wait_time, end, start);
+	pgstat_report_cluster_wait();
+}
+
 static void check_error_message_from_reduce(void)
 {
 	Size			size;
@@ -183,9 +207,6 @@ DynamicReduceRecvTuple(shm_mq_handle *mqh, struct TupleTableSlot *slot, StringIn
 {
 	void		   *data;
 	Size			size;
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent		event;
-#endif
 	uint8			result;
 
 	result = recv_msg_from_plan(mqh, &size, &data, info);
@@ -198,11 +219,7 @@ DynamicReduceRecvTuple(shm_mq_handle *mqh, struct TupleTableSlot *slot, StringIn
 
 	while(result == ADB_DR_MSG_INVALID)
 	{
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_RECEIVE);
-#endif /* DR_USING_EPOLL */
+		dr_wait_reduce(WAIT_EVENT_REDUCE_RECEIVE);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
@@ -236,9 +253,6 @@ int DynamicReduceSendOrRecvTuple(shm_mq_handle *mqsend, shm_mq_handle *mqrecv,
 	void		   *data;
 	Size			size;
 	shm_mq_iovec	iov;
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent		event;
-#endif
 	int				flags = 0;
 	uint8			msg_type;
 
@@ -278,11 +292,7 @@ int DynamicReduceSendOrRecvTuple(shm_mq_handle *mqsend, shm_mq_handle *mqrecv,
 			return flags;
 
 		check_error_message_from_reduce();
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_INTERNAL);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_INTERNAL);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 	}
@@ -293,9 +303,6 @@ int DynamicReduceSendOrRecvTuple(shm_mq_handle *mqsend, shm_mq_handle *mqrecv,
 bool DynamicReduceSendMessage(shm_mq_handle *mqh, Size nbytes, void *data, bool nowait)
 {
 	shm_mq_iovec	iov;
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent		event;
-#endif
 
 	iov.data = data;
 	iov.len = nbytes;
@@ -308,11 +315,7 @@ bool DynamicReduceSendMessage(shm_mq_handle *mqh, Size nbytes, void *data, bool
 	{
 		check_error_message_from_reduce();
 
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_INTERNAL);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_INTERNAL);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
@@ -330,20 +333,13 @@ bool DynamicReduceNotifyAttach(shm_mq_handle *mq_send, shm_mq_handle *mq_recv,
 	static const uint32 msg = (ADB_DR_MSG_ATTACH_PLAN << 24);
 	shm_mq_iovec iov = {(const char*)&msg, sizeof(msg)};
 	shm_mq_result mq_result;
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent event;
-#endif
 
 re_send_:
 	mq_result = shm_mq_sendv(mq_send, &iov, 1, true);
 	if (mq_result == SHM_MQ_WOULD_BLOCK)
 	{
 
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_SEND);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_SEND);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 		check_error_message_from_reduce();
@@ -361,11 +357,7 @@ re_get_:
 	mq_result = shm_mq_receive(mq_recv, &iov.len, (void**)&iov.data, true);
 	if (mq_result == SHM_MQ_WOULD_BLOCK)
 	{
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_RECEIVE);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_RECEIVE);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 		check_error_message_from_reduce();
@@ -403,9 +395,6 @@ re_get_:
 
 bool DRSendMsgToReduce(const char *data, Size len, bool nowait, bool detach_ok)
 {
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent		event;
-#endif
 	shm_mq_result	result;
 	shm_mq_iovec	iov;
 
@@ -429,11 +418,7 @@ bool DRSendMsgToReduce(const char *data, Size len, bool nowait, bool detach_ok)
 		Assert(result == SHM_MQ_WOULD_BLOCK);
 		check_error_message_from_reduce();
 
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_SEND);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_SEND);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
@@ -446,9 +431,6 @@ bool DRSendMsgToReduce(const char *data, Size len, bool nowait, bool detach_ok)
 
 bool DRRecvMsgFromReduce(Size *sizep, void **datap, bool nowait, bool detach_ok)
 {
-#if (!defined DR_USING_EPOLL) && (!defined WITH_REDUCE_RDMA)
-	WaitEvent		event;
-#endif
 	shm_mq_result	result;
 
 re_get_:
@@ -467,11 +449,7 @@ re_get_:
 		}
 
 		Assert(result == SHM_MQ_WOULD_BLOCK);
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_RECEIVE);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_RECEIVE);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
@@ -580,9 +558,6 @@ void ResetDynamicReduceWork(void)
 	static const char reset_msg[1] = {ADB_DR_MQ_MSG_RESET};
 	Size			size;
 	char		   *data;
-#ifndef DR_USING_EPOLL
-	//WaitEvent		event;
-#endif
 	shm_mq_result	result;
 	shm_mq_iovec	iov[2];
 
@@ -614,11 +589,7 @@ void ResetDynamicReduceWork(void)
 		{
 		}*/
 
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_SEND);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_SEND);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
@@ -635,11 +606,7 @@ reget_reset_msg_:
 			StopDynamicReduceWorker();
 			return;
 		}
-#if (defined DR_USING_EPOLL) || (defined WITH_REDUCE_RDMA) 
-		dr_wait_latch();
-#else
-		WaitEventSetWait(dr_wait_event_set, -1, &event, 1, WAIT_EVENT_MQ_RECEIVE);
-#endif
+		dr_wait_reduce(WAIT_EVENT_REDUCE_RECEIVE);
 		ResetLatch(&MyProc->procLatch);
 		CHECK_FOR_INTERRUPTS();
 
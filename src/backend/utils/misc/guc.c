@@ -103,7 +103,10 @@
 #include "utils/xml.h"
 
 #ifdef ADB
+#include "commands/copy.h"
+#include "commands/explain.h"
 #include "commands/tablecmds.h"
+#include "executor/execProfile.h"
 #include "nodes/nodes.h"
 #include "optimizer/pgxcship.h"
 #include "optimizer/plancat.h"
@@ -747,6 +750,7 @@ bool		enable_aux_dml = false;
 extern bool auto_release_connect;	/* in libpq-node.c */
 bool		enable_coordinator_calculate = true;
 int			default_distribute_by = LOCATOR_TYPE_HASH;
+int			hash_distribute_buckets = 0;
 char 		*default_user_group = "";
 bool    single_slave_datanode;
 bool		enable_view_distribute;
@@ -1685,6 +1689,25 @@ static struct config_bool ConfigureNamesBool[] =
 		true,
 		NULL, NULL, NULL
 	},
+	{
+		{"reduce_cost_calibration", PGC_USERSET, QUERY_TUNING_COST,
+			gettext_noop("Scales the planner's reduce costs by the network bandwidth and latency dynamic reduce measured."),
+			NULL
+		},
+		&reduce_cost_calibration,
+		false,
+		NULL, NULL, NULL
+	},
+	{
+		{"track_query_profile", PGC_SUSET, STATS_MONITORING,
+			gettext_noop("Tracks the plan nodes being executed for pg_query_profile()."),
+			gettext_noop("Only queries started while this is on report their plan nodes, "
+						 "samples of other queries have C functions only.")
+		},
+		&track_query_profile,
+		false,
+		NULL, NULL, NULL
+	},
 	{
 		{"enable_hashscan", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enables the planner's use of hash ReduceScan plans."),
@@ -2537,6 +2560,17 @@ static struct config_bool ConfigureNamesBool[] =
 		NULL, NULL, NULL
 	},
 
+	{
+		{"copy_from_shared_file", PGC_USERSET, COORDINATORS,
+			gettext_noop("Datanodes read COPY FROM file by themselves."),
+			gettext_noop("The file must be reachable with the same absolute path "
+						 "on every datanode, only text format is supported.")
+		},
+		&copy_from_shared_file,
+		false,
+		NULL, NULL, NULL
+	},
+
 	{
 		{"auto_release_connect", PGC_USERSET, COORDINATORS,
 			gettext_noop("release connects for connected other nodes when transaction finish"),
@@ -3880,6 +3914,25 @@ static struct config_int ConfigureNamesInt[] =
 		-1, -1, INT_MAX,
 		NULL, NULL, NULL
 	},
+	{
+		{"hash_distribute_buckets", PGC_USERSET, QUERY_TUNING_OTHER,
+			gettext_noop("Sets the number of virtual buckets of create table distribute by hash."),
+			gettext_noop("Buckets are assigned to datanodes round-robin, node expansion "
+						 "moves whole buckets. 0 uses the number of datanodes.")
+		},
+		&hash_distribute_buckets,
+		0, 0, 65536,
+		NULL, NULL, NULL
+	},
+	{
+		{"expansion_clean_cost_limit", PGC_SIGHUP, RESOURCES_VACUUM_DELAY,
+			gettext_noop("Vacuum cost amount available before napping, for ALTER NODE ... CLEAN."),
+			gettext_noop("-1 uses vacuum_cost_limit.")
+		},
+		&expansion_clean_cost_limit,
+		-1, -1, 10000,
+		NULL, NULL, NULL
+	},
 #endif
 
 	{
@@ -4559,6 +4612,28 @@ static struct config_real ConfigureNamesReal[] =
 		0.0, 0.0, 1.0,
 		NULL, NULL, NULL
 	},
+#ifdef ADB
+	{
+		{"explain_skew_threshold", PGC_USERSET, STATS_MONITORING,
+			gettext_noop("Sets the datanode skew that EXPLAIN (ANALYZE, NODES) flags."),
+			gettext_noop("A plan node is flagged when its max datanode time or rows "
+						 "exceeds this multiple of the datanode average.")
+		},
+		&explain_skew_threshold,
+		1.5, 1.0, DBL_MAX,
+		NULL, NULL, NULL
+	},
+	{
+		{"expansion_clean_cost_delay", PGC_SIGHUP, RESOURCES_VACUUM_DELAY,
+			gettext_noop("Vacuum cost delay in milliseconds, for ALTER NODE ... CLEAN."),
+			gettext_noop("-1 uses vacuum_cost_delay."),
+			GUC_UNIT_MS
+		},
+		&expansion_clean_cost_delay,
+		-1, -1, 100,
+		NULL, NULL, NULL
+	},
+#endif /* ADB */
 
 	/* End-of-list marker */
 	{
@@ -132,7 +132,11 @@ static int	pthread_join(pthread_t th, void **thread_return);
  * some configurable parameters */
 
 #define DEFAULT_INIT_STEPS "dtgvp"	/* default -I setting */
+#ifdef ADB
+#define ALL_INIT_STEPS "dtgGvpfc"	/* all possible steps */
+#else
 #define ALL_INIT_STEPS "dtgGvpf"	/* all possible steps */
+#endif
 
 #define LOG_STEP_SECONDS	5	/* seconds between log messages */
 #define DEFAULT_NXACTS	10		/* default nxacts */
@@ -240,6 +244,9 @@ int			nclients = 1;		/* number of clients */
 int			nthreads = 1;		/* number of threads */
 bool		is_connect;			/* establish connection for each transaction */
 bool		report_per_command; /* report per-command latencies */
+#ifdef ADB
+bool		report_percentiles; /* report latency percentiles */
+#endif
 int			main_pid;			/* main process id used in log filename */
 
 char	   *pghost = "";
@@ -288,6 +295,21 @@ typedef struct SimpleStats
 	double		sum2;			/* sum of squared values */
 } SimpleStats;
 
+#ifdef ADB
+/*
+ * Latency histogram for --latency-percentiles.  Bucket 0 holds latencies
+ * below 1 us, bucket i > 0 holds [2^((i-1)/4), 2^(i/4)) us, so a percentile
+ * is off by at most 19%, whatever the latency.
+ */
+#define LATENCY_HIST_BUCKETS	128
+
+typedef struct LatencyHist
+{
+	int64		count;			/* how many values were encountered */
+	int64		buckets[LATENCY_HIST_BUCKETS];
+} LatencyHist;
+#endif
+
 /*
  * Data structure to hold various statistics: per-thread and per-script stats
  * are maintained and merged together.
@@ -300,6 +322,9 @@ typedef struct StatsData
 								 * and --latency-limit */
 	SimpleStats latency;
 	SimpleStats lag;
+#ifdef ADB
+	LatencyHist latency_hist;	/* filled only with --latency-percentiles */
+#endif
 } StatsData;
 
 /*
@@ -532,6 +557,9 @@ typedef struct Command
 	char	   *varprefix;
 	PgBenchExpr *expr;
 	SimpleStats stats;
+#ifdef ADB
+	LatencyHist hist;			/* filled only with --latency-percentiles */
+#endif
 } Command;
 
 typedef struct ParsedScript
@@ -625,6 +653,48 @@ static const BuiltinScript builtin_script[] =
 		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid;\n"
 		"INSERT INTO pgbench_history (tid, bid, aid, delta, mtime) VALUES (:tid, :bid, :aid, :delta, CURRENT_TIMESTAMP);\n"
 		"END;\n"
+	},
+	/*
+	 * Cluster workloads, the ones using pgbench_orders and
+	 * pgbench_seq_history need init step "c".
+	 */
+	{
+		"adb-single-shard",
+		"<builtin: single datanode lookup>",
+		"\\set aid random(1, " CppAsString2(naccounts) " * :scale)\n"
+		"\\set bid (:aid - 1) / " CppAsString2(naccounts) " + 1\n"
+		"SELECT abalance FROM pgbench_accounts WHERE aid = :aid AND bid = :bid;\n"
+	},
+	{
+		"adb-multi-shard-2pc",
+		"<builtin: two datanodes update with 2PC>",
+		"\\set aid1 random(1, " CppAsString2(naccounts) " * :scale)\n"
+		"\\set aid2 random(1, " CppAsString2(naccounts) " * :scale)\n"
+		"\\set delta random(-5000, 5000)\n"
+		"BEGIN;\n"
+		"UPDATE pgbench_accounts SET abalance = abalance - :delta WHERE aid = :aid1;\n"
+		"UPDATE pgbench_accounts SET abalance = abalance + :delta WHERE aid = :aid2;\n"
+		"END;\n"
+	},
+	{
+		"adb-reduce-join",
+		"<builtin: cross datanode join with cluster reduce>",
+		"\\set orid random(1, " CppAsString2(naccounts) " * :scale - 99)\n"
+		"SELECT count(*), sum(a.abalance) FROM pgbench_orders o JOIN pgbench_accounts a ON a.aid = o.aid "
+		"WHERE o.orid BETWEEN :orid AND :orid + 99;\n"
+	},
+	{
+		"adb-aux-lookup",
+		"<builtin: lookup through auxiliary table>",
+		"\\set aid random(1, " CppAsString2(naccounts) " * :scale)\n"
+		"SELECT orid, amount FROM pgbench_orders WHERE aid = :aid;\n"
+	},
+	{
+		"adb-sequence-insert",
+		"<builtin: insert with sequence>",
+		"\\set aid random(1, " CppAsString2(naccounts) " * :scale)\n"
+		"\\set delta random(-5000, 5000)\n"
+		"INSERT INTO pgbench_seq_history (aid, delta, mtime) VALUES (:aid, :delta, CURRENT_TIMESTAMP);\n"
 	}
 #endif
 };
@@ -716,6 +786,10 @@ usage(void)
 		   "  -T, --time=NUM           duration of benchmark test in seconds\n"
 		   "  -v, --vacuum-all         vacuum all four standard tables before tests\n"
 		   "  --aggregate-interval=NUM aggregate data over NUM seconds\n"
+#ifdef ADB
+		   "  --latency-percentiles    report latency percentiles per script and,\n"
+		   "                           with -r, per command\n"
+#endif
 		   "  --log-prefix=PREFIX      prefix for transaction time log file\n"
 		   "                           (default: \"pgbench_log\")\n"
 		   "  --progress-timestamp     use Unix epoch timestamps for progress\n"
@@ -1146,6 +1220,47 @@ mergeSimpleStats(SimpleStats *acc, SimpleStats *ss)
 	acc->sum2 += ss->sum2;
 }
 
+#ifdef ADB
+/*
+ * Accumulate one latency, in microseconds, into a LatencyHist struct.
+ */
+static void
+addToLatencyHist(LatencyHist *hist, double usec)
+{
+	int			i = 0;
+
+	if (usec >= 1.0)
+		i = Min((int) (4.0 * log2(usec)) + 1, LATENCY_HIST_BUCKETS - 1);
+	hist->buckets[i]++;
+	hist->count++;
+}
+
+/*
+ * Get the given fraction percentile of a LatencyHist, in microseconds.  The
+ * geometric middle of the bucket holding it stands for the value.
+ */
+static double
+getLatencyHistPercentile(LatencyHist *hist, double fraction)
+{
+	int64		target = (int64) ceil(fraction * hist->count);
+	int64		seen = 0;
+	int			i;
+
+	for (i = 0; i < LATENCY_HIST_BUCKETS; i++)
+	{
+		seen += hist->buckets[i];
+		if (seen >= target && seen > 0)
+			break;
+	}
+
+	if (i == 0)
+		return 0.5;
+	if (i == LATENCY_HIST_BUCKETS)
+		i--;
+	return pow(2.0, (i - 0.5) / 4.0);
+}
+#endif
+
 /*
  * Initialize a StatsData struct to mostly zeroes, with its start time set to
  * the given value.
@@ -1158,6 +1273,9 @@ initStats(StatsData *sd, time_t start_time)
 	sd->skipped = 0;
 	initSimpleStats(&sd->latency);
 	initSimpleStats(&sd->lag);
+#ifdef ADB
+	memset(&sd->latency_hist, 0, sizeof(sd->latency_hist));
+#endif
 }
 
 /*
@@ -1176,6 +1294,10 @@ accumStats(StatsData *stats, bool skipped, double lat, double lag)
 	else
 	{
 		addToSimpleStats(&stats->latency, lat);
+#ifdef ADB
+		if (report_percentiles)
+			addToLatencyHist(&stats->latency_hist, lat);
+#endif
 
 		/* and possibly the same for schedule lag */
 		if (throttle_delay)
@@ -3291,6 +3413,12 @@ advanceConnectionState(TState *thread, CState *st, StatsData *agg)
 					addToSimpleStats(&command->stats,
 									 INSTR_TIME_GET_DOUBLE(now) -
 									 INSTR_TIME_GET_DOUBLE(st->stmt_begin));
+#ifdef ADB
+					if (report_percentiles)
+						addToLatencyHist(&command->hist,
+										 INSTR_TIME_GET_MICROSEC(now) -
+										 INSTR_TIME_GET_MICROSEC(st->stmt_begin));
+#endif
 				}
 
 				/* Go ahead with next command, to be executed or skipped */
@@ -3666,6 +3794,12 @@ initDropTables(PGconn *con)
 					 "pgbench_branches, "
 					 "pgbench_history, "
 					 "pgbench_tellers");
+#ifdef ADB
+	/* tables of init step "c" */
+	executeStatement(con, "drop table if exists "
+					 "pgbench_orders, "
+					 "pgbench_seq_history");
+#endif
 }
 
 /*
@@ -4068,6 +4202,52 @@ initGenerateDataServerSide(PGconn *con)
 	executeStatement(con, "commit");
 }
 
+#ifdef ADB
+/*
+ * Create and fill the tables of the cluster workloads:
+ *
+ * pgbench_orders is distributed by orid and refers to pgbench_accounts by
+ * aid, so joining them needs a cluster reduce, and it has an auxiliary table
+ * on aid for lookups by the non-distribution column.
+ *
+ * pgbench_seq_history takes its key from a sequence, so each insert asks
+ * the GTM for a value.
+ */
+static void
+initCreateClusterTables(PGconn *con)
+{
+	char		sql[256];
+	const char *inttype = (scale >= SCALE_32BIT_THRESHOLD) ? "bigint" : "int";
+	int64		norders = (int64) naccounts * scale;
+
+	fprintf(stderr, "creating cluster workload tables...\n");
+
+	snprintf(sql, sizeof(sql),
+			 "create%s table pgbench_orders(orid %s not null,aid %s not null,amount int,mtime timestamp) "
+			 "distribute by hash (orid)",
+			 unlogged_tables ? " unlogged" : "", inttype, inttype);
+	executeStatement(con, sql);
+
+	snprintf(sql, sizeof(sql),
+			 "create%s table pgbench_seq_history(hid bigserial,aid %s,delta int,mtime timestamp) "
+			 "distribute by hash (hid)",
+			 unlogged_tables ? " unlogged" : "", inttype);
+	executeStatement(con, sql);
+
+	/* spread aid over accounts, so that orid and aid hash differently */
+	snprintf(sql, sizeof(sql),
+			 "insert into pgbench_orders(orid,aid,amount,mtime) "
+			 "select orid, orid::bigint * 7919 %% " INT64_FORMAT " + 1, 0, now() "
+			 "from generate_series(1, " INT64_FORMAT ") as orid",
+			 norders, norders);
+	executeStatement(con, sql);
+
+	executeStatement(con, "alter table pgbench_orders add primary key (orid)");
+	executeStatement(con, "create auxiliary table pgbench_orders_aid on pgbench_orders(aid)");
+	executeStatement(con, "vacuum analyze pgbench_orders");
+}
+#endif /* ADB */
+
 /*
  * Invoke vacuum on the standard tables
  */
@@ -4260,6 +4440,12 @@ runInitSteps(const char *initialize_steps)
 				op = "foreign keys";
 				initCreateFKeys(con);
 				break;
+#ifdef ADB
+			case 'c':
+				op = "cluster workload tables";
+				initCreateClusterTables(con);
+				break;
+#endif
 			case ' ':
 				break;			/* ignore */
 			default:
@@ -4564,6 +4750,9 @@ create_sql_command(PQExpBuffer buf, const char *source)
 	my_command->varprefix = NULL;	/* allocated later, if needed */
 	my_command->expr = NULL;
 	initSimpleStats(&my_command->stats);
+#ifdef ADB
+	memset(&my_command->hist, 0, sizeof(my_command->hist));
+#endif
 
 	return my_command;
 }
@@ -4654,6 +4843,9 @@ process_backslash_command(PsqlScanState sstate, const char *source)
 	my_command->type = META_COMMAND;
 	my_command->argc = 0;
 	initSimpleStats(&my_command->stats);
+#ifdef ADB
+	memset(&my_command->hist, 0, sizeof(my_command->hist));
+#endif
 
 	/* Save first word (command name) */
 	j = 0;
@@ -5296,6 +5488,20 @@ printSimpleStats(const char *prefix, SimpleStats *ss)
 	}
 }
 
+#ifdef ADB
+static void
+printLatencyHist(const char *prefix, LatencyHist *hist)
+{
+	if (hist->count > 0)
+		printf("%s percentiles: p50 = %.3f ms, p90 = %.3f ms, p99 = %.3f ms, p99.9 = %.3f ms\n",
+			   prefix,
+			   0.001 * getLatencyHistPercentile(hist, 0.50),
+			   0.001 * getLatencyHistPercentile(hist, 0.90),
+			   0.001 * getLatencyHistPercentile(hist, 0.99),
+			   0.001 * getLatencyHistPercentile(hist, 0.999));
+}
+#endif
+
 /* print out results */
 static void
 printResults(StatsData *total, instr_time total_time,
@@ -5402,6 +5608,10 @@ printResults(StatsData *total, instr_time total_time,
 						   100.0 * sstats->skipped / sstats->cnt);
 
 				printSimpleStats(" - latency", &sstats->latency);
+#ifdef ADB
+				if (report_percentiles)
+					printLatencyHist(" - latency", &sstats->latency_hist);
+#endif
 			}
 
 			/* Report per-command latencies */
@@ -5409,6 +5619,30 @@ printResults(StatsData *total, instr_time total_time,
 			{
 				Command   **commands;
 
+#ifdef ADB
+				if (report_percentiles)
+				{
+					printf(" - statement latencies in milliseconds (average, p50, p99):\n");
+
+					for (commands = sql_script[i].commands;
+						 *commands != NULL;
+						 commands++)
+					{
+						SimpleStats *cstats = &(*commands)->stats;
+						LatencyHist *chist = &(*commands)->hist;
+
+						printf("   %11.3f  %11.3f  %11.3f  %s\n",
+							   (cstats->count > 0) ?
+							   1000.0 * cstats->sum / cstats->count : 0.0,
+							   (chist->count > 0) ?
+							   0.001 * getLatencyHistPercentile(chist, 0.50) : 0.0,
+							   (chist->count > 0) ?
+							   0.001 * getLatencyHistPercentile(chist, 0.99) : 0.0,
+							   (*commands)->first_line);
+					}
+					continue;
+				}
+#endif
 				if (per_script_stats)
 					printf(" - statement latencies in milliseconds:\n");
 				else
@@ -5529,6 +5763,9 @@ main(int argc, char **argv)
 		{"show-script", required_argument, NULL, 10},
 		{"partitions", required_argument, NULL, 11},
 		{"partition-method", required_argument, NULL, 12},
+#ifdef ADB
+		{"latency-percentiles", no_argument, NULL, 13},
+#endif
 		{NULL, 0, NULL, 0}
 	};
 
@@ -5920,6 +6157,12 @@ main(int argc, char **argv)
 					exit(1);
 				}
 				break;
+#ifdef ADB
+			case 13:			/* latency-percentiles */
+				benchmarking_option_set = true;
+				report_percentiles = true;
+				break;
+#endif
 			default:
 				fprintf(stderr, _("Try \"%s --help\" for more information.\n"), progname);
 				exit(1);
@@ -5962,6 +6205,11 @@ main(int argc, char **argv)
 	/* show per script stats if several scripts are used */
 	if (num_scripts > 1)
 		per_script_stats = true;
+#ifdef ADB
+	/* percentiles are kept per script */
+	if (report_percentiles)
+		per_script_stats = true;
+#endif
 
 	/*
 	 * Don't need more threads than there are clients.  (This is not merely an
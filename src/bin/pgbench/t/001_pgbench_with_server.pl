@@ -146,6 +146,36 @@ pgbench(
 	],
 	'pgbench --init-steps');
 
+# Tables of the cluster workloads
+pgbench(
+	'--initialize --init-steps=c',
+	0,
+	[qr{^$}],
+	[
+		qr{creating cluster workload tables},
+		qr{done in \d+\.\d\d s }
+	],
+	'pgbench init step c');
+
+# Cluster workloads, with latency percentiles per script and per command
+pgbench(
+	'--transactions=5 --client=2 --no-vacuum --latency-percentiles -r'
+	  . ' -b adb-single-shard -b adb-multi-shard-2pc -b adb-reduce-join'
+	  . ' -b adb-aux-lookup -b adb-sequence-insert',
+	0,
+	[
+		qr{processed: 10/10},
+		qr{builtin: single datanode lookup},
+		qr{builtin: two datanodes update with 2PC},
+		qr{builtin: cross datanode join with cluster reduce},
+		qr{builtin: lookup through auxiliary table},
+		qr{builtin: insert with sequence},
+		qr{ - latency percentiles: p50 = \d+\.\d+ ms, p90 = \d+\.\d+ ms, p99 = \d+\.\d+ ms, p99\.9 = \d+\.\d+ ms},
+		qr{statement latencies in milliseconds \(average, p50, p99\)}
+	],
+	[qr{^$}],
+	'pgbench cluster workloads with latency percentiles');
+
 # Run all builtin scripts, for a few transactions each
 pgbench(
 	'--transactions=5 -Dfoo=bla --client=2 --protocol=simple --builtin=t'
@@ -233,7 +233,8 @@ pgbench(
 	[qr{^$}],
 	[
 		qr{Available builtin scripts:}, qr{tpcb-like},
-		qr{simple-update},              qr{select-only}
+		qr{simple-update},              qr{select-only},
+		qr{adb-multi-shard-2pc},        qr{adb-reduce-join}
 	],
 	'pgbench builtin list');
 
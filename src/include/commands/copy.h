@@ -63,6 +63,9 @@ typedef struct AuxiliaryRelCopy
 
 #define AUX_REL_COPY_INFO	0x1
 #define AUX_REL_MAIN_NODES	0x2
+#define SHARED_FILE_COPY_INFO	0x3
+
+extern bool copy_from_shared_file;
 
 extern AuxiliaryRelCopy *MakeAuxRelCopyInfoFromMaster(Relation masterrel, Relation auxrel, int auxid);
 extern List* MakeAuxRelCopyInfo(Relation rel);
@@ -46,6 +46,7 @@ typedef struct ExplainState
 	bool		nodes;			/* print nodes in RemoteQuery node */
 	bool		num_nodes;		/* print number of nodes in RemoteQuery node */
 	bool		plan_id;		/* print plan node id */
+	bool		node_stats;		/* print per datanode stats when analyze */
 	bool		isTopLive;		/* is top live query */
 #endif /* ADB */
 	bool		wal;			/* print WAL usage */
@@ -81,6 +82,9 @@ extern PGDLLIMPORT ExplainOneQuery_hook_type ExplainOneQuery_hook;
 typedef const char *(*explain_get_index_name_hook_type) (Oid indexId);
 extern PGDLLIMPORT explain_get_index_name_hook_type explain_get_index_name_hook;
 
+#ifdef ADB
+extern PGDLLIMPORT double explain_skew_threshold;
+#endif /* ADB */
 
 extern void ExplainQuery(ParseState *pstate, ExplainStmt *stmt,
 						 ParamListInfo params, DestReceiver *dest
@@ -0,0 +1,6 @@
+#ifndef CLUSTER_FUNCTION_SCAN
+#define CLUSTER_FUNCTION_SCAN
+
+extern void DoClusterFunctionScan(StringInfo mem_toc);
+
+#endif /* CLUSTER_FUNCTION_SCAN */
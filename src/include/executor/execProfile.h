@@ -0,0 +1,41 @@
+#ifndef EXEC_PROFILE_H
+#define EXEC_PROFILE_H
+
+#include <signal.h>
+
+#define EXEC_PROFILE_MAX_DEPTH		64
+
+struct PlanState;
+
+extern PGDLLIMPORT bool track_query_profile;
+
+/* plan nodes being executed, maintained when track_query_profile is on */
+extern PGDLLIMPORT struct PlanState *ExecProfileStack[EXEC_PROFILE_MAX_DEPTH];
+extern PGDLLIMPORT int ExecProfileDepth;
+
+extern PGDLLIMPORT volatile sig_atomic_t QueryProfilePending;
+
+static inline void
+ExecProfilePush(struct PlanState *node)
+{
+	if (ExecProfileDepth < EXEC_PROFILE_MAX_DEPTH)
+		ExecProfileStack[ExecProfileDepth] = node;
+	++ExecProfileDepth;
+}
+
+static inline void
+ExecProfilePop(void)
+{
+	--ExecProfileDepth;
+}
+
+extern Size QueryProfileShmemSize(void);
+extern void QueryProfileShmemInit(void);
+
+extern void ExecProfileSetCoordinator(int coord_pid, Oid coord_oid);
+extern void AtAbort_ExecProfile(void);
+
+extern void HandleQueryProfileInterrupt(void);
+extern void ProcessQueryProfileInterrupt(void);
+
+#endif							/* EXEC_PROFILE_H */
@@ -39,6 +39,15 @@ typedef struct WalUsage
 	uint64		wal_bytes;		/* size of WAL records produced */
 } WalUsage;
 
+#ifdef ADB
+typedef struct ClusterUsage
+{
+	instr_time	remote_wait_time;	/* time waiting for remote nodes */
+	instr_time	reduce_wait_time;	/* time waiting for dynamic reduce */
+	instr_time	gtm_wait_time;		/* time waiting for GTM */
+} ClusterUsage;
+#endif /* ADB */
+
 /* Flag bits included in InstrAlloc's instrument_options bitmask */
 typedef enum InstrumentOption
 {
@@ -46,6 +55,9 @@ typedef enum InstrumentOption
 	INSTRUMENT_BUFFERS = 1 << 1,	/* needs buffer usage */
 	INSTRUMENT_ROWS = 1 << 2,	/* needs row count */
 	INSTRUMENT_WAL = 1 << 3,	/* needs WAL usage */
+#ifdef ADB
+	INSTRUMENT_CLUSTER = 1 << 4,	/* needs cluster usage */
+#endif /* ADB */
 	INSTRUMENT_ALL = PG_INT32_MAX
 } InstrumentOption;
 
@@ -55,6 +67,9 @@ typedef struct Instrumentation
 	bool		need_timer;		/* true if we need timer data */
 	bool		need_bufusage;	/* true if we need buffer usage data */
 	bool		need_walusage;	/* true if we need WAL usage data */
+#ifdef ADB
+	bool		need_clusterusage;	/* true if we need cluster usage data */
+#endif /* ADB */
 	/* Info about current plan cycle: */
 	bool		running;		/* true if we've completed first tuple */
 	instr_time	starttime;		/* start time of current iteration of node */
@@ -63,6 +78,9 @@ typedef struct Instrumentation
 	double		tuplecount;		/* # of tuples emitted so far this cycle */
 	BufferUsage bufusage_start; /* buffer usage at start */
 	WalUsage	walusage_start; /* WAL usage at start */
+#ifdef ADB
+	ClusterUsage clusterusage_start;	/* cluster usage at start */
+#endif /* ADB */
 	/* Accumulated statistics across all completed cycles: */
 	double		startup;		/* total startup time (in seconds) */
 	double		total;			/* total time (in seconds) */
@@ -73,6 +91,9 @@ typedef struct Instrumentation
 	double		nfiltered2;		/* # of tuples removed by "other" quals */
 	BufferUsage bufusage;		/* total buffer usage */
 	WalUsage	walusage;		/* total WAL usage */
+#ifdef ADB
+	ClusterUsage clusterusage;	/* total cluster usage */
+#endif /* ADB */
 } Instrumentation;
 
 typedef struct WorkerInstrumentation
@@ -92,6 +113,9 @@ typedef struct ClusterInstrumentation
 
 extern PGDLLIMPORT BufferUsage pgBufferUsage;
 extern PGDLLIMPORT WalUsage pgWalUsage;
+#ifdef ADB
+extern PGDLLIMPORT ClusterUsage pgClusterUsage;
+#endif /* ADB */
 
 extern Instrumentation *InstrAlloc(int n, int instrument_options);
 extern void InstrInit(Instrumentation *instr, int instrument_options);
@@ -106,5 +130,9 @@ extern void BufferUsageAccumDiff(BufferUsage *dst,
 								 const BufferUsage *add, const BufferUsage *sub);
 extern void WalUsageAccumDiff(WalUsage *dst, const WalUsage *add,
 							  const WalUsage *sub);
+#ifdef ADB
+extern void ClusterUsageAccumDiff(ClusterUsage *dst, const ClusterUsage *add,
+								  const ClusterUsage *sub);
+#endif /* ADB */
 
 #endif							/* INSTRUMENT_H */
@@ -98,9 +98,12 @@ typedef struct InterXactStateData
 	bool					missing_ok;
 	bool					implicit;
 	bool					need_xact_block;
+	bool					cur_read_only;		/* current query does not modify remote nodes */
 	Oid					   *trans_nodes;		/* array of remote nodes already start transaction */
+	bool				   *trans_writes;		/* array of flags, whether the remote node is modified */
 	int						trans_count;		/* remote nodes count */
 	int						trans_max;			/* current max malloc count of nodes */
+	int						write_count;		/* count of remote nodes modified */
 	struct NodeMixHandle   *cur_handle;			/* "cur_handle" is current NodeMixHandle depends
 												 * on oid list input, just for one query in the
 												 * transaction block */
@@ -120,12 +123,13 @@ extern void InterXactSetGID(InterXactState state, const char *gid);
 extern void InterXactSetXID(InterXactState state, TransactionId xid);
 extern void InterXactSaveBeginNodes(InterXactState state, Oid node);
 extern Oid *InterXactBeginNodes(InterXactState state, bool include_self, int *node_num);
+extern int InterXactWriteNodeCount(InterXactState state);
 extern void InterXactSerializeSnapshot(StringInfo buf, Snapshot snapshot);
 extern void InterXactGCCurrent(InterXactState state);
 extern void InterXactCacheCurrent(InterXactState state);
 extern void InterXactCacheAll(InterXactState state);
 extern void InterXactUtility(InterXactState state, Snapshot snapshot, const char *utility, StringInfo utility_tree);
-extern void InterXactBegin(InterXactState state, const List *node_list);
+extern void InterXactBegin(InterXactState state, const List *node_list, bool read_only);
 extern void InterXactPrepare(const char *gid, Oid *nodes, int nnodes);
 extern void InterXactCommit(const char *gid, Oid *nodes, int nnodes, bool missing_ok);
 extern void InterXactPrepareGtm(const char *gid, Oid *nodes, int nnodes);
@@ -45,6 +45,8 @@ extern List *PQNGetConnUseOidList(List *oid_list);
 extern struct pg_conn* PQNFindConnUseOid(Oid oid);
 extern List* PQNGetAllConns(void);
 extern bool PQNOneExecFinish(struct pg_conn *conn, const PQNHookFunctions *hook, bool blocking);
+extern bool PQNOneExecFinishEvent(struct pg_conn *conn, const PQNHookFunctions *hook,
+								  bool blocking, uint32 wait_event_info);
 extern bool PQNListExecFinish(List *conn_list, GetPGconnHook get_pgconn_hook, const PQNHookFunctions *hook, bool blocking);
 extern bool PQNEFHNormal(void *context, struct pg_conn *conn, PQNHookFuncType type, ...);
 extern bool PQNExecFinish_trouble(struct pg_conn *conn, int timeout_sec);
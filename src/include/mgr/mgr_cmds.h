@@ -449,6 +449,22 @@ extern void insert_into_monitor_alarm(Monitor_Alarm *monitor_alarm);
 extern void get_threshold(int16 type, Monitor_Threshold *monitor_threshold);
 
 /*monitor_databaseitem.c*/
+/*
+* one node's sql of the monitor, see monitor_get_stringvalues_nodes
+*/
+typedef struct MonitorNodeRequest
+{
+	char nodetype;
+	char *user;
+	char *address;
+	int agentport;
+	int nodeport;
+	char *dbname;
+	char *sqlstr;
+	ManagerAgent *ma;		/* connection to the agent while waiting the result */
+	StringInfo result;		/* the values delimiter by '\0' */
+} MonitorNodeRequest;
+
 extern int64 monitor_get_onesqlvalue_one_node(int agentport, char *sqlstr, char *user, char *address, int nodeport, char * dbname);
 extern int64 monitor_get_result_one_node(Relation rel_node, char *sqlstr, char *dbname, char nodetype);
 extern int64 monitor_get_sqlres_all_typenode_usedbname(Relation rel_node, char *sqlstr, char *dbname, char nodetype, int gettype);
@@ -459,6 +475,10 @@ extern HeapTuple monitor_build_database_item_tuple(Relation rel, const Timestamp
 extern Datum monitor_databasetps_insert_data(PG_FUNCTION_ARGS);
 extern HeapTuple monitor_build_databasetps_qps_tuple(Relation rel, const TimestampTz time, const char *dbname, const int64 tps, const int64 qps, int64 pgdbruntime);
 extern void monitor_get_stringvalues(char cmdtype, int agentport, char *sqlstr, char *user, char *address, int nodeport, char * dbname, StringInfo resultstrdata);
+extern void monitor_get_stringvalues_nodes(char cmdtype, List *reqlist);
+extern List *monitor_get_node_requests(Relation rel_node, char nodetype, char *sqlstr, char *dbname, List *reqlist);
+extern void monitor_free_node_requests(List *reqlist);
+extern int monitor_get_request_values(MonitorNodeRequest *req, char *values[], int len);
 extern void monitor_delete_data(MonitorDeleteData *node, ParamListInfo params, DestReceiver *dest);
 extern Datum monitor_delete_data_interval_days(PG_FUNCTION_ARGS);
 extern void mgr_set_init(MGRSetClusterInit *node, ParamListInfo params, DestReceiver *dest);
@@ -466,7 +486,7 @@ extern Datum mgr_set_init_cluster(PG_FUNCTION_ARGS);
 
 /*monitor_slowlog.c*/
 extern char *monitor_get_onestrvalue_one_node(int agentport, char *sqlstr, char *user, char *address, int port, char * dbname);
-extern void monitor_get_onedb_slowdata_insert(Relation rel, int agentport, char *user, char *address, int port, char *dbname);
+extern void monitor_get_node_slowdata_insert(Relation rel, MonitorNodeRequest *req, TimestampTz time);
 extern HeapTuple monitor_build_slowlog_tuple(Relation rel, TimestampTz time, char *dbname, char *username, float singletime, int totalnum, char *query, char *queryplan);
 extern Datum monitor_slowlog_insert_data(PG_FUNCTION_ARGS);
 extern HeapTuple check_record_yestoday_today(Relation rel, int *callstoday, int *callsyestd, bool *gettoday, bool *getyesdt, char *query, char *user, char *dbname, pg_time_t ptimenow);
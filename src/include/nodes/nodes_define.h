@@ -868,6 +868,7 @@ BEGIN_NODE(CreateAuxStmt)
 	NODE_NODE(Node,index_stmt)
 	NODE_NODE(RangeVar,master_relation)
 	NODE_STRING(aux_column)
+	NODE_NODE(List,aux_include)
 END_NODE(CreateAuxStmt)
 #endif /* NO_NODE_CreateAuxStmt */
 
@@ -915,6 +916,10 @@ BEGIN_NODE(ClusterReduce)
 	NODE_SCALAR_POINT(bool,nullsFirst,NODE_ARG_->numCols)
 	NODE_SCALAR(uint32,reduce_flags)
 	NODE_BITMAPSET(Bitmapset,ignore_params)
+	NODE_SCALAR(Cost,reduce_conn_cost)
+	NODE_SCALAR(Cost,reduce_transfer_cost)
+	NODE_SCALAR(double,reduce_bandwidth)
+	NODE_SCALAR(double,reduce_latency)
 END_NODE(ClusterReduce)
 #endif /* NO_NODE_ClusterReduce */
 
@@ -2070,6 +2075,10 @@ BEGIN_NODE(ClusterReducePath)
 	NODE_NODE(Path,subpath)
 	NODE_NODE(Expr,special_reduce)
 	NODE_SCALAR(Oid,special_node)
+	NODE_SCALAR(Cost,conn_cost)
+	NODE_SCALAR(Cost,transfer_cost)
+	NODE_SCALAR(double,bandwidth)
+	NODE_SCALAR(double,latency)
 END_NODE(ClusterReducePath)
 #endif /* NO_NODE_ClusterReducePath */
 
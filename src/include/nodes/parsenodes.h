@@ -3906,6 +3906,7 @@ typedef struct CreateAuxStmt
 	Node		   *index_stmt;		/* index on "aux_column" for auxiliary table */
 	RangeVar	   *master_relation;/* master relation which auxiliary relation created for */
 	char		   *aux_column;		/* column of master relation which auxiliary relation created for */
+	List		   *aux_include;	/* INCLUDE columns of master relation (list of IndexElem) */
 } CreateAuxStmt;
 
 typedef struct PaddingAuxDataStmt
@@ -1985,6 +1985,10 @@ typedef struct ClusterReducePath
 	List	   *rnodes;
 	Expr	   *special_reduce;
 	Oid			special_node;
+	Cost		conn_cost;		/* parts of the cost, for EXPLAIN */
+	Cost		transfer_cost;
+	double		bandwidth;		/* calibrated bytes per second, or 0 */
+	double		latency;		/* calibrated connect milliseconds, or 0 */
 } ClusterReducePath;
 
 typedef struct ReduceScanPath
@@ -1089,6 +1089,12 @@ typedef struct ClusterReduce
 
 	uint32		reduce_flags;	/* clsuter reduce plan flags, see CRF_XXX */
 	Bitmapset  *ignore_params;	/* some special param, eg. gather and epq */
+
+	/* parts of the reduce cost, see cost_cluster_reduce() */
+	Cost		reduce_conn_cost;
+	Cost		reduce_transfer_cost;
+	double		reduce_bandwidth;	/* calibrated bytes per second, or 0 */
+	double		reduce_latency;		/* calibrated connect milliseconds, or 0 */
 } ClusterReduce;
 
 typedef struct ReduceScan
@@ -442,6 +442,7 @@ BEGIN_STRUCT(ReduceInfo)
 	NODE_NODE(List,storage_nodes)
 	NODE_NODE(List,exclude_exec)
 	NODE_NODE(List,values)
+	NODE_NODE(List,buckets)
 	NODE_RELIDS(Relids,relids)
 	NODE_SCALAR(char,type)
 	NODE_SCALAR(uint32,nkey)
@@ -468,6 +469,7 @@ BEGIN_STRUCT(RelationLocInfo)
 	NODE_NODE(List,keys)
 	NODE_NODE(List,nodeids)
 	NODE_NODE(List,values)
+	NODE_NODE(List,buckets)
 	NODE_NODE(List,masternodeids)
 	NODE_NODE(List,slavenodeids)
 END_STRUCT(RelationLocInfo)
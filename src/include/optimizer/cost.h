@@ -34,6 +34,10 @@
 #define DEFAULT_REDUCE_SETUP_COST 1000.0
 #define DEFAULT_REDUCE_CONN_COST 1.0
 #define DEFAULT_REDUCE_PAGE_COST 3.0
+/* network the reduce_* costs are tuned for, see reduce_cost_calibration */
+#define REDUCE_REFERENCE_BANDWIDTH	(100.0 * 1024.0 * 1024.0)	/* bytes per second */
+#define REDUCE_REFERENCE_LATENCY	0.5		/* milliseconds to connect */
+#define REDUCE_CALIBRATION_MAX_FACTOR	16.0
 #endif /* ADB */
 
 #define DEFAULT_EFFECTIVE_CACHE_SIZE  524288	/* measured in pages */
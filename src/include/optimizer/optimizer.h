@@ -87,6 +87,7 @@ extern PGDLLIMPORT double pgxc_remote_tuple_cost;
 extern PGDLLIMPORT double reduce_setup_cost;
 extern PGDLLIMPORT double reduce_conn_cost;
 extern PGDLLIMPORT double reduce_page_cost;
+extern PGDLLIMPORT bool reduce_cost_calibration;
 #endif /* ADB */
 
 extern double clamp_row_est(double nrows);
@@ -58,6 +58,8 @@ typedef struct ReduceInfo
 	List		   *storage_nodes;			/* when not reduce by value, it's sorted */
 	List		   *exclude_exec;			/* not have any row nodes */
 	List		   *values;					/* each nodes value(s) for distribute by list and range*/
+	List		   *buckets;				/* node of each remainder for hash and modulo,
+											 * NIL when it is storage_nodes */
 	Relids			relids;					/* params include */
 	char			type;					/* REDUCE_TYPE_XXX */
 	uint32			nkey;
@@ -154,6 +156,7 @@ extern List *GetCheapestReducePathList(RelOptInfo *rel, List *pathlist, Path **c
 extern int ReducePathSave2List(PlannerInfo *root, Path *path, void *pplist);
 
 #define IsReduceInfoByValue(r) IsReduceTypeByValue((r)->type)
+#define ReduceInfoBucketNodes(r) ((r)->buckets != NIL ? (r)->buckets : (r)->storage_nodes)
 extern bool IsReduceInfoListByValue(List *list);
 #define IsReduceInfoReplicated(r)	((r)->type == REDUCE_TYPE_REPLICATED)
 #define IsReduceInfoFinalReplicated(r) (IsReduceInfoReplicated(r) &&			\
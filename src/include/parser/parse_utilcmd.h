@@ -38,6 +38,7 @@ extern IndexStmt *generateClonedIndexStmt(RangeVar *heapRel,
 #ifdef ADB
 extern int transformDistributeCluster(ParseState *pstate, Relation rel, PGXCSubCluster *cluster,
 									  char loc_type, List **values, Oid **nodeoids);
+extern List *transformDistributeBuckets(char loc_type, int count, List *values);
 #endif /* ADB */
 #ifdef ADB_GRAM_ORA
 extern List *ora_transformPartitionRangeBounds(ParseState *pstate, List *blist,
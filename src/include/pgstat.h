@@ -270,7 +270,7 @@ typedef struct PgStat_TableEntry
  * ----------
  */
 #define PGSTAT_NUM_TABENTRIES  \
-	((PGSTAT_MSG_PAYLOAD - sizeof(Oid) - 3 * sizeof(int) - 2 * sizeof(PgStat_Counter))	\
+	((PGSTAT_MSG_PAYLOAD - sizeof(Oid) - 3 * sizeof(int) - (2 ADB_ONLY_CODE(+3)) * sizeof(PgStat_Counter))	\
 	 / sizeof(PgStat_TableEntry))
 
 typedef struct PgStat_MsgTabstat
@@ -282,6 +282,11 @@ typedef struct PgStat_MsgTabstat
 	int			m_xact_rollback;
 	PgStat_Counter m_block_read_time;	/* times in microseconds */
 	PgStat_Counter m_block_write_time;
+#ifdef ADB
+	PgStat_Counter m_remote_wait_time;	/* times in microseconds */
+	PgStat_Counter m_reduce_wait_time;
+	PgStat_Counter m_gtm_wait_time;
+#endif /* ADB */
 	PgStat_TableEntry m_entry[PGSTAT_NUM_TABENTRIES];
 } PgStat_MsgTabstat;
 
@@ -620,7 +625,11 @@ typedef union PgStat_Msg
  * ------------------------------------------------------------
  */
 
+#ifdef ADB
+#define PGSTAT_FILE_FORMAT_ID	0x01A5BD9D
+#else
 #define PGSTAT_FILE_FORMAT_ID	0x01A5BC9D
+#endif /* ADB */
 
 /* ----------
  * PgStat_StatDBEntry			The collector's data per database
@@ -651,6 +660,11 @@ typedef struct PgStat_StatDBEntry
 	TimestampTz last_checksum_failure;
 	PgStat_Counter n_block_read_time;	/* times in microseconds */
 	PgStat_Counter n_block_write_time;
+#ifdef ADB
+	PgStat_Counter n_remote_wait_time;	/* times in microseconds */
+	PgStat_Counter n_reduce_wait_time;
+	PgStat_Counter n_gtm_wait_time;
+#endif /* ADB */
 
 	TimestampTz stat_reset_timestamp;
 	TimestampTz stats_timestamp;	/* time of db stats file update */
@@ -796,6 +810,9 @@ typedef enum BackendState
 #define PG_WAIT_IPC					0x08000000U
 #define PG_WAIT_TIMEOUT				0x09000000U
 #define PG_WAIT_IO					0x0A000000U
+#ifdef ADB
+#define PG_WAIT_CLUSTER				0x0B000000U
+#endif /* ADB */
 
 /* ----------
  * Wait Events - Activity
@@ -915,6 +932,30 @@ typedef enum
 	WAIT_EVENT_VACUUM_DELAY
 } WaitEventTimeout;
 
+#ifdef ADB
+/* ----------
+ * Wait Events - Cluster
+ *
+ * Use this category when a process is waiting for another node of the
+ * cluster: GTM, the pooler, a remote node or dynamic reduce.  Time spent
+ * in these waits is also accumulated per class in pgClusterUsage.
+ * ----------
+ */
+typedef enum
+{
+	WAIT_EVENT_GTM_FINISH_XID = PG_WAIT_CLUSTER,
+	WAIT_EVENT_GTM_GET_XID,
+	WAIT_EVENT_GTM_SYNC_SNAPSHOT,
+	WAIT_EVENT_GTM_XACT_END,
+	WAIT_EVENT_POOL_CONNECT,
+	WAIT_EVENT_REDUCE_INTERNAL,
+	WAIT_EVENT_REDUCE_RECEIVE,
+	WAIT_EVENT_REDUCE_SEND,
+	WAIT_EVENT_REMOTE_FETCH,
+	WAIT_EVENT_REMOTE_RESULT
+} WaitEventCluster;
+#endif /* ADB */
+
 /* ----------
  * Wait Events - IO
  *
@@ -1144,6 +1185,16 @@ typedef struct PgBackendStatus
 	ProgressCommandType st_progress_command;
 	Oid			st_progress_command_target;
 	int64		st_progress_param[PGSTAT_NUM_PROGRESS_PARAM];
+
+#ifdef ADB
+	/*
+	 * Cumulative time spent waiting for other nodes, in microseconds,
+	 * published from pgClusterUsage by pgstat_report_cluster_wait().
+	 */
+	PgStat_Counter st_remote_wait_time;
+	PgStat_Counter st_reduce_wait_time;
+	PgStat_Counter st_gtm_wait_time;
+#endif /* ADB */
 } PgBackendStatus;
 
 /*
@@ -1329,6 +1380,9 @@ extern void pgstat_report_appname(const char *appname);
 extern void pgstat_report_xact_timestamp(TimestampTz tstamp);
 extern const char *pgstat_get_wait_event(uint32 wait_event_info);
 extern const char *pgstat_get_wait_event_type(uint32 wait_event_info);
+#ifdef ADB
+extern void pgstat_report_cluster_wait(void);
+#endif /* ADB */
 extern const char *pgstat_get_backend_current_activity(int pid, bool checkUser);
 extern const char *pgstat_get_crashed_backend_activity(int pid, char *buffer,
 													   int buflen);
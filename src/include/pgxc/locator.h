@@ -44,6 +44,8 @@ typedef struct RelationLocInfo
 	List	   *keys;					/* Distribution key(s) attribute, list of LocatorKeyInfo */
 	List	   *nodeids;				/* Node Oid(s) where data is located */
 	List	   *values;					/* each nodes values for distribute by list and range */
+	List	   *buckets;				/* for hash and modulo, index in nodeids of each remainder,
+										 * NIL when remainder is the index */
 	List	   *masternodeids;
 	List	   *slavenodeids;
 } RelationLocInfo;
@@ -51,6 +53,12 @@ typedef struct RelationLocInfo
 #define IsRelationReplicated(rel_loc)				IsLocatorReplicated((rel_loc)->locatorType)
 #define IsRelationDistributedByValue(rel_loc)		IsLocatorDistributedByValue((rel_loc)->locatorType)
 #define FirstLocKeyInfo(rel_loc)					((LocatorKeyInfo*)linitial(rel_loc->keys))
+#define LocatorModulus(rel_loc)						((rel_loc)->buckets != NIL ?			\
+														list_length((rel_loc)->buckets) :	\
+														list_length((rel_loc)->nodeids))
+#define LocatorBucketNode(rel_loc, n)				list_nth_oid((rel_loc)->nodeids,		\
+														(rel_loc)->buckets != NIL ?			\
+														list_nth_int((rel_loc)->buckets, n) : (n))
 
 /*
  * Nodes to execute on
@@ -118,6 +126,7 @@ extern ExecNodes *GetRelationNodesByQuals(Oid reloid,
 										  RelationAccessType relaccess);
 extern ExecNodes *MakeExecNodesByOids(RelationLocInfo *loc_info, List *oids, RelationAccessType accesstype);
 extern AttrNumber GetFirstLocAttNumIfOnlyOne(RelationLocInfo *loc);
+extern List *GetLocatorBucketNodes(const RelationLocInfo *loc);
 
 /* Global locator data */
 extern void FreeExecNodes(ExecNodes **exec_nodes);
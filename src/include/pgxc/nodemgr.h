@@ -22,6 +22,10 @@
 extern int 	MaxDataNodes;
 extern int 	MaxCoords;
 
+/* GUC parameters, in expansion.c */
+extern double expansion_clean_cost_delay;
+extern int	expansion_clean_cost_limit;
+
 extern uint32 adb_get_all_coord_oid_array(Oid **pparr, bool order_name);
 extern List* adb_get_all_coord_oid_list(bool order_name);
 extern uint32 adb_get_all_datanode_oid_array(Oid **pparr, bool order_name);
@@ -144,5 +144,6 @@ extern bool IsPoolHandle(void);
 extern int PoolManagerSendLocalCommand(int dn_count, int* dn_list, int co_count, int* co_list);
 
 extern Datum pool_close_idle_conn(PG_FUNCTION_ARGS);
+extern Datum pool_get_node_stats(PG_FUNCTION_ARGS);
 
 #endif
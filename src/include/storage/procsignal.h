@@ -42,6 +42,10 @@ typedef enum
 	PROCSIG_RECOVERY_CONFLICT_BUFFERPIN,
 	PROCSIG_RECOVERY_CONFLICT_STARTUP_DEADLOCK,
 
+#ifdef ADB
+	PROCSIG_QUERY_PROFILE,		/* take a plan node sample, see execProfile.c */
+#endif /* ADB */
+
 	NUM_PROCSIGNALS				/* Must be last! */
 } ProcSignalReason;
 
@@ -22,6 +22,7 @@
 #include "lib/oidbuffer.h"
 #include "lib/stringinfo.h"
 #include "port/atomics.h"
+#include "portability/instr_time.h"
 #include "storage/latch.h"
 #include "storage/shm_mq.h"
 #include "utils/hsearch.h"
@@ -218,6 +219,12 @@ typedef struct DRNodeEventData
 	struct addrinfo *addrlist;
 	struct addrinfo *addr_cur;
 	HTAB		   *cached_data;
+
+	/* for network measurements, see dr_netstat.c */
+	instr_time		connect_start;
+	instr_time		send_start;	/* send buffer became not empty */
+	uint64			send_bytes;	/* sent since send_start */
+	bool			send_full;	/* socket could not take all of send buffer */
 }DRNodeEventData;
 
 typedef struct PlanWorkerInfo
@@ -188,4 +188,11 @@ extern dsm_segment* DynamicReduceGetSharedMemory(void);
 extern SharedFileSet* DynamicReduceGetSharedFileSet(void);
 #define DynamicReduceSharedFileName(name,fileno) DynamicReduceSFSFileName(name, fileno)
 
+/* in dr_netstat.c */
+extern Size DRNetStatShmemSize(void);
+extern void DRNetStatShmemInit(void);
+extern void DRNetStatReportSend(Oid nodeoid, uint64 bytes, double elapsed);
+extern void DRNetStatReportConnect(Oid nodeoid, double elapsed);
+extern bool DRNetStatEstimate(List *nodes, double *bandwidth, double *latency);
+
 #endif /* DYNAMIC_REDUCE_H_ */
@@ -241,6 +241,7 @@ typedef struct RelationData
 	RelationLocInfo *rd_locator_info;
 	List		   *rd_auxlist;		/* list of OIDs of auxiliaries on relation */
 	Bitmapset	   *rd_auxatt;		/* auxiliaries columns used in indexes */
+	Bitmapset	   *rd_auxinclude;	/* columns included by auxiliaries */
 	struct ExpansionClean
 				   *rd_clean;		/* clean info */
 #endif
@@ -673,11 +674,15 @@ extern void RelationDecrementReferenceCount(Relation rel);
 /* routines in pgxc/nodemgr/expansion.c */
 struct TupleTableSlot;
 extern void RelationBuildExpansionClean(Relation rel);
+extern struct ExpansionClean *CreateExpansionClean(Relation rel, BlockNumber max_block,
+												   const char *expr_str);
 extern void DestroyExpansionClean(struct ExpansionClean *clean);
 extern bool IsExpansionCleanEqual(struct ExpansionClean *a, struct ExpansionClean *b);
 extern bool ExecTestExpansionClean(struct ExpansionClean *clean, void *tup);
 extern bool ExecTestSlotExpansionClean(struct ExpansionClean *clean, struct TupleTableSlot *slot);
 extern bool NeedTestExpansionClean(struct ExpansionClean *clean, const ItemPointer tid);
+extern bool NeedTestExpansionCleanBlock(struct ExpansionClean *clean, BlockNumber blk);
+extern void MarkExpansionCleanBlock(struct ExpansionClean *clean, BlockNumber blk);
 extern BlockNumber GetExpansionInsertLimitBlock(struct ExpansionClean *clean);
 extern bool CanInsertIntoExpansionRel(struct ExpansionClean *clean, BlockNumber blk);
 #endif /* ADB */
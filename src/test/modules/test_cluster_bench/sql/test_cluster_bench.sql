@@ -0,0 +1,21 @@
+CREATE EXTENSION test_cluster_bench;
+
+--
+-- Timings vary from run to run, so only check the shape of the results.
+--
+SELECT benchmark, iterations, total_ms >= 0 AS ok
+  FROM bench_reduce_tuples(1000);
+SELECT benchmark, iterations, total_ms >= 0 AS ok
+  FROM bench_reduce_tuples(1000, 3, 'modulo');
+SELECT benchmark, iterations, total_ms >= 0 AS ok
+  FROM bench_reduce_tuples(1000, 2, 'replicate');
+SELECT benchmark, iterations, total_ms >= 0 AS ok
+  FROM bench_reduce_tuples(1000, 5, 'random');
+SELECT benchmark, iterations, total_ms >= 0 AS ok
+  FROM bench_snapshot(1000);
+
+-- invalid arguments
+SELECT * FROM bench_reduce_tuples(0);
+SELECT * FROM bench_reduce_tuples(10, 0);
+SELECT * FROM bench_reduce_tuples(10, 2, 'range');
+SELECT * FROM bench_snapshot(-1);
@@ -0,0 +1,33 @@
+/* src/test/modules/test_cluster_bench/test_cluster_bench--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_cluster_bench" to load this file. \quit
+
+CREATE FUNCTION bench_reduce_tuples(ntuples pg_catalog.int8,
+	nnodes pg_catalog.int4 DEFAULT 4,
+	reduce_type pg_catalog.text DEFAULT 'hash',
+	OUT benchmark pg_catalog.text,
+	OUT iterations pg_catalog.int8,
+	OUT total_ms pg_catalog.float8,
+	OUT avg_us pg_catalog.float8,
+	OUT ops_per_sec pg_catalog.float8)
+RETURNS pg_catalog.record STRICT VOLATILE
+AS 'MODULE_PATHNAME' LANGUAGE C;
+
+CREATE FUNCTION bench_snapshot(niters pg_catalog.int8,
+	OUT benchmark pg_catalog.text,
+	OUT iterations pg_catalog.int8,
+	OUT total_ms pg_catalog.float8,
+	OUT avg_us pg_catalog.float8,
+	OUT ops_per_sec pg_catalog.float8)
+RETURNS pg_catalog.record STRICT VOLATILE
+AS 'MODULE_PATHNAME' LANGUAGE C;
+
+CREATE FUNCTION bench_pool_connect(niters pg_catalog.int4,
+	OUT benchmark pg_catalog.text,
+	OUT iterations pg_catalog.int8,
+	OUT total_ms pg_catalog.float8,
+	OUT avg_us pg_catalog.float8,
+	OUT ops_per_sec pg_catalog.float8)
+RETURNS pg_catalog.record STRICT VOLATILE
+AS 'MODULE_PATHNAME' LANGUAGE C;
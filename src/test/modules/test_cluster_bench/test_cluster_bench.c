@@ -0,0 +1,270 @@
+/*--------------------------------------------------------------------------
+ *
+ * test_cluster_bench.c
+ *		Micro-benchmarks for the per-tuple and per-statement cluster paths:
+ *		reduce routing, snapshot acquisition and pooled connections.
+ *
+ * Each function runs one path in a tight loop and returns a single row
+ * with the iteration count and elapsed time, so results from different
+ * builds can be compared with plain SQL.  For concurrency measurements
+ * run the same function from several sessions at once (pgbench -f).
+ *
+ * IDENTIFICATION
+ *		src/test/modules/test_cluster_bench/test_cluster_bench.c
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/htup_details.h"
+#include "access/transam.h"
+#include "access/xact.h"
+#include "catalog/pg_type.h"
+#include "executor/executor.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "lib/oidbuffer.h"
+#include "libpq/libpq-node.h"
+#include "miscadmin.h"
+#include "nodes/makefuncs.h"
+#include "optimizer/reduceinfo.h"
+#include "pgxc/nodemgr.h"
+#include "pgxc/pgxc.h"
+#include "portability/instr_time.h"
+#include "storage/procarray.h"
+#include "utils/builtins.h"
+#include "utils/dynamicreduce.h"
+#include "utils/memutils.h"
+
+PG_MODULE_MAGIC;
+
+PG_FUNCTION_INFO_V1(bench_reduce_tuples);
+PG_FUNCTION_INFO_V1(bench_snapshot);
+PG_FUNCTION_INFO_V1(bench_pool_connect);
+
+/* must be static, GetSnapshotData() keeps its xip arrays between calls */
+static SnapshotData BenchSnapshotData = {SNAPSHOT_MVCC};
+
+static Datum make_bench_result(FunctionCallInfo fcinfo, const char *name,
+							   int64 iterations, instr_time elapsed);
+
+/*
+ * Route ntuples synthetic (int4, int8) tuples through a reduce expression
+ * over nnodes storage nodes, serializing every tuple that would leave this
+ * node the same way DynamicReduceFetchLocal() does.  This is the sender's
+ * per-tuple cost; the network part needs a running reduce group and is
+ * not measured here.
+ */
+Datum
+bench_reduce_tuples(PG_FUNCTION_ARGS)
+{
+	int64		ntuples = PG_GETARG_INT64(0);
+	int32		nnodes = PG_GETARG_INT32(1);
+	char	   *type = text_to_cstring(PG_GETARG_TEXT_PP(2));
+	TupleDesc	desc;
+	TupleTableSlot *slot;
+	ExprContext *econtext;
+	ReduceExprState *expr_state;
+	ReduceInfo *rinfo;
+	Expr	   *key;
+	List	   *storage = NIL;
+	StringInfoData send_buf;
+	OidBufferData target;
+	instr_time	start_time;
+	instr_time	elapsed;
+	Datum		datum;
+	ExprDoneCond done;
+	bool		isnull;
+	int64		i;
+	int32		n;
+	char		name[NAMEDATALEN];
+
+	if (ntuples <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of tuples must be greater than zero")));
+	if (nnodes <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of nodes must be greater than zero")));
+
+	/*
+	 * The reduce expression only maps a key to an array index, so made-up
+	 * node OIDs work as well as real ones and let us test any node count.
+	 */
+	for (n = 0; n < nnodes; n++)
+		storage = lappend_oid(storage, FirstNormalObjectId + n);
+
+	key = (Expr *) makeVar(1, 1, INT4OID, -1, InvalidOid, 0);
+	if (pg_strcasecmp(type, "hash") == 0)
+		rinfo = MakeHashReduceInfo(storage, NIL, key);
+	else if (pg_strcasecmp(type, "modulo") == 0)
+		rinfo = MakeModuloReduceInfo(storage, NIL, key);
+	else if (pg_strcasecmp(type, "replicate") == 0)
+		rinfo = MakeReplicateReduceInfo(storage);
+	else if (pg_strcasecmp(type, "random") == 0)
+		rinfo = MakeRandomReduceInfo(storage);
+	else
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("unknown reduce type \"%s\"", type),
+				 errhint("Valid types are \"hash\", \"modulo\", \"replicate\" and \"random\".")));
+
+	desc = CreateTemplateTupleDesc(2);
+	TupleDescInitEntry(desc, 1, "key", INT4OID, -1, 0);
+	TupleDescInitEntry(desc, 2, "val", INT8OID, -1, 0);
+	slot = MakeSingleTupleTableSlot(desc, &TTSOpsVirtual);
+
+	econtext = CreateStandaloneExprContext();
+	expr_state = ExecInitReduceExpr(CreateExprUsingReduceInfo(rinfo));
+	initStringInfo(&send_buf);
+	initOidBuffer(&target);
+
+	INSTR_TIME_SET_CURRENT(start_time);
+	for (i = 0; i < ntuples; i++)
+	{
+		CHECK_FOR_INTERRUPTS();
+
+		ExecClearTuple(slot);
+		slot->tts_values[0] = Int32GetDatum((int32) (i & PG_INT32_MAX));
+		slot->tts_values[1] = Int64GetDatum(i);
+		slot->tts_isnull[0] = slot->tts_isnull[1] = false;
+		ExecStoreVirtualTuple(slot);
+
+		econtext->ecxt_scantuple = slot;
+		resetOidBuffer(&target);
+		for (;;)
+		{
+			datum = ExecEvalReduceExpr(expr_state, econtext, &isnull, &done);
+			if (done == ExprEndResult)
+				break;
+			if (isnull)
+				ereport(ERROR,
+						(errcode(ERRCODE_INTERNAL_ERROR),
+						 errmsg("ReduceExpr return a null value")));
+			appendOidBufferUniqueOid(&target, DatumGetObjectId(datum));
+			if (done == ExprSingleResult)
+				break;
+		}
+		if (target.len > 0)
+			SerializeDynamicReduceSlot(&send_buf, slot, &target);
+
+		ResetExprContext(econtext);
+	}
+	INSTR_TIME_SET_CURRENT(elapsed);
+	INSTR_TIME_SUBTRACT(elapsed, start_time);
+
+	FreeExprContext(econtext, true);
+	ExecDropSingleTupleTableSlot(slot);
+	freeOidBuffer(&target, false);
+	pfree(send_buf.data);
+
+	snprintf(name, sizeof(name), "reduce %s %d nodes", type, nnodes);
+	return make_bench_result(fcinfo, name, ntuples, elapsed);
+}
+
+/*
+ * Take niters snapshots through GetSnapshotData(), which goes to the
+ * snapshot receiver when this node runs under a GTM.
+ */
+Datum
+bench_snapshot(PG_FUNCTION_ARGS)
+{
+	int64		niters = PG_GETARG_INT64(0);
+	instr_time	start_time;
+	instr_time	elapsed;
+	int64		i;
+
+	if (niters <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of iterations must be greater than zero")));
+
+	INSTR_TIME_SET_CURRENT(start_time);
+	for (i = 0; i < niters; i++)
+	{
+		CHECK_FOR_INTERRUPTS();
+		GetSnapshotData(&BenchSnapshotData);
+	}
+	INSTR_TIME_SET_CURRENT(elapsed);
+	INSTR_TIME_SUBTRACT(elapsed, start_time);
+
+	return make_bench_result(fcinfo, "snapshot", niters, elapsed);
+}
+
+/*
+ * Acquire a pooled connection to every datanode and give them back to the
+ * pooler, niters times.  Each iteration is one round trip to the pooler
+ * for the sockets plus the connection setup done by PQNGetConnUseOidList().
+ */
+Datum
+bench_pool_connect(PG_FUNCTION_ARGS)
+{
+	int32		niters = PG_GETARG_INT32(0);
+	List	   *oids;
+	instr_time	start_time;
+	instr_time	elapsed;
+	int32		i;
+
+	if (niters <= 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("number of iterations must be greater than zero")));
+	if (!IsCnMaster())
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("bench_pool_connect() can only be run on a coordinator")));
+
+	/* releasing connections in the middle of a remote transaction is unsafe */
+	PreventInTransactionBlock(true, "bench_pool_connect()");
+
+	oids = adb_get_all_datanode_oid_list(false);
+	if (oids == NIL)
+		ereport(ERROR,
+				(errcode(ERRCODE_UNDEFINED_OBJECT),
+				 errmsg("no datanode defined")));
+
+	/* start from an empty connection cache */
+	PQNForceReleaseWhenTransactionFinish();
+	PQNReleaseAllConnect(-1);
+
+	INSTR_TIME_SET_CURRENT(start_time);
+	for (i = 0; i < niters; i++)
+	{
+		CHECK_FOR_INTERRUPTS();
+		list_free(PQNGetConnUseOidList(oids));
+		PQNForceReleaseWhenTransactionFinish();
+		PQNReleaseAllConnect(-1);
+	}
+	INSTR_TIME_SET_CURRENT(elapsed);
+	INSTR_TIME_SUBTRACT(elapsed, start_time);
+
+	list_free(oids);
+
+	return make_bench_result(fcinfo, "pool connect", niters, elapsed);
+}
+
+static Datum
+make_bench_result(FunctionCallInfo fcinfo, const char *name,
+				  int64 iterations, instr_time elapsed)
+{
+	TupleDesc	tupdesc;
+	Datum		values[5];
+	bool		nulls[5];
+	double		total_ms = INSTR_TIME_GET_MILLISEC(elapsed);
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+
+	memset(nulls, 0, sizeof(nulls));
+	values[0] = CStringGetTextDatum(name);
+	values[1] = Int64GetDatum(iterations);
+	values[2] = Float8GetDatum(total_ms);
+	values[3] = Float8GetDatum(total_ms * 1000.0 / iterations);
+	if (total_ms > 0)
+		values[4] = Float8GetDatum(iterations * 1000.0 / total_ms);
+	else
+		nulls[4] = true;
+
+	return HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc), values, nulls));
+}
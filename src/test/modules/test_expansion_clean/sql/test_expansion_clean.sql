@@ -0,0 +1,39 @@
+CREATE EXTENSION test_expansion_clean;
+
+-- one row per block, every datanode has all of them
+CREATE TABLE expansion_clean(id int, pad text) DISTRIBUTE BY REPLICATION;
+ALTER TABLE expansion_clean ALTER pad SET STORAGE PLAIN;
+INSERT INTO expansion_clean SELECT i, repeat('x', 5000) FROM generate_series(1, 20) i;
+
+-- the result of every datanode, they must all agree
+CREATE FUNCTION expansion_clean_scan(keep text, max_block int,
+	OUT visible int8, OUT clean_blocks int4, OUT visible_again int8)
+RETURNS SETOF record LANGUAGE sql AS $$
+  SELECT DISTINCT P.visible, P.clean_blocks, P.visible_again
+    FROM adb_cluster_function('test_expansion_clean(regclass,text,int4)',
+                              ARRAY['expansion_clean', $1, $2::text])
+         AS P(node_oid oid, node_name name, visible int8, clean_blocks int4,
+              visible_again int8)
+    JOIN pgxc_node N ON N.oid = P.node_oid
+   WHERE N.node_type = 'D'
+$$;
+
+-- rows 12, 14, ..., 20 moved away, pages are not all-visible yet
+SELECT * FROM expansion_clean_scan('id <= 10 OR id % 2 = 1', 19);
+
+-- all-visible pages whose rows all stay are marked clean
+VACUUM expansion_clean;
+SELECT * FROM expansion_clean_scan('id <= 10 OR id % 2 = 1', 19);
+
+-- blocks after max_block are never tested nor counted
+SELECT * FROM expansion_clean_scan('id <= 10 OR id % 2 = 1', 9);
+
+-- ctid based clean never marks a block
+SELECT * FROM expansion_clean_scan('id <= 10 OR id % 2 = 1 OR ctid IS NULL', 19);
+
+-- a page that is no longer all-visible is tested again
+UPDATE expansion_clean SET id = id WHERE id = 13;
+SELECT * FROM expansion_clean_scan('id <= 10 OR id % 2 = 1', 19);
+
+DROP FUNCTION expansion_clean_scan(text, int);
+DROP TABLE expansion_clean;
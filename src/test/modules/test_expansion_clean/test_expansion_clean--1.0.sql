@@ -0,0 +1,13 @@
+/* src/test/modules/test_expansion_clean/test_expansion_clean--1.0.sql */
+
+-- complain if script is sourced in psql, rather than via CREATE EXTENSION
+\echo Use "CREATE EXTENSION test_expansion_clean" to load this file. \quit
+
+CREATE FUNCTION test_expansion_clean(rel pg_catalog.regclass,
+	keep pg_catalog.text,
+	max_block pg_catalog.int4,
+	OUT visible pg_catalog.int8,
+	OUT clean_blocks pg_catalog.int4,
+	OUT visible_again pg_catalog.int8)
+RETURNS pg_catalog.record STRICT VOLATILE
+AS 'MODULE_PATHNAME' LANGUAGE C;
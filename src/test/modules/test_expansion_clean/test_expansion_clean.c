@@ -0,0 +1,169 @@
+/*--------------------------------------------------------------------------
+ *
+ * test_expansion_clean.c
+ *		Test how heap scans filter rows moved away by node expansion.
+ *
+ * The clean state is normally built from adb_clean after ALTER NODE DATA,
+ * which needs new datanodes.  Here it is installed on the relcache entry
+ * of a local relation for the duration of two heap scans, so the filter
+ * and the per-block clean bitmap can be checked on any datanode.
+ *
+ * IDENTIFICATION
+ *		src/test/modules/test_expansion_clean/test_expansion_clean.c
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+
+#include "access/heapam.h"
+#include "access/htup_details.h"
+#include "access/relscan.h"
+#include "access/table.h"
+#include "access/tableam.h"
+#include "catalog/pg_type.h"
+#include "fmgr.h"
+#include "funcapi.h"
+#include "nodes/nodeFuncs.h"
+#include "parser/analyze.h"
+#include "parser/parser.h"
+#include "storage/bufmgr.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+#include "utils/rel.h"
+#include "utils/snapmgr.h"
+
+PG_MODULE_MAGIC;
+
+PG_FUNCTION_INFO_V1(test_expansion_clean);
+
+static char *keep_expr_string(Relation rel, const char *keep);
+static int64 count_visible(Relation rel);
+
+/*
+ * test_expansion_clean(rel, keep, max_block)
+ *
+ * Scan rel twice as if node expansion had left the clean expression keep
+ * for blocks up to max_block, and return the visible tuples of both scans
+ * and the number of blocks the first scan marked clean.
+ */
+Datum
+test_expansion_clean(PG_FUNCTION_ARGS)
+{
+	Oid			relid = PG_GETARG_OID(0);
+	char	   *keep = text_to_cstring(PG_GETARG_TEXT_PP(1));
+	int32		max_block = PG_GETARG_INT32(2);
+	struct ExpansionClean *clean;
+	struct ExpansionClean *saved;
+	Relation	rel;
+	TupleDesc	tupdesc;
+	BlockNumber nblocks;
+	BlockNumber blk;
+	int64		visible;
+	int64		visible_again;
+	int32		clean_blocks = 0;
+	Datum		values[3];
+	bool		nulls[3];
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		elog(ERROR, "return type must be a row type");
+	if (max_block < 0)
+		ereport(ERROR,
+				(errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+				 errmsg("max_block must not be negative")));
+
+	rel = table_open(relid, AccessShareLock);
+	if (rel->rd_rel->relkind != RELKIND_RELATION)
+		ereport(ERROR,
+				(errcode(ERRCODE_WRONG_OBJECT_TYPE),
+				 errmsg("\"%s\" is not a table",
+						RelationGetRelationName(rel))));
+
+	clean = CreateExpansionClean(rel, (BlockNumber) max_block,
+								 keep_expr_string(rel, keep));
+	saved = rel->rd_clean;
+	rel->rd_clean = clean;
+	PG_TRY();
+	{
+		visible = count_visible(rel);
+
+		nblocks = RelationGetNumberOfBlocks(rel);
+		for (blk = 0; blk < nblocks && blk <= (BlockNumber) max_block; blk++)
+		{
+			if (!NeedTestExpansionCleanBlock(clean, blk))
+				clean_blocks++;
+		}
+
+		visible_again = count_visible(rel);
+	}
+	PG_FINALLY();
+	{
+		rel->rd_clean = saved;
+		DestroyExpansionClean(clean);
+	}
+	PG_END_TRY();
+
+	table_close(rel, AccessShareLock);
+
+	MemSet(nulls, 0, sizeof(nulls));
+	values[0] = Int64GetDatum(visible);
+	values[1] = Int32GetDatum(clean_blocks);
+	values[2] = Int64GetDatum(visible_again);
+
+	PG_RETURN_DATUM(HeapTupleGetDatum(heap_form_tuple(BlessTupleDesc(tupdesc),
+													  values, nulls)));
+}
+
+/*
+ * Analyze keep as a boolean expression over the columns of rel and return
+ * it the way adb_clean stores it.
+ */
+static char *
+keep_expr_string(Relation rel, const char *keep)
+{
+	StringInfoData sql;
+	List	   *raw;
+	Query	   *query;
+	Node	   *expr;
+
+	initStringInfo(&sql);
+	appendStringInfo(&sql, "SELECT COALESCE((%s)::pg_catalog.bool, true) FROM ONLY %s",
+					 keep,
+					 quote_qualified_identifier(get_namespace_name(RelationGetNamespace(rel)),
+												RelationGetRelationName(rel)));
+
+	raw = raw_parser(sql.data);
+	if (list_length(raw) != 1)
+		ereport(ERROR,
+				(errcode(ERRCODE_SYNTAX_ERROR),
+				 errmsg("invalid keep expression \"%s\"", keep)));
+	query = parse_analyze(linitial_node(RawStmt, raw), sql.data, NULL, 0, NULL);
+	if (query->commandType != CMD_SELECT ||
+		list_length(query->targetList) != 1 ||
+		query->hasAggs || query->hasSubLinks || query->hasWindowFuncs ||
+		query->hasTargetSRFs)
+		ereport(ERROR,
+				(errcode(ERRCODE_SYNTAX_ERROR),
+				 errmsg("invalid keep expression \"%s\"", keep)));
+
+	expr = (Node *) linitial_node(TargetEntry, query->targetList)->expr;
+	Assert(exprType(expr) == BOOLOID);
+
+	return nodeToString(expr);
+}
+
+/* visible tuples of a page-at-a-time heap scan */
+static int64
+count_visible(Relation rel)
+{
+	Snapshot	snapshot = RegisterSnapshot(GetTransactionSnapshot());
+	TableScanDesc scan;
+	int64		count = 0;
+
+	scan = table_beginscan(rel, snapshot, 0, NULL);
+	while (heap_getnext(scan, ForwardScanDirection) != NULL)
+		count++;
+	table_endscan(scan);
+	UnregisterSnapshot(snapshot);
+
+	return count;
+}
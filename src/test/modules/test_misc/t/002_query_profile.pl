@@ -0,0 +1,134 @@
+# Sample a running query with pg_query_profile() and pg_cluster_query_profile()
+
+use strict;
+use warnings;
+use PostgresNode;
+use TestLib;
+use Test::More tests => 11;
+
+# Never hang on a psql that stopped answering
+my $psql_timeout = IPC::Run::timer(180);
+
+my $node = get_new_node('master');
+$node->init();
+$node->start;
+
+# Session to be profiled, it sleeps inside the qual of a Function Scan
+# below an Aggregate, so both nodes stay on its plan node stack.
+my ($target_stdin, $target_stdout, $target_stderr) = ('', '', '');
+my $target = IPC::Run::start(
+	[
+		'psql', '-X', '-qAt', '-v', 'ON_ERROR_STOP=0', '-f', '-', '-d',
+		$node->connstr('postgres')
+	],
+	'<',
+	\$target_stdin,
+	'>',
+	\$target_stdout,
+	'2>',
+	\$target_stderr,
+	$psql_timeout);
+
+$target_stdin .= q[
+SET track_query_profile = on;
+SELECT pg_backend_pid();
+];
+ok(pump_until($target, \$target_stdout, qr/[[:digit:]]+[\r\n]$/m),
+	'acquired pid of profiled session');
+my $pid = $target_stdout;
+chomp($pid);
+$target_stdout = '';
+
+$target_stdin .= q[
+SELECT count(*) FROM generate_series(1, 1) g WHERE pg_sleep(600) IS NULL;
+];
+$target->pump_nb();
+$node->poll_query_until('postgres',
+	"SELECT wait_event = 'PgSleep' FROM pg_stat_activity WHERE pid = $pid")
+  or die "timed out waiting for the profiled query to start";
+
+# Return the rows of a profile as "kind|plan_node_id|name|self|total"
+sub profile_rows
+{
+	my $func = shift;
+
+	my $rows = $node->safe_psql('postgres',
+		qq[SELECT kind, coalesce(plan_node_id, -1), name,
+				  sum(self_samples), sum(total_samples)
+		   FROM $func($pid, 10, 100)
+		   GROUP BY 1, 2, 3 ORDER BY 1, 2, 3]);
+	return split /\n/, $rows;
+}
+
+my @rows = profile_rows('pg_query_profile');
+my @agg = grep { /^node\|0\|Aggregate\|/ } @rows;
+my @scan = grep { /^node\|1\|Function Scan\|/ } @rows;
+my $funcs = 0;
+$funcs += (split /\|/)[4] for grep { /^function\|/ } @rows;
+
+is(scalar(@agg), 1, 'pg_query_profile reports the Aggregate');
+like($agg[0] // '', qr/\|0\|[1-9][0-9]*$/,
+	'Aggregate has total samples but no self samples');
+like($scan[0] // '', qr/\|([1-9][0-9]*)\|\1$/,
+	'Function Scan has all its samples as self samples');
+is($funcs, 10, 'every sample is counted for one function');
+
+# The coordinator backend itself is sampled when it is local
+@rows = profile_rows('pg_cluster_query_profile');
+@agg = grep { /^node\|0\|Aggregate\|/ } @rows;
+@scan = grep { /^node\|1\|Function Scan\|/ } @rows;
+like($agg[0] // '', qr/\|0\|[1-9][0-9]*$/,
+	'pg_cluster_query_profile reports the Aggregate');
+like($scan[0] // '', qr/\|([1-9][0-9]*)\|\1$/,
+	'pg_cluster_query_profile reports the Function Scan');
+
+# A backend that never reaches CHECK_FOR_INTERRUPTS() does not answer
+is(kill('STOP', $pid), 1, 'stopped profiled session');
+@rows = profile_rows('pg_query_profile');
+is_deeply(\@rows, ['function|-1|<no response>|10|10'],
+	'samples of a stopped backend count as no response');
+kill('CONT', $pid);
+
+# The profile request left behind must not disturb the query
+$node->safe_psql('postgres', "SELECT pg_cancel_backend($pid)");
+ok(pump_until($target, \$target_stderr, qr/canceling statement due to user request/m),
+	'profiled query canceled');
+
+$target_stdin .= q[
+SELECT 'still-alive';
+];
+ok(pump_until($target, \$target_stdout, qr/still-alive/m),
+	'profiled session still works');
+
+$target_stdin .= "\\q\n";
+$target->finish;
+$node->stop;
+
+# Pump until string is matched, or timeout occurs
+sub pump_until
+{
+	my ($proc, $stream, $untl) = @_;
+	$proc->pump_nb();
+	while (1)
+	{
+		last if $$stream =~ /$untl/;
+		if ($psql_timeout->is_expired)
+		{
+			diag("aborting wait: program timed out");
+			diag("stream contents: >>", $$stream, "<<");
+			diag("pattern searched for: ", $untl);
+
+			return 0;
+		}
+		if (not $proc->pumpable())
+		{
+			diag("aborting wait: program died");
+			diag("stream contents: >>", $$stream, "<<");
+			diag("pattern searched for: ", $untl);
+
+			return 0;
+		}
+		$proc->pump();
+	}
+	return 1;
+}
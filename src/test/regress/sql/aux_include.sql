@@ -0,0 +1,83 @@
+--
+-- auxiliary table with INCLUDE columns
+--
+create table aux_inc_t(id int, code text, amount int, note text) distribute by hash(id);
+insert into aux_inc_t select i, 'c' || i, i * 10, 'n' || i from generate_series(1, 10) i;
+
+create auxiliary table aux_inc_code on aux_inc_t(code) include (amount, note);
+select attname from pg_attribute
+  where attrelid = 'aux_inc_code'::regclass and attnum > 0 order by attnum;
+
+-- padding copies the included columns
+select code, amount, note from aux_inc_code order by amount;
+
+-- DML on the master maintains the included columns
+insert into aux_inc_t values (11, 'c11', 110, 'n11');
+update aux_inc_t set amount = amount + 1, note = 'upd' where id = 3;
+update aux_inc_t set code = 'x5' where id = 5;
+delete from aux_inc_t where id = 7;
+select code, amount, note from aux_inc_code order by amount;
+select count(*) from aux_inc_t t join aux_inc_code a
+  on t.code = a.code and t.amount = a.amount and t.note = a.note
+  and t.xc_node_id = a.auxnodeid and t.ctid = a.auxctid;
+
+-- a second auxiliary table, DML maintains both
+create auxiliary table aux_inc_note on aux_inc_t(note) include (id);
+update aux_inc_t set note = 'upd2', amount = 0 where id = 1;
+select note, id from aux_inc_note where note like 'upd%' order by id;
+select code, amount, note from aux_inc_code where amount = 0;
+
+-- errors
+create auxiliary table on aux_inc_t(code) include (code);
+create auxiliary table on aux_inc_t(code) include (nosuch);
+
+-- a long IN list on the auxiliary column prunes the datanodes
+create function aux_inc_nodes(query text) returns text language plpgsql as $$
+declare
+  plan jsonb;
+begin
+  execute 'explain (verbose, costs off, format json) ' || query into plan;
+  return (select string_agg(distinct n.node_name::text, ',' order by n.node_name::text)
+          from jsonb_path_query(plan, '$.**."Remote node"[*]') r
+          join pgxc_node n on n.oid = (r #>> '{}')::oid);
+end
+$$;
+select id, code from aux_inc_t
+  where code in ('c2', 'c2', 'c2', 'c50', 'c51', 'c52', 'c53', 'c54', 'c55', 'c56');
+select aux_inc_nodes($$select id from aux_inc_t
+  where code in ('c2', 'c2', 'c2', 'c50', 'c51', 'c52', 'c53', 'c54', 'c55', 'c56')$$)
+  = (select string_agg(distinct node_name::text, ',' order by node_name::text)
+     from aux_inc_t, pgxc_node where code = 'c2' and xc_node_id = node_id) as pruned;
+select count(*) from aux_inc_t
+  where code in ('c1', 'c2', 'c3', 'c4', 'c6', 'c8', 'c9', 'c10', 'c11');
+select aux_inc_nodes($$select id from aux_inc_t
+  where code in ('c1', 'c2', 'c3', 'c4', 'c6', 'c8', 'c9', 'c10', 'c11')$$)
+  = (select string_agg(distinct node_name::text, ',' order by node_name::text)
+     from aux_inc_t, pgxc_node
+     where code in ('c1', 'c2', 'c3', 'c4', 'c6', 'c8', 'c9', 'c10', 'c11')
+       and xc_node_id = node_id) as pruned;
+drop function aux_inc_nodes(text);
+
+-- INCLUDE columns follow RENAME and ALTER TYPE of the master column
+alter table aux_inc_t rename column note to remark;
+alter table aux_inc_t alter column amount type bigint;
+select attname, format_type(atttypid, atttypmod) from pg_attribute
+  where attrelid = 'aux_inc_code'::regclass and attnum > 3 order by attnum;
+insert into aux_inc_t values (12, 'c12', 120, 'n12');
+update aux_inc_t set amount = 41, remark = 'upd3' where id = 4;
+select code, amount, remark from aux_inc_code where code in ('c4', 'c12') order by code;
+
+-- the auxiliary table depends on its INCLUDE columns
+alter table aux_inc_t drop column amount;
+set client_min_messages = warning;
+alter table aux_inc_t drop column amount cascade;
+reset client_min_messages;
+select relname from pg_class
+  where relname like 'aux\_inc\_%' and relkind = 'r' order by relname;
+insert into aux_inc_t values (13, 'c13', 'n13');
+update aux_inc_t set remark = 'upd4' where id = 12;
+select remark, id from aux_inc_note where id in (4, 12, 13) order by id;
+
+set client_min_messages = warning;
+drop table aux_inc_t cascade;
+reset client_min_messages;
@@ -0,0 +1,26 @@
+--
+-- adb_cluster_function
+--
+create function cluster_func_rows(out a int, out b text) returns setof record
+  as $$select 1, 'x' union all select 2, 'y'$$ language sql;
+
+-- every node returns the rows of the function
+select count(distinct node_oid) as nodes, count(*) as total, sum(a) as sum_a
+  from adb_cluster_function('cluster_func_rows()', null)
+  as t(node_oid oid, node_name name, a int, b text);
+
+-- the caller needs EXECUTE on the function it sends to the cluster
+revoke execute on function cluster_func_rows() from public;
+create role regress_cluster_func_user;
+set role regress_cluster_func_user;
+select count(*) from adb_cluster_function('cluster_func_rows()', null)
+  as t(node_oid oid, node_name name, a int, b text);
+reset role;
+grant execute on function cluster_func_rows() to regress_cluster_func_user;
+set role regress_cluster_func_user;
+select count(*) from adb_cluster_function('cluster_func_rows()', null)
+  as t(node_oid oid, node_name name, a int, b text);
+reset role;
+
+drop function cluster_func_rows();
+drop role regress_cluster_func_user;
@@ -0,0 +1,100 @@
+--
+-- Cost parts and network calibration of Cluster Reduce
+--
+set reduce_setup_cost = 0;
+create table reduce_cost_a(id int, v int) distribute by hash(id);
+create table reduce_cost_b(id int, v int) distribute by hash(id);
+insert into reduce_cost_a select i, i % 100 from generate_series(1, 10000) i;
+insert into reduce_cost_b select i, i from generate_series(1, 100) i;
+analyze reduce_cost_a;
+analyze reduce_cost_b;
+
+-- cost parts of the first Cluster Reduce in the plan of query
+create function reduce_cost_parts(query text, out connect float8, out transfer float8,
+                                  out calibrated bool)
+language plpgsql as $$
+declare
+  plan json;
+begin
+  execute 'explain (verbose, format json) ' || query into plan;
+  with recursive n(node) as (
+    select plan->0->'Plan'
+    union all
+    select json_array_elements(node->'Plans') from n where node->'Plans' is not null
+  )
+  select (node->>'Reduce Connect Cost')::float8,
+         (node->>'Reduce Transfer Cost')::float8,
+         node->'Reduce Bandwidth' is not null
+    into connect, transfer, calibrated
+    from n where node->>'Node Type' = 'Cluster Reduce' limit 1;
+end $$;
+
+-- the Reduce Cost and Reduce Network lines of the text plan, costs masked
+create function reduce_cost_lines(query text) returns setof text
+language plpgsql as $$
+declare
+  ln text;
+begin
+  for ln in execute 'explain (verbose) ' || query loop
+    if ln ~ 'Reduce (Cost|Network):' then
+      return next regexp_replace(trim(ln), '(connect|transfer)=[0-9.]+', '\1=N', 'g');
+    end if;
+  end loop;
+end $$;
+
+create temp table reduce_parts(k text, connect float8, transfer float8, calibrated bool);
+insert into reduce_parts select 'base', * from
+  reduce_cost_parts('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+select connect > 0 as has_connect, transfer > 0 as has_transfer, calibrated
+  from reduce_parts where k = 'base';
+
+-- reduce_page_cost only moves the transfer part
+set reduce_page_cost = 6;
+insert into reduce_parts select 'page', * from
+  reduce_cost_parts('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+reset reduce_page_cost;
+-- reduce_conn_cost only moves the connect part
+set reduce_conn_cost = 4;
+insert into reduce_parts select 'conn', * from
+  reduce_cost_parts('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+reset reduce_conn_cost;
+select p.transfer > b.transfer as page_transfer, p.connect = b.connect as page_connect,
+       c.connect = 4 * b.connect as conn_connect, c.transfer = b.transfer as conn_transfer
+  from reduce_parts b, reduce_parts p, reduce_parts c
+  where b.k = 'base' and p.k = 'page' and c.k = 'conn';
+
+-- calibration without measurements keeps the costs
+select adb_reduce_network_stats_reset();
+set reduce_cost_calibration = on;
+insert into reduce_parts select 'none', * from
+  reduce_cost_parts('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+select n.connect = b.connect as same_connect, n.transfer = b.transfer as same_transfer,
+       n.calibrated
+  from reduce_parts b, reduce_parts n where b.k = 'base' and n.k = 'none';
+
+-- a network 4 times slower and with 4 times the latency of the reference
+select bool_and(adb_reduce_network_stats_set(oid, 25, 2))
+  from pgxc_node where node_type = 'D';
+select bandwidth, latency from adb_reduce_network_stats()
+  where peer_oid in (select oid from pgxc_node where node_type = 'D');
+insert into reduce_parts select 'slow', * from
+  reduce_cost_parts('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+select s.transfer > b.transfer as slow_transfer, s.connect = 4 * b.connect as slow_connect,
+       s.calibrated
+  from reduce_parts b, reduce_parts s where b.k = 'base' and s.k = 'slow';
+select * from reduce_cost_lines('select count(*) from reduce_cost_a a join reduce_cost_b b on a.v = b.id');
+
+-- only superuser may change the measurements
+create role regress_reduce_cost_user;
+set role regress_reduce_cost_user;
+select adb_reduce_network_stats_reset();
+reset role;
+drop role regress_reduce_cost_user;
+
+select adb_reduce_calibrate() >= 0 as calibrated;
+select adb_reduce_network_stats_reset();
+reset reduce_cost_calibration;
+reset reduce_setup_cost;
+drop function reduce_cost_parts(text);
+drop function reduce_cost_lines(text);
+drop table reduce_cost_a, reduce_cost_b;
@@ -0,0 +1,23 @@
+--
+-- time spent waiting for other nodes
+--
+create table cluster_wait_t(id int, val int) distribute by hash(id);
+insert into cluster_wait_t select i, i from generate_series(1, 100) i;
+select count(*) from cluster_wait_t;
+
+-- the backend counters are published after each blocking wait
+select remote_wait_time > 0 as remote, reduce_wait_time >= 0 as reduce,
+       gtm_wait_time >= 0 as gtm
+  from adb_stat_activity_wait where pid = pg_backend_pid();
+
+-- one row per database, never NULL
+select count(*) = (select count(*) from pg_database) as all_databases,
+       bool_and(remote_wait_time >= 0 and reduce_wait_time >= 0 and
+                gtm_wait_time >= 0) as not_negative
+  from adb_stat_database_wait;
+
+-- not waiting while running this query
+select wait_event_type, wait_event
+  from adb_stat_activity_wait where pid = pg_backend_pid();
+
+drop table cluster_wait_t;
@@ -0,0 +1,85 @@
+--
+-- EXPLAIN (ANALYZE, NODES): per datanode statistics and skew
+--
+create table explain_nodes_t(id int, v int) distribute by modulo(id);
+insert into explain_nodes_t select i, i from generate_series(1, 100) i;
+
+-- datanode figures of the scan of explain_nodes_t
+create function explain_nodes_scan(out datanodes int, out min_rows float8, out max_rows float8,
+                                   out avg_rows float8, out rows_skew float8, out skewed bool)
+language plpgsql as $$
+declare
+  plan jsonb;
+  node jsonb;
+begin
+  execute 'explain (analyze, nodes, costs off, timing off, summary off, format json) '
+          'select count(*) from explain_nodes_t' into plan;
+  node := jsonb_path_query_first(plan, '$.**? (@."Relation Name" == "explain_nodes_t")');
+  datanodes := node->>'Datanodes';
+  min_rows := node->>'Datanode Min Rows';
+  max_rows := node->>'Datanode Max Rows';
+  avg_rows := node->>'Datanode Avg Rows';
+  rows_skew := node->>'Datanode Rows Skew';
+  skewed := node->>'Datanode Skewed';
+end $$;
+
+-- number of text lines of the plan flagged as skewed
+create function explain_nodes_skew_lines() returns bigint
+language plpgsql as $$
+declare
+  ln text;
+  cnt bigint := 0;
+begin
+  for ln in execute 'explain (analyze, nodes, costs off, timing off, summary off) '
+                    'select count(*) from explain_nodes_t' loop
+    if ln ~ 'Datanode Skew: exceeds' then
+      cnt := cnt + 1;
+    end if;
+  end loop;
+  return cnt;
+end $$;
+
+-- rows sent and received by each datanode of the Cluster Reduce of a join
+create function explain_nodes_reduce(out reduce_nodes int, out sent bigint, out received bigint)
+language plpgsql as $$
+declare
+  ln text;
+  m text[];
+begin
+  reduce_nodes := 0;
+  sent := 0;
+  received := 0;
+  for ln in execute 'explain (analyze, nodes, costs off, timing off) '
+                    'select count(*) from explain_nodes_t a join explain_nodes_t b on a.id = b.v' loop
+    m := regexp_match(ln, 'Reduce \S+: sent=([0-9]+) received=([0-9]+)');
+    if m is not null then
+      reduce_nodes := reduce_nodes + 1;
+      sent := sent + m[1]::bigint;
+      received := received + m[2]::bigint;
+    end if;
+  end loop;
+end $$;
+
+-- rows evenly spread
+select * from explain_nodes_scan();
+select explain_nodes_skew_lines();
+
+-- all rows of the inner side are reduced to the datanode of the outer row
+select * from explain_nodes_reduce();
+
+-- one datanode has three times the rows of the other, max/avg is 1.5,
+-- which does not exceed the default threshold
+insert into explain_nodes_t select i, i from generate_series(102, 300, 2) i;
+select * from explain_nodes_scan();
+select explain_nodes_skew_lines();
+
+-- a lower threshold flags it
+set explain_skew_threshold = 1.2;
+select * from explain_nodes_scan();
+select explain_nodes_skew_lines();
+reset explain_skew_threshold;
+
+drop function explain_nodes_scan();
+drop function explain_nodes_skew_lines();
+drop function explain_nodes_reduce();
+drop table explain_nodes_t;
@@ -0,0 +1,42 @@
+--
+-- hash_distribute_buckets, hash tables with virtual buckets
+--
+set hash_distribute_buckets = 8;
+
+-- node list stay unique, pcvalues keeps the bucket to node map
+create table hash_buckets_tbl(id int, v text) distribute by hash(id);
+select pclocatortype, array_length(nodeoids::oid[], 1) as nodes, pcvalues::text as buckets
+  from pgxc_class where pcrelid = 'hash_buckets_tbl'::regclass;
+
+insert into hash_buckets_tbl select i, i::text from generate_series(1, 100) i;
+select count(*), count(distinct xc_node_id) as nodes from hash_buckets_tbl;
+
+-- routing of the planner agree with insert
+select v from hash_buckets_tbl where id = 42;
+select count(*) from hash_buckets_tbl where id in (1, 5, 17, 42, 99);
+update hash_buckets_tbl set v = 'updated' where id = 17;
+select v from hash_buckets_tbl where id = 17;
+delete from hash_buckets_tbl where id = 99;
+select count(*) from hash_buckets_tbl where id = 99;
+
+-- join with a table of other bucket count
+reset hash_distribute_buckets;
+create table hash_buckets_nodes(id int) distribute by hash(id);
+select pcvalues is null as no_buckets
+  from pgxc_class where pcrelid = 'hash_buckets_nodes'::regclass;
+insert into hash_buckets_nodes select i from generate_series(1, 100, 2) i;
+select count(*) from hash_buckets_tbl a join hash_buckets_nodes b on a.id = b.id;
+select count(*) from hash_buckets_tbl a join hash_buckets_tbl b on a.id = b.id;
+select count(*) from hash_buckets_tbl a join hash_buckets_nodes b on a.id = b.id + 1;
+
+-- only create table use buckets, alter table keeps the node count
+set hash_distribute_buckets = 8;
+create table hash_buckets_alter(id int) distribute by replication;
+alter table hash_buckets_alter distribute by hash(id);
+select pclocatortype, pcvalues is null as no_buckets
+  from pgxc_class where pcrelid = 'hash_buckets_alter'::regclass;
+
+reset hash_distribute_buckets;
+drop table hash_buckets_tbl;
+drop table hash_buckets_nodes;
+drop table hash_buckets_alter;
@@ -0,0 +1,25 @@
+--
+-- per-node pooler statistics
+--
+create table pool_stats_t(id int, val int) distribute by hash(id);
+insert into pool_stats_t select i, i from generate_series(1, 100) i;
+select count(*) from pool_stats_t;
+
+-- the query above took slots from the pools of this database
+select count(*) > 0 as has_pools, bool_and(node_name is not null) as named
+  from adb_stat_pool where database = current_database();
+
+-- only monitoring roles see who connects where
+create role regress_pool_stats_user;
+set role regress_pool_stats_user;
+select count(*) from adb_stat_pool;
+select count(*) from pool_get_node_stats();
+reset role;
+grant pg_monitor to regress_pool_stats_user;
+set role regress_pool_stats_user;
+select count(*) > 0 as has_pools
+  from adb_stat_pool where database = current_database();
+reset role;
+
+drop role regress_pool_stats_user;
+drop table pool_stats_t;
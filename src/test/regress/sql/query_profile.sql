@@ -0,0 +1,30 @@
+--
+-- sampling running queries
+--
+show track_query_profile;
+
+-- a backend can not sample itself, nor a process that is not a backend
+select * from pg_query_profile(pg_backend_pid());
+select * from pg_query_profile(0);
+select * from pg_query_profile_coord(adb_node_oid(), 0, 0, 10);
+select * from pg_query_profile_coord(adb_node_oid(), 0, 1, 0);
+
+-- nobody works for coordinator backend 0
+select count(*) from pg_query_profile_coord(adb_node_oid(), 0, 1, 1);
+select count(*) from pg_cluster_query_profile(0, 1, 1);
+
+-- queries run the same with the plan node stack kept
+create table query_profile_t(id int, val int) distribute by hash(id);
+insert into query_profile_t select i, i from generate_series(1, 100) i;
+set track_query_profile = on;
+select count(*), sum(val) from query_profile_t;
+select count(*) from query_profile_t a join query_profile_t b using (id);
+reset track_query_profile;
+drop table query_profile_t;
+
+-- only superusers decide whether queries keep the stack
+create role regress_query_profile_user;
+set role regress_query_profile_user;
+set track_query_profile = on;
+reset role;
+drop role regress_query_profile_user;
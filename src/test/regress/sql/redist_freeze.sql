@@ -0,0 +1,22 @@
+--
+-- ALTER TABLE ... DISTRIBUTE BY loads the shadow relation frozen
+--
+create table redist_freeze(id int, val text) distribute by replication;
+insert into redist_freeze select i, 'v' || i from generate_series(1, 100) i;
+
+-- infomask 768 is HEAP_XMIN_FROZEN, freshly inserted tuples are not frozen
+select count(*) from redist_freeze where infomask & 768 = 768;
+
+alter table redist_freeze distribute by hash(id);
+select count(*) from redist_freeze;
+select count(*) from redist_freeze where infomask & 768 <> 768;
+
+-- no freezing while an earlier snapshot of the transaction is registered
+update redist_freeze set val = 'u' || id;
+begin isolation level repeatable read;
+select count(*) from redist_freeze;
+alter table redist_freeze distribute by hash(val);
+commit;
+select count(*) from redist_freeze where infomask & 768 = 768;
+
+drop table redist_freeze;